@@ -37,10 +37,12 @@ class L2CAPChannelCallbacks : public NimBLEL2CAPChannelCallbacks {
         numberOfSeconds = numberOfReceivedBytes = nextSequenceNumber = 0;
     }
 
-    void onRead(NimBLEL2CAPChannel* channel, std::vector<uint8_t>& data) {
-        numberOfReceivedBytes += data.size();
-        size_t sequenceNumber  = data[0];
-        Serial.printf("L2CAP read %d bytes w/ sequence number %d", data.size(), sequenceNumber);
+    // Reads straight from the received mbuf chain, only the sequence number is copied.
+    void onRead(NimBLEL2CAPChannel* channel, const NimBLEL2CAPSduView& sdu) {
+        uint8_t sequenceNumber = 0;
+        sdu.copy(0, &sequenceNumber, 1);
+        numberOfReceivedBytes += sdu.size();
+        Serial.printf("L2CAP read %d bytes w/ sequence number %d", sdu.size(), sequenceNumber);
         if (sequenceNumber != nextSequenceNumber) {
             Serial.printf("(wrong sequence number %d, expected %d)\n", sequenceNumber, nextSequenceNumber);
         } else {
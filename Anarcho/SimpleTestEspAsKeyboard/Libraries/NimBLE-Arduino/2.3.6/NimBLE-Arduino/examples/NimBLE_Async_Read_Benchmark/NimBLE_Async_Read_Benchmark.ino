@@ -0,0 +1,140 @@
+/*
+ * NimBLE_Async_Read_Benchmark
+ *
+ * Compares the aggregate read throughput of blocking readValue() calls, which keep one read in flight
+ * per task, with readValueAsync(), which keeps one read in flight per connection.
+ *
+ * Flash NimBLE_Notify_Benchmark on 1 to CONFIG_BT_NIMBLE_MAX_CONNECTIONS peripherals, they provide the
+ * readable characteristic. This device connects to every one it finds during the first scan,
+ * send 'b' on the serial port to run the benchmark.
+ * Keep CONFIG_NIMBLE_CPP_LOG_LEVEL at 0, read completions are logged at info level.
+ *
+ * Output per run: reads per second and bytes per second over all connections.
+ */
+
+#include <Arduino.h>
+#include <NimBLEDevice.h>
+
+#include <vector>
+
+#define SERVICE_UUID        "4fafc201-1fb5-459e-8fcc-c5c9c331914b"
+#define CHARACTERISTIC_UUID "beb5483e-36e1-4688-b7f5-ea07361b26a8"
+
+static const uint32_t kScanTimeMs = 5000;
+static const uint32_t kRounds     = 200;
+
+static std::vector<NimBLEAddress>               peers;
+static std::vector<NimBLERemoteCharacteristic*> characteristics;
+
+struct BenchResult {
+    uint32_t reads;
+    uint32_t bytes;
+    uint32_t failed;
+    uint32_t elapsedMs;
+};
+
+class ScanCallbacks : public NimBLEScanCallbacks {
+    void onResult(const NimBLEAdvertisedDevice* advertisedDevice) override {
+        if (advertisedDevice->isAdvertisingService(NimBLEUUID(SERVICE_UUID)) && peers.size() < CONFIG_BT_NIMBLE_MAX_CONNECTIONS) {
+            Serial.printf("Found peer: %s\n", advertisedDevice->getAddress().toString().c_str());
+            peers.push_back(advertisedDevice->getAddress());
+        }
+    }
+} scanCallbacks;
+
+static BenchResult runBlocking() {
+    BenchResult res{};
+    uint32_t    start = millis();
+    for (uint32_t round = 0; round < kRounds; round++) {
+        for (auto pChr : characteristics) {
+            NimBLEAttValue value = pChr->readValue();
+            if (value.size() == 0) {
+                res.failed++;
+                continue;
+            }
+            res.reads++;
+            res.bytes += value.size();
+        }
+    }
+    res.elapsedMs = millis() - start;
+    return res;
+}
+
+static BenchResult runAsync() {
+    BenchResult                   res{};
+    std::vector<NimBLEGattFuture> futures(characteristics.size());
+    uint32_t                      start = millis();
+    for (uint32_t round = 0; round < kRounds; round++) {
+        for (size_t i = 0; i < characteristics.size(); i++) {
+            futures[i] = characteristics[i]->readValueAsync();
+        }
+
+        NimBLEGattFuture::waitAll(futures.data(), futures.size());
+        for (auto& future : futures) {
+            if (future.getResult() != 0) {
+                res.failed++;
+                continue;
+            }
+            res.reads++;
+            res.bytes += future.getValue().size();
+        }
+    }
+    res.elapsedMs = millis() - start;
+    return res;
+}
+
+static void printResult(const char* name, const BenchResult& res) {
+    uint32_t ms = res.elapsedMs ? res.elapsedMs : 1;
+    Serial.printf("  %-9s %6lu reads/s, %7lu bytes/s, %lu failed\n",
+                  name,
+                  (unsigned long)(res.reads * 1000UL / ms),
+                  (unsigned long)(res.bytes * 1000UL / ms),
+                  (unsigned long)res.failed);
+}
+
+void setup() {
+    Serial.begin(115200);
+    Serial.println("Starting NimBLE async read benchmark");
+
+    NimBLEDevice::init("NimBLE-Read-Bench");
+
+    NimBLEScan* pScan = NimBLEDevice::getScan();
+    pScan->setScanCallbacks(&scanCallbacks);
+    pScan->setActiveScan(true);
+    pScan->getResults(kScanTimeMs);
+
+    for (auto& address : peers) {
+        NimBLEClient* pClient = NimBLEDevice::createClient(address);
+        if (!pClient->connect()) {
+            Serial.printf("Failed to connect to %s\n", address.toString().c_str());
+            NimBLEDevice::deleteClient(pClient);
+            continue;
+        }
+
+        NimBLERemoteService*        pSvc = pClient->getService(SERVICE_UUID);
+        NimBLERemoteCharacteristic* pChr = pSvc ? pSvc->getCharacteristic(CHARACTERISTIC_UUID) : nullptr;
+        if (!pChr) {
+            Serial.printf("%s has no benchmark characteristic\n", address.toString().c_str());
+            pClient->disconnect();
+            continue;
+        }
+        characteristics.push_back(pChr);
+    }
+
+    Serial.printf("%u connection(s). Send 'b' to run the benchmark.\n", (unsigned)characteristics.size());
+}
+
+void loop() {
+    if (Serial.available() && Serial.read() == 'b') {
+        if (characteristics.empty()) {
+            Serial.println("No peers connected");
+            return;
+        }
+
+        Serial.printf("%u connection(s), %lu rounds:\n", (unsigned)characteristics.size(), (unsigned long)kRounds);
+        printResult("blocking", runBlocking());
+        delay(500);
+        printResult("async", runAsync());
+    }
+    delay(10);
+}
@@ -0,0 +1,104 @@
+/**
+ *  NimBLEAttValue Heap Allocation Benchmark
+ *
+ *  Counts the heap allocations made by NimBLEAttValue for typical GATT workloads:
+ *  - 8 byte HID keyboard reports written to a characteristic value,
+ *  - 7 byte card ids read back with getValue() (a copy) and with getValueView() (no copy),
+ *  - notification payloads stored in a remote characteristic value,
+ *  - a 100 byte value, larger than the inline storage.
+ *
+ *  Values up to CONFIG_NIMBLE_CPP_ATT_VALUE_INLINE_LENGTH bytes are stored inside the object.
+ *  To see the numbers without inline storage build again with
+ *  #define CONFIG_NIMBLE_CPP_ATT_VALUE_INLINE_LENGTH 0 in nimconfig.h.
+ */
+
+#include <Arduino.h>
+#include <NimBLEDevice.h>
+
+static constexpr int iterations = 1000;
+
+/** Holds a value like a characteristic does, so getValue() returns a copy and getValueView() a view. */
+class BenchAttribute : public NimBLEValueAttribute {
+  public:
+    void set(const uint8_t* data, uint16_t len) { m_value.setValue(data, len); }
+};
+
+static void report(const char* name, uint32_t allocs, uint32_t checksum) {
+    printf("%-34s %6lu allocations (%.2f per op) [%lu]\n",
+           name,
+           (unsigned long)allocs,
+           (double)allocs / iterations,
+           (unsigned long)checksum);
+}
+
+void runBenchmark() {
+    const uint8_t keyReport[8] = {0x02, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x00, 0x00};
+    const uint8_t cardId[7]    = {0x04, 0xA1, 0x5C, 0x3A, 0x7B, 0x12, 0x90};
+    uint8_t       large[100];
+    memset(large, 0x55, sizeof(large));
+
+    printf("Inline length: %d bytes, sizeof(NimBLEAttValue): %u\n",
+           CONFIG_NIMBLE_CPP_ATT_VALUE_INLINE_LENGTH,
+           (unsigned)sizeof(NimBLEAttValue));
+
+    // Create the attribute values, as done for every characteristic and descriptor.
+    NimBLEAttValue::resetHeapAllocCount();
+    uint32_t checksum = 0;
+    for (int i = 0; i < iterations; i++) {
+        BenchAttribute att;
+        checksum += att.getLength();
+    }
+    report("construct attribute value", NimBLEAttValue::getHeapAllocCount(), checksum);
+
+    BenchAttribute keyboard;
+    NimBLEAttValue::resetHeapAllocCount();
+    for (int i = 0; i < iterations; i++) {
+        keyboard.set(keyReport, sizeof(keyReport));
+    }
+    report("set 8 byte HID report", NimBLEAttValue::getHeapAllocCount(), keyboard.getLength());
+
+    BenchAttribute card;
+    card.set(cardId, sizeof(cardId));
+    NimBLEAttValue::resetHeapAllocCount();
+    checksum = 0;
+    for (int i = 0; i < iterations; i++) {
+        NimBLEAttValue value = card.getValue();
+        checksum            += value[0];
+    }
+    report("getValue() 7 byte card id", NimBLEAttValue::getHeapAllocCount(), checksum);
+
+    NimBLEAttValue::resetHeapAllocCount();
+    checksum = 0;
+    for (int i = 0; i < iterations; i++) {
+        NimBLEAttValueView view  = card.getValueView();
+        checksum                += view[0];
+    }
+    report("getValueView() 7 byte card id", NimBLEAttValue::getHeapAllocCount(), checksum);
+
+    // A remote value is constructed empty and filled by each notification.
+    NimBLEAttValue::resetHeapAllocCount();
+    checksum = 0;
+    for (int i = 0; i < iterations; i++) {
+        NimBLEAttValue notification;
+        notification.setValue(keyReport, sizeof(keyReport));
+        checksum += notification.size();
+    }
+    report("receive 8 byte notification", NimBLEAttValue::getHeapAllocCount(), checksum);
+
+    NimBLEAttValue::resetHeapAllocCount();
+    checksum = 0;
+    for (int i = 0; i < iterations; i++) {
+        NimBLEAttValue value(large, sizeof(large));
+        NimBLEAttValue copy  = value;
+        checksum            += copy.size();
+    }
+    report("construct + copy 100 byte value", NimBLEAttValue::getHeapAllocCount(), checksum);
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+    runBenchmark();
+}
+
+void loop() {}
@@ -0,0 +1,148 @@
+/*
+ * NimBLE_EATT_Benchmark
+ *
+ * Compares the read throughput of one connection with one request in flight, as on the unenhanced ATT
+ * bearer, with kConcurrent reads in flight that the host spreads over its Enhanced ATT (EATT) bearers.
+ *
+ * Build this device and the peer with CONFIG_BT_NIMBLE_EATT_CHAN_NUM >= 1 and flash NimBLE_Notify_Benchmark
+ * on the peer, it provides the readable characteristic. EATT bearers are opened once the link is encrypted,
+ * so this device pairs after connecting. Send 'b' on the serial port to run the benchmark.
+ * Keep CONFIG_NIMBLE_CPP_LOG_LEVEL at 0, read completions are logged at info level.
+ *
+ * Output per run: reads per second and bytes per second, followed by the request statistics of the
+ * connection. The host does not report which bearer carried a request, the most requests in flight at
+ * the same time shows whether more than one bearer was used.
+ */
+
+#include <Arduino.h>
+#include <NimBLEDevice.h>
+
+#include <vector>
+
+#define SERVICE_UUID        "4fafc201-1fb5-459e-8fcc-c5c9c331914b"
+#define CHARACTERISTIC_UUID "beb5483e-36e1-4688-b7f5-ea07361b26a8"
+
+static const uint32_t kScanTimeMs   = 5000;
+static const uint32_t kBearerWaitMs = 3000;
+static const uint32_t kReads        = 1000;
+static const size_t   kConcurrent   = 8;
+
+static const NimBLEAdvertisedDevice* device = nullptr;
+static NimBLEClient*                 client = nullptr;
+static NimBLERemoteCharacteristic*   pChr   = nullptr;
+
+struct BenchResult {
+    uint32_t reads;
+    uint32_t bytes;
+    uint32_t failed;
+    uint32_t elapsedMs;
+};
+
+class ScanCallbacks : public NimBLEScanCallbacks {
+    void onResult(const NimBLEAdvertisedDevice* advertisedDevice) override {
+        if (!device && advertisedDevice->isAdvertisingService(NimBLEUUID(SERVICE_UUID))) {
+            Serial.printf("Found peer: %s\n", advertisedDevice->getAddress().toString().c_str());
+            device = advertisedDevice;
+            NimBLEDevice::getScan()->stop();
+        }
+    }
+} scanCallbacks;
+
+static BenchResult run(size_t concurrent) {
+    BenchResult                   res{};
+    std::vector<NimBLEGattFuture> futures(concurrent);
+    client->clearRequestStats();
+    uint32_t start = millis();
+    for (uint32_t done = 0; done < kReads; done += concurrent) {
+        for (auto& future : futures) {
+            future = pChr->readValueAsync();
+        }
+
+        NimBLEGattFuture::waitAll(futures.data(), futures.size());
+        for (auto& future : futures) {
+            if (future.getResult() != 0) {
+                res.failed++;
+                continue;
+            }
+            res.reads++;
+            res.bytes += future.getValue().size();
+        }
+    }
+    res.elapsedMs = millis() - start;
+    return res;
+}
+
+static void printResult(const char* name, const BenchResult& res) {
+    uint32_t ms = res.elapsedMs ? res.elapsedMs : 1;
+    Serial.printf("  %-9s %6lu reads/s, %7lu bytes/s, %lu failed\n",
+                  name,
+                  (unsigned long)(res.reads * 1000UL / ms),
+                  (unsigned long)(res.bytes * 1000UL / ms),
+                  (unsigned long)res.failed);
+
+    const NimBLEGattRequestStats stats = client->getRequestStats();
+    Serial.printf("    %lu requests, %lu bytes, %lu errors, %lu ms per request, at most %u in flight\n",
+                  (unsigned long)stats.requests,
+                  (unsigned long)stats.bytes,
+                  (unsigned long)stats.errors,
+                  (unsigned long)(stats.requests ? stats.busyMs / stats.requests : 0),
+                  (unsigned)stats.maxInFlight);
+}
+
+void setup() {
+    Serial.begin(115200);
+    Serial.println("Starting NimBLE EATT benchmark");
+
+    NimBLEDevice::init("NimBLE-EATT-Bench");
+    NimBLEDevice::setMTU(BLE_ATT_MTU_MAX);
+
+    NimBLEScan* pScan = NimBLEDevice::getScan();
+    pScan->setScanCallbacks(&scanCallbacks);
+    pScan->setActiveScan(true);
+    pScan->getResults(kScanTimeMs);
+    if (!device) {
+        Serial.println("No peer found");
+        return;
+    }
+
+    client = NimBLEDevice::createClient();
+    if (!client->connect(device)) {
+        Serial.println("Failed to connect");
+        return;
+    }
+
+    if (!client->secureConnection()) {
+        Serial.println("Pairing failed, reads stay on the ATT bearer");
+    }
+
+    // The bearers connect in the background after encryption.
+    uint32_t start = millis();
+    while (client->getBearerCount() < 1 + CONFIG_BT_NIMBLE_EATT_CHAN_NUM && millis() - start < kBearerWaitMs) {
+        delay(10);
+    }
+
+    NimBLERemoteService* pSvc = client->getService(SERVICE_UUID);
+    pChr                      = pSvc ? pSvc->getCharacteristic(CHARACTERISTIC_UUID) : nullptr;
+    if (!pChr) {
+        Serial.println("Peer has no benchmark characteristic");
+        client->disconnect();
+        return;
+    }
+
+    Serial.printf("%u bearer(s). Send 'b' to run the benchmark.\n", (unsigned)client->getBearerCount());
+}
+
+void loop() {
+    if (Serial.available() && Serial.read() == 'b') {
+        if (!pChr || !client->isConnected()) {
+            Serial.println("Not connected");
+            return;
+        }
+
+        Serial.printf("%u bearer(s), %lu reads:\n", (unsigned)client->getBearerCount(), (unsigned long)kReads);
+        printResult("single", run(1));
+        delay(500);
+        printResult("spread", run(kConcurrent));
+    }
+    delay(10);
+}
@@ -0,0 +1,202 @@
+/*
+ * NimBLE_L2CAP_Benchmark
+ *
+ * Compares the L2CAP CoC send paths of NimBLEL2CAPChannel:
+ *  - vector:  the payload is copied into a std::vector and passed to write(const std::vector<uint8_t>&),
+ *             which copies it again into the channel's mbufs.
+ *  - pointer: the payload is passed to write(const uint8_t*, size_t), one copy into the channel's mbufs.
+ *  - mbuf:    the payload is built in an msys mbuf chain and handed over with write(os_mbuf*),
+ *             the channel does not copy it.
+ *  - queued:  the payload is queued with trySend(const uint8_t*, size_t), the host task sends the
+ *             queued SDUs back to back instead of waking this task after every SDU.
+ *
+ * Flash the L2CAP_Server example on a second device, it receives the SDUs with the view based onRead
+ * and does not copy them either. This device connects to the first server it finds,
+ * send 'b' on the serial port to run the benchmark.
+ * Build with CONFIG_BT_NIMBLE_L2CAP_COC_MAX_NUM >= 1 and CONFIG_NIMBLE_CPP_LOG_LEVEL at 0.
+ *
+ * Output per path: throughput and the average time spent preparing and writing one SDU,
+ * for the queued path the time spent in trySend.
+ */
+
+#include <Arduino.h>
+#include <NimBLEDevice.h>
+
+#include <atomic>
+#include <vector>
+
+#if CONFIG_BT_NIMBLE_L2CAP_COC_MAX_NUM <= 0
+# error "CONFIG_BT_NIMBLE_L2CAP_COC_MAX_NUM must be set to 1 or greater"
+#endif
+
+#define SERVICE_UUID  "dcbc7255-1e9e-49a0-a360-b0430b6c6905"
+#define L2CAP_CHANNEL 150
+#define L2CAP_MTU     5000
+
+// Small enough for an msys chain, see CONFIG_BT_NIMBLE_MSYS1_BLOCK_COUNT.
+static const size_t   kSduSize = 1000;
+static const uint32_t kSdus    = 500;
+
+static const NimBLEAdvertisedDevice* device  = nullptr;
+static NimBLEClient*                 client  = nullptr;
+static NimBLEL2CAPChannel*           channel = nullptr;
+static uint8_t                       payload[kSduSize];
+static std::atomic<uint32_t>         completed{0};
+static std::atomic<uint32_t>         completeFailed{0};
+
+struct BenchResult {
+    uint32_t sdus;
+    uint32_t failed;
+    uint32_t elapsedMs;
+    uint64_t writeUs;
+};
+
+class ScanCallbacks : public NimBLEScanCallbacks {
+    void onResult(const NimBLEAdvertisedDevice* advertisedDevice) override {
+        if (!device && advertisedDevice->isAdvertisingService(NimBLEUUID(SERVICE_UUID))) {
+            Serial.printf("Found server: %s\n", advertisedDevice->getAddress().toString().c_str());
+            device = advertisedDevice;
+            NimBLEDevice::getScan()->stop();
+        }
+    }
+} scanCallbacks;
+
+class ChannelCallbacks : public NimBLEL2CAPChannelCallbacks {
+    void onConnect(NimBLEL2CAPChannel* channel, uint16_t negotiatedMTU) override {
+        Serial.printf("L2CAP connected, MTU %u\n", negotiatedMTU);
+    }
+
+    void onWriteComplete(NimBLEL2CAPChannel* channel, int status) override {
+        status == 0 ? completed++ : completeFailed++;
+    }
+
+    void onDisconnect(NimBLEL2CAPChannel* channel) override { Serial.println("L2CAP disconnected"); }
+};
+
+static bool writeVector(uint8_t seq) {
+    payload[0] = seq;
+    std::vector<uint8_t> data(payload, payload + kSduSize);
+    return channel->write(data);
+}
+
+static bool writePointer(uint8_t seq) {
+    payload[0] = seq;
+    return channel->write(payload, kSduSize);
+}
+
+static bool writeMbuf(uint8_t seq) {
+    payload[0]          = seq;
+    struct os_mbuf* sdu = os_msys_get_pkthdr(kSduSize, 0);
+    if (!sdu) {
+        return false;
+    }
+
+    // Stands in for producing the data directly into the chain.
+    if (os_mbuf_append(sdu, payload, kSduSize) != 0) {
+        os_mbuf_free_chain(sdu);
+        return false;
+    }
+
+    return channel->write(sdu);
+}
+
+static BenchResult run(bool (*writeSdu)(uint8_t)) {
+    BenchResult res{};
+    uint32_t    start = millis();
+    for (uint32_t i = 0; i < kSdus && channel->isConnected(); i++) {
+        uint32_t t0 = micros();
+        bool     ok = writeSdu(static_cast<uint8_t>(i));
+        res.writeUs += micros() - t0;
+        ok ? res.sdus++ : res.failed++;
+    }
+    res.elapsedMs = millis() - start;
+    return res;
+}
+
+static BenchResult runQueued() {
+    BenchResult res{};
+    completed      = 0;
+    completeFailed = 0;
+    uint32_t start = millis();
+    for (uint32_t i = 0; i < kSdus && channel->isConnected();) {
+        payload[0]  = static_cast<uint8_t>(i);
+        uint32_t t0 = micros();
+        bool     ok = channel->trySend(payload, kSduSize);
+        res.writeUs += micros() - t0;
+        if (ok) {
+            i++;
+        } else {
+            delay(1); // Queue full or pool exhausted, wait for completions.
+        }
+    }
+
+    while (channel->getTxQueueCount() && channel->isConnected()) {
+        delay(1);
+    }
+    res.elapsedMs = millis() - start;
+    res.sdus      = completed;
+    res.failed    = completeFailed;
+    return res;
+}
+
+static void printResult(const char* name, const BenchResult& res) {
+    uint32_t bytesPerSec = res.elapsedMs ? static_cast<uint32_t>(uint64_t(res.sdus) * kSduSize * 1000 / res.elapsedMs) : 0;
+    Serial.printf("%-8s %5u SDUs %3u failed %6u ms %7u B/s %6u us/SDU\n",
+                  name,
+                  res.sdus,
+                  res.failed,
+                  res.elapsedMs,
+                  bytesPerSec,
+                  res.sdus ? static_cast<uint32_t>(res.writeUs / res.sdus) : 0);
+}
+
+void setup() {
+    Serial.begin(115200);
+    Serial.println("Starting NimBLE L2CAP benchmark");
+
+    for (size_t i = 0; i < kSduSize; i++) {
+        payload[i] = static_cast<uint8_t>(i);
+    }
+
+    NimBLEDevice::init("L2CAP-Bench");
+    NimBLEDevice::setMTU(BLE_ATT_MTU_MAX);
+
+    NimBLEScan* pScan = NimBLEDevice::getScan();
+    pScan->setScanCallbacks(&scanCallbacks);
+    pScan->setActiveScan(true);
+    pScan->start(10000, false);
+}
+
+void loop() {
+    if (!device) {
+        delay(100);
+        return;
+    }
+
+    if (!client) {
+        client = NimBLEDevice::createClient();
+        client->setConnectionParams(6, 6, 0, 42);
+        if (!client->connect(device)) {
+            Serial.println("Failed to connect");
+            return;
+        }
+        client->setDataLen(251);
+        channel = NimBLEL2CAPChannel::connect(client, L2CAP_CHANNEL, L2CAP_MTU, new ChannelCallbacks());
+        Serial.println("Send 'b' to run the benchmark");
+    }
+
+    if (Serial.read() != 'b') {
+        delay(10);
+        return;
+    }
+
+    if (!channel || !channel->isConnected()) {
+        Serial.println("L2CAP channel not connected");
+        return;
+    }
+
+    printResult("vector", run(writeVector));
+    printResult("pointer", run(writePointer));
+    printResult("mbuf", run(writeMbuf));
+    printResult("queued", runQueued());
+}
@@ -0,0 +1,118 @@
+/*
+ * NimBLE_Log_Benchmark
+ *
+ * Measures what logging costs the host task during a busy scan. With duplicates reported,
+ * NimBLEScan logs "Duplicate; updated: <address>" at Info level for every advertisement:
+ *  - sync:     what NIMBLE_LOGI does by default, the address is converted with toString()
+ *              and the line is printed from the host task.
+ *  - deferred: what NIMBLE_LOGI does with CONFIG_NIMBLE_CPP_LOG_DEFERRED, the format pointer and the
+ *              raw address are copied to the ring of the current core and printed by the log task.
+ *
+ * First the reports per second of a 10 second active scan are counted, then the cost of one log
+ * call on each path is timed with the addresses found. Their product is the host task time
+ * spent on this one log line per second of scanning.
+ * Build with CONFIG_NIMBLE_CPP_LOG_LEVEL at 0 so the scan itself does not log, set
+ * CONFIG_NIMBLE_CPP_LOG_DEFERRED to time the deferred path as well.
+ */
+
+#include <Arduino.h>
+#include <NimBLEDevice.h>
+#include <NimBLELogDeferred.h>
+
+#include <vector>
+
+static const uint32_t kScanTimeMs = 10000;
+static const uint32_t kCalls      = 256;
+// Below the ring capacity so no record is dropped while timing.
+static const uint32_t kBurst      = 16;
+
+static std::vector<NimBLEAddress> addresses;
+static volatile uint32_t          reports = 0;
+
+class ScanCallbacks : public NimBLEScanCallbacks {
+    void onResult(const NimBLEAdvertisedDevice* advertisedDevice) override {
+        reports++;
+        if (addresses.size() < kCalls) {
+            addresses.push_back(advertisedDevice->getAddress());
+        }
+    }
+} scanCallbacks;
+
+static uint32_t timeSync() {
+    uint32_t us = 0;
+    for (uint32_t i = 0; i < kCalls; i++) {
+        const NimBLEAddress& addr = addresses[i % addresses.size()];
+        uint32_t             t0   = micros();
+        printf("I %s: Duplicate; updated: %s\n", "NimBLEScan", addr.toString().c_str());
+        us += micros() - t0;
+    }
+    return us;
+}
+
+#if CONFIG_NIMBLE_CPP_LOG_DEFERRED
+static uint32_t timeDeferred() {
+    uint32_t us = 0;
+    for (uint32_t i = 0; i < kCalls; i++) {
+        const NimBLEAddress& addr = addresses[i % addresses.size()];
+        uint32_t             t0   = micros();
+        NimBLELogDeferred::write('I', "NimBLEScan", "Duplicate; updated: %s", addr);
+        us += micros() - t0;
+        if (i % kBurst == kBurst - 1) {
+            NimBLELogDeferred::flush();
+        }
+    }
+    NimBLELogDeferred::flush();
+    return us;
+}
+#endif
+
+static void printResult(const char* name, uint32_t us, uint32_t reportsPerSec) {
+    uint32_t nsPerCall = static_cast<uint32_t>(uint64_t(us) * 1000 / kCalls);
+    uint32_t usPerSec  = static_cast<uint32_t>(uint64_t(nsPerCall) * reportsPerSec / 1000);
+    Serial.printf("%-8s %7u ns/call %7u us host task/s (%u.%u %%)\n",
+                  name,
+                  nsPerCall,
+                  usPerSec,
+                  usPerSec / 10000,
+                  usPerSec / 1000 % 10);
+}
+
+void setup() {
+    Serial.begin(115200);
+    Serial.println("Starting NimBLE log benchmark");
+
+    NimBLEDevice::init("Log-Bench");
+    addresses.reserve(kCalls);
+
+    NimBLEScan* pScan = NimBLEDevice::getScan();
+    pScan->setScanCallbacks(&scanCallbacks, true);
+    pScan->setActiveScan(true);
+    pScan->setInterval(100);
+    pScan->setWindow(100);
+    pScan->start(kScanTimeMs, false);
+    while (pScan->isScanning()) {
+        delay(100);
+    }
+
+    if (addresses.empty()) {
+        Serial.println("No advertisements received");
+        return;
+    }
+
+    uint32_t reportsPerSec = reports * 1000 / kScanTimeMs;
+    Serial.printf("%u reports in %u ms, %u reports/s\n", reports, kScanTimeMs, reportsPerSec);
+
+    uint32_t syncUs = timeSync();
+    printResult("sync", syncUs, reportsPerSec);
+#if CONFIG_NIMBLE_CPP_LOG_DEFERRED
+    uint32_t deferredUs = timeDeferred();
+    printResult("deferred", deferredUs, reportsPerSec);
+    Serial.printf("dropped  %u\n", NimBLELogDeferred::getDroppedCount());
+#else
+    Serial.println("deferred skipped, CONFIG_NIMBLE_CPP_LOG_DEFERRED is not set");
+#endif
+}
+
+void loop() {
+    delay(1000);
+}
@@ -0,0 +1,134 @@
+/*
+ * NimBLE_Notify_Benchmark
+ *
+ * Compares the notifies per second of the per-peer copy path (one vector of peers and one
+ * ble_hs_mbuf_from_flat() copy per peer) with NimBLECharacteristic::notify(value, length, result),
+ * which builds the packet once and duplicates it for each connected peer.
+ *
+ * Connect 1 to CONFIG_BT_NIMBLE_MAX_CONNECTIONS centrals (set it to 9 in nimconfig.h for the full range),
+ * subscribe to the characteristic and send 'b' on the serial port to run the benchmark.
+ * Keep CONFIG_NIMBLE_CPP_LOG_LEVEL at 0, failed sends are logged as errors.
+ *
+ * Output per run: peer notifies per second, CPU time per notify call and the number of
+ * calls that failed for at least one peer (mbuf pool exhausted).
+ */
+
+#include <Arduino.h>
+#include <NimBLEDevice.h>
+
+#define SERVICE_UUID        "4fafc201-1fb5-459e-8fcc-c5c9c331914b"
+#define CHARACTERISTIC_UUID "beb5483e-36e1-4688-b7f5-ea07361b26a8"
+
+static const uint32_t kBenchDurationMs = 3000;
+static const size_t   kPayloadLength   = 20;
+
+static NimBLECharacteristic* pCharacteristic = nullptr;
+static uint8_t               payload[kPayloadLength];
+
+struct BenchResult {
+    uint32_t peerNotifies;
+    uint32_t calls;
+    uint32_t failedCalls;
+    uint32_t busyUs;
+};
+
+class ServerCallbacks : public NimBLEServerCallbacks {
+    void onConnect(NimBLEServer* pServer, NimBLEConnInfo& connInfo) override {
+        Serial.printf("Connected: %s, %u peer(s)\n",
+                      connInfo.getAddress().toString().c_str(),
+                      pServer->getConnectedCount());
+        if (pServer->getConnectedCount() < CONFIG_BT_NIMBLE_MAX_CONNECTIONS) {
+            NimBLEDevice::startAdvertising();
+        }
+    }
+
+    void onDisconnect(NimBLEServer* pServer, NimBLEConnInfo& connInfo, int reason) override {
+        Serial.printf("Disconnected, %u peer(s)\n", pServer->getConnectedCount());
+        NimBLEDevice::startAdvertising();
+    }
+} serverCallbacks;
+
+/** The previous implementation of sending a custom value to all peers, kept here as the baseline. */
+static uint8_t notifyAllPerPeerCopy(const uint8_t* value, size_t length) {
+    uint8_t sent = 0;
+    for (const auto& connHandle : NimBLEDevice::getServer()->getPeerDevices()) {
+        os_mbuf* om = ble_hs_mbuf_from_flat(value, length);
+        if (!om) {
+            continue;
+        }
+        if (ble_gattc_notify_custom(connHandle, pCharacteristic->getHandle(), om) == 0) {
+            sent++;
+        }
+    }
+    return sent;
+}
+
+static uint8_t notifyAllMulticast(const uint8_t* value, size_t length) {
+    NimBLECharacteristic::SendResult result;
+    pCharacteristic->notify(value, length, result);
+    return result.sent;
+}
+
+static BenchResult runBench(uint8_t (*notifyAll)(const uint8_t*, size_t), uint8_t peers) {
+    BenchResult res{};
+    uint32_t    start = millis();
+    while (millis() - start < kBenchDurationMs) {
+        payload[0]++;
+        uint32_t t0   = micros();
+        uint8_t  sent = notifyAll(payload, sizeof(payload));
+        res.busyUs += micros() - t0;
+        res.calls++;
+        res.peerNotifies += sent;
+        if (sent < peers) {
+            // Out of buffers, give the host task time to hand packets to the controller.
+            res.failedCalls++;
+            delay(1);
+        }
+    }
+    return res;
+}
+
+static void printResult(const char* name, const BenchResult& res) {
+    Serial.printf("  %-14s %6lu notifies/s, %4lu us/call, %lu/%lu calls incomplete\n",
+                  name,
+                  (unsigned long)(res.peerNotifies * 1000UL / kBenchDurationMs),
+                  (unsigned long)(res.calls ? res.busyUs / res.calls : 0),
+                  (unsigned long)res.failedCalls,
+                  (unsigned long)res.calls);
+}
+
+void setup() {
+    Serial.begin(115200);
+    Serial.println("Starting NimBLE notify benchmark");
+
+    NimBLEDevice::init("NimBLE-Notify-Bench");
+
+    NimBLEServer* pServer = NimBLEDevice::createServer();
+    pServer->setCallbacks(&serverCallbacks);
+
+    NimBLEService* pService = pServer->createService(SERVICE_UUID);
+    pCharacteristic = pService->createCharacteristic(CHARACTERISTIC_UUID, NIMBLE_PROPERTY::READ | NIMBLE_PROPERTY::NOTIFY);
+    pService->start();
+
+    NimBLEAdvertising* pAdvertising = NimBLEDevice::getAdvertising();
+    pAdvertising->addServiceUUID(SERVICE_UUID);
+    pAdvertising->start();
+
+    Serial.printf("Advertising, up to %d connections. Send 'b' to run the benchmark.\n", CONFIG_BT_NIMBLE_MAX_CONNECTIONS);
+}
+
+void loop() {
+    if (Serial.available() && Serial.read() == 'b') {
+        uint8_t peers = NimBLEDevice::getServer()->getConnectedCount();
+        if (peers == 0) {
+            Serial.println("No peers connected");
+            return;
+        }
+
+        Serial.printf("%u connection(s), %u byte payload:\n", peers, (unsigned)kPayloadLength);
+        printResult("per-peer copy", runBench(notifyAllPerPeerCopy, peers));
+        delay(500);
+        printResult("multicast", runBench(notifyAllMulticast, peers));
+    }
+    delay(10);
+}
@@ -0,0 +1,71 @@
+/**
+ *  Streaming Scan Example
+ *
+ *  This example demonstrates the streaming scan mode.
+ *  The NimBLE host task only copies each advertising report into a ring of compact records,
+ *  no advertised device objects are created and no scan callbacks are invoked per report.
+ *  An application task reads the records in batches and does the actual work, here printing
+ *  the address, RSSI and payload. Every few seconds the ring statistics are printed, overruns
+ *  show that the consumer could not keep up.
+ */
+
+#include <Arduino.h>
+#include <NimBLEDevice.h>
+
+static constexpr uint16_t streamCapacity = 64; // Records in the ring.
+static constexpr size_t   batchSize      = 16; // Records read per batch.
+
+void consumerTask(void* param) {
+    NimBLEScanRing&  stream = NimBLEDevice::getScan()->getStream();
+    NimBLEScanRecord batch[batchSize];
+    uint32_t         lastStats = millis();
+
+    for (;;) {
+        size_t count = stream.pop(batch, batchSize);
+        for (size_t i = 0; i < count; i++) {
+            const NimBLEScanRecord& rec = batch[i];
+            printf("%02x:%02x:%02x:%02x:%02x:%02x rssi=%d len=%u%s %s\n",
+                   rec.addr[5],
+                   rec.addr[4],
+                   rec.addr[3],
+                   rec.addr[2],
+                   rec.addr[1],
+                   rec.addr[0],
+                   rec.rssi,
+                   rec.length,
+                   rec.flags & NimBLEScanRecord::FLAG_SLICED ? "+" : "",
+                   NimBLEUtils::dataToHexString(rec.data, rec.length).c_str());
+        }
+
+        if (millis() - lastStats > 5000) {
+            NimBLEScanRing::Stats stats = stream.getStats();
+            printf("pushed=%lu overruns=%lu sliced=%lu highWater=%lu/%u\n",
+                   (unsigned long)stats.pushed,
+                   (unsigned long)stats.overruns,
+                   (unsigned long)stats.sliced,
+                   (unsigned long)stats.highWater,
+                   (unsigned)stream.capacity());
+            lastStats = millis();
+        }
+
+        // Nothing waiting, give the host task time to fill the ring.
+        if (count == 0) {
+            vTaskDelay(pdMS_TO_TICKS(20));
+        }
+    }
+}
+
+void setup() {
+    Serial.begin(115200);
+    NimBLEDevice::init("");
+    NimBLEScan* pBLEScan = NimBLEDevice::getScan();
+    pBLEScan->setActiveScan(false);
+    pBLEScan->setDuplicateFilter(false); // Report every advertisement.
+    pBLEScan->setStreaming(streamCapacity);
+
+    xTaskCreate(consumerTask, "scanConsumer", 4096, nullptr, 1, nullptr);
+    pBLEScan->start(0, false, true); // Scan forever.
+    printf("Streaming scan started\n");
+}
+
+void loop() {}
@@ -0,0 +1,153 @@
+/**
+ *  NimBLE Static GATT Benchmark
+ *
+ *  Builds the same HID keyboard GATT table (HID service with 7 characteristics and a report reference
+ *  descriptor, device information service with the manufacturer name) twice:
+ *  - dynamic: createService / createCharacteristic / setValue / start, as done by HidKeyboard::begin,
+ *  - static:  a constexpr table declared with NimBLEStaticGatt and registered with addStaticServices.
+ *
+ *  For each path the time and the heap used to set up the table are printed,
+ *  then the time of NimBLEServer::start() which registers both tables.
+ *  The static table is registered first, so the dynamic one is measured with the same stack state.
+ */
+
+#include <Arduino.h>
+#include <NimBLEDevice.h>
+
+// Boot keyboard report map, 8 byte input report, 1 byte LED output report.
+static constexpr uint8_t reportMap[] = {
+    0x05, 0x01, 0x09, 0x06, 0xA1, 0x01, 0x85, 0x01, 0x05, 0x07, 0x19, 0xE0, 0x29, 0xE7, 0x15, 0x00, 0x25, 0x01,
+    0x75, 0x01, 0x95, 0x08, 0x81, 0x02, 0x95, 0x01, 0x75, 0x08, 0x81, 0x01, 0x95, 0x06, 0x75, 0x08, 0x15, 0x00,
+    0x25, 0x65, 0x05, 0x07, 0x19, 0x00, 0x29, 0x65, 0x81, 0x00, 0x95, 0x05, 0x75, 0x01, 0x05, 0x08, 0x19, 0x01,
+    0x29, 0x05, 0x91, 0x02, 0x95, 0x01, 0x75, 0x03, 0x91, 0x01, 0xC0};
+static constexpr uint8_t hidInfo[]      = {0x11, 0x01, 0x00, 0x02};
+static constexpr uint8_t reportRef[]    = {0x01, 0x01};
+static constexpr uint8_t manufacturer[] = {'T', 'e', 's', 't', 'C', 'o'};
+
+/** Values of the static table. */
+static uint8_t  protocolMode  = 0x01;
+static uint8_t  controlPoint  = 0x00;
+static uint8_t  inputReport[8]{};
+static uint8_t  bootInput[8]{};
+static uint8_t  bootOutput    = 0x00;
+static uint16_t inputReportHandle;
+static uint16_t bootInputHandle;
+
+using Gatt = NimBLEStaticGatt;
+
+static constexpr ble_uuid16_t hidSvcUuid       = Gatt::uuid16(0x1812);
+static constexpr ble_uuid16_t protocolModeUuid = Gatt::uuid16(0x2A4E);
+static constexpr ble_uuid16_t hidInfoUuid      = Gatt::uuid16(0x2A4A);
+static constexpr ble_uuid16_t controlPointUuid = Gatt::uuid16(0x2A4C);
+static constexpr ble_uuid16_t reportMapUuid    = Gatt::uuid16(0x2A4B);
+static constexpr ble_uuid16_t reportUuid       = Gatt::uuid16(0x2A4D);
+static constexpr ble_uuid16_t bootInputUuid    = Gatt::uuid16(0x2A22);
+static constexpr ble_uuid16_t bootOutputUuid   = Gatt::uuid16(0x2A32);
+static constexpr ble_uuid16_t reportRefUuid    = Gatt::uuid16(0x2908);
+static constexpr ble_uuid16_t disSvcUuid       = Gatt::uuid16(0x180A);
+static constexpr ble_uuid16_t manufacturerUuid = Gatt::uuid16(0x2A29);
+
+static ble_gatt_dsc_def inputReportDscs[] = {
+    Gatt::descriptor(&reportRefUuid.u, BLE_ATT_F_READ, Gatt::access<Gatt::ConstValue<reportRef, sizeof(reportRef)>>),
+    Gatt::endOfDescriptors()};
+
+static constexpr ble_gatt_chr_def hidChrs[] = {
+    Gatt::characteristic(&protocolModeUuid.u,
+                         Gatt::access<Gatt::Value<uint8_t, &protocolMode>>,
+                         NIMBLE_PROPERTY::READ | NIMBLE_PROPERTY::WRITE_NR),
+    Gatt::characteristic(&hidInfoUuid.u, Gatt::access<Gatt::ConstValue<hidInfo, sizeof(hidInfo)>>, NIMBLE_PROPERTY::READ),
+    Gatt::characteristic(&controlPointUuid.u, Gatt::access<Gatt::Value<uint8_t, &controlPoint>>, NIMBLE_PROPERTY::WRITE_NR),
+    Gatt::characteristic(&reportMapUuid.u, Gatt::access<Gatt::ConstValue<reportMap, sizeof(reportMap)>>, NIMBLE_PROPERTY::READ),
+    Gatt::characteristic(&reportUuid.u,
+                         Gatt::access<Gatt::Value<uint8_t[8], &inputReport>>,
+                         NIMBLE_PROPERTY::READ | NIMBLE_PROPERTY::NOTIFY,
+                         &inputReportHandle,
+                         inputReportDscs),
+    Gatt::characteristic(&bootInputUuid.u,
+                         Gatt::access<Gatt::Value<uint8_t[8], &bootInput>>,
+                         NIMBLE_PROPERTY::READ | NIMBLE_PROPERTY::NOTIFY,
+                         &bootInputHandle),
+    Gatt::characteristic(&bootOutputUuid.u,
+                         Gatt::access<Gatt::Value<uint8_t, &bootOutput>>,
+                         NIMBLE_PROPERTY::READ | NIMBLE_PROPERTY::WRITE | NIMBLE_PROPERTY::WRITE_NR),
+    Gatt::endOfCharacteristics()};
+
+static constexpr ble_gatt_chr_def disChrs[] = {
+    Gatt::characteristic(&manufacturerUuid.u,
+                         Gatt::access<Gatt::ConstValue<manufacturer, sizeof(manufacturer)>>,
+                         NIMBLE_PROPERTY::READ),
+    Gatt::endOfCharacteristics()};
+
+static constexpr ble_gatt_svc_def gattTable[] = {Gatt::primaryService(&hidSvcUuid.u, hidChrs),
+                                                 Gatt::primaryService(&disSvcUuid.u, disChrs),
+                                                 Gatt::endOfServices()};
+
+struct BenchResult {
+    uint32_t us;
+    uint32_t heap;
+};
+
+static BenchResult setupStatic(NimBLEServer* pServer) {
+    uint32_t heap  = ESP.getFreeHeap();
+    uint32_t start = micros();
+    pServer->addStaticServices(gattTable);
+    BenchResult res{};
+    res.us   = micros() - start;
+    res.heap = heap - ESP.getFreeHeap();
+    return res;
+}
+
+static BenchResult setupDynamic(NimBLEServer* pServer) {
+    uint32_t heap  = ESP.getFreeHeap();
+    uint32_t start = micros();
+
+    NimBLEService* hid = pServer->createService(NimBLEUUID(hidSvcUuid.value));
+    hid->createCharacteristic(NimBLEUUID(protocolModeUuid.value), NIMBLE_PROPERTY::READ | NIMBLE_PROPERTY::WRITE_NR)
+        ->setValue(protocolMode);
+    hid->createCharacteristic(NimBLEUUID(hidInfoUuid.value), NIMBLE_PROPERTY::READ)->setValue(hidInfo, sizeof(hidInfo));
+    hid->createCharacteristic(NimBLEUUID(controlPointUuid.value), NIMBLE_PROPERTY::WRITE_NR)->setValue(controlPoint);
+    hid->createCharacteristic(NimBLEUUID(reportMapUuid.value), NIMBLE_PROPERTY::READ)->setValue(reportMap, sizeof(reportMap));
+    NimBLECharacteristic* report =
+        hid->createCharacteristic(NimBLEUUID(reportUuid.value), NIMBLE_PROPERTY::READ | NIMBLE_PROPERTY::NOTIFY);
+    report->createDescriptor(NimBLEUUID(reportRefUuid.value), NIMBLE_PROPERTY::READ, 2)->setValue(reportRef, sizeof(reportRef));
+    hid->createCharacteristic(NimBLEUUID(bootInputUuid.value), NIMBLE_PROPERTY::READ | NIMBLE_PROPERTY::NOTIFY);
+    hid->createCharacteristic(NimBLEUUID(bootOutputUuid.value),
+                              NIMBLE_PROPERTY::READ | NIMBLE_PROPERTY::WRITE | NIMBLE_PROPERTY::WRITE_NR);
+    hid->start();
+
+    NimBLEService* dis = pServer->createService(NimBLEUUID(disSvcUuid.value));
+    dis->createCharacteristic(NimBLEUUID(manufacturerUuid.value), NIMBLE_PROPERTY::READ)->setValue("TestCo");
+    dis->start();
+
+    BenchResult res{};
+    res.us   = micros() - start;
+    res.heap = heap - ESP.getFreeHeap();
+    return res;
+}
+
+void setup() {
+    Serial.begin(115200);
+    Serial.println("Starting NimBLE Static GATT Benchmark");
+
+    NimBLEDevice::init("Static-GATT-Bench");
+    NimBLEServer* pServer = NimBLEDevice::createServer();
+
+    BenchResult staticRes  = setupStatic(pServer);
+    BenchResult dynamicRes = setupDynamic(pServer);
+
+    uint32_t heap  = ESP.getFreeHeap();
+    uint32_t start = micros();
+    pServer->start();
+    uint32_t startUs   = micros() - start;
+    uint32_t startHeap = heap - ESP.getFreeHeap();
+
+    Serial.printf("%-10s %8s %8s\n", "table", "us", "heap");
+    Serial.printf("%-10s %8lu %8lu\n", "dynamic", (unsigned long)dynamicRes.us, (unsigned long)dynamicRes.heap);
+    Serial.printf("%-10s %8lu %8lu\n", "static", (unsigned long)staticRes.us, (unsigned long)staticRes.heap);
+    Serial.printf("server start (both tables): %lu us, %lu bytes\n", (unsigned long)startUs, (unsigned long)startHeap);
+    Serial.printf("handles: input report %u, boot input %u\n", inputReportHandle, bootInputHandle);
+}
+
+void loop() {
+    delay(1000);
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2020-2025 Ryan Powell <ryan@nable-embedded.io> and
+ * esp-nimble-cpp, NimBLE-Arduino contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NimBLEAdvFieldIndex.h"
+
+/**
+ * @brief Bit of the presence mask for an AD type, types sharing the low 5 bits share a bit.
+ */
+uint32_t NimBLEAdvFieldIndex::typeBit(uint8_t type) {
+    return 1UL << (type & 0x1F);
+} // typeBit
+
+/**
+ * @brief Parse the payload and rebuild the table.
+ * @param [in] data The advertisement payload.
+ * @param [in] length The length of the payload.
+ * @details Parsing stops at the first AD structure that runs past the end of the payload, like the
+ * byte walk the table replaces. Zero length structures (padding) are skipped.
+ */
+void NimBLEAdvFieldIndex::build(const uint8_t* data, size_t length) {
+    m_fields.clear();
+    m_typeMask = 0;
+
+    size_t pos = 0;
+    while (length - pos > 2) {
+        const uint8_t fieldLength = data[pos];
+        if (fieldLength >= length - pos) {
+            break;
+        }
+
+        if (fieldLength > 0) {
+            const uint8_t type = data[pos + 1];
+            m_fields.push_back(Field{static_cast<uint16_t>(pos), fieldLength, type});
+            m_typeMask |= typeBit(type);
+        }
+
+        pos += 1 + fieldLength;
+    }
+} // build
+
+/**
+ * @brief Remove all fields, keeping the allocated table.
+ */
+void NimBLEAdvFieldIndex::clear() {
+    m_fields.clear();
+    m_typeMask = 0;
+} // clear
+
+/**
+ * @brief Reserve table space for the given number of fields so that build() does not allocate.
+ */
+void NimBLEAdvFieldIndex::reserve(size_t count) {
+    m_fields.reserve(count);
+} // reserve
+
+/**
+ * @brief Quick check if the payload may contain a type.
+ * @return False if the type is certainly not present, true if it may be.
+ */
+bool NimBLEAdvFieldIndex::mayContain(uint8_t type) const {
+    return (m_typeMask & typeBit(type)) != 0;
+} // mayContain
+
+/**
+ * @brief Find an AD structure by type.
+ * @param [in] type The AD type.
+ * @param [in] index Which of several structures of this type to return.
+ * @return The field or nullptr if not present.
+ */
+const NimBLEAdvFieldIndex::Field* NimBLEAdvFieldIndex::find(uint8_t type, uint8_t index) const {
+    if (!mayContain(type)) {
+        return nullptr;
+    }
+
+    for (const auto& field : m_fields) {
+        if (field.type == type && index-- == 0) {
+            return &field;
+        }
+    }
+
+    return nullptr;
+} // find
+
+/**
+ * @brief Get the number of AD structures of a type.
+ */
+uint8_t NimBLEAdvFieldIndex::count(uint8_t type) const {
+    if (!mayContain(type)) {
+        return 0;
+    }
+
+    uint8_t count = 0;
+    for (const auto& field : m_fields) {
+        count += field.type == type;
+    }
+
+    return count;
+} // count
+
+/**
+ * @brief Get the number of AD structures in the payload.
+ */
+size_t NimBLEAdvFieldIndex::size() const {
+    return m_fields.size();
+} // size
+
+const NimBLEAdvFieldIndex::Field* NimBLEAdvFieldIndex::begin() const {
+    return m_fields.data();
+} // begin
+
+const NimBLEAdvFieldIndex::Field* NimBLEAdvFieldIndex::end() const {
+    return m_fields.data() + m_fields.size();
+} // end
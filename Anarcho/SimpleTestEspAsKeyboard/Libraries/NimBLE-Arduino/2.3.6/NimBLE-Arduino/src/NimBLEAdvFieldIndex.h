@@ -0,0 +1,65 @@
+/*
+ * Copyright 2020-2025 Ryan Powell <ryan@nable-embedded.io> and
+ * esp-nimble-cpp, NimBLE-Arduino contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NIMBLE_CPP_ADV_FIELD_INDEX_H_
+#define NIMBLE_CPP_ADV_FIELD_INDEX_H_
+
+/**
+ * This header has no dependency on the NimBLE stack so that it can also be built on a host
+ * for benchmarking (see Src/Tools/NimBLEBench).
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @brief Offset table of the AD structures in an advertisement payload.
+ * @details The payload is walked once when it is set or extended and every well formed AD structure is
+ * recorded with its position, length and type. Lookups then iterate the few table entries instead of
+ * re-parsing the payload bytes, and a presence mask answers most "is this type present" queries without
+ * touching the table at all.
+ */
+class NimBLEAdvFieldIndex {
+  public:
+    /**
+     * @brief One AD structure of the payload.
+     */
+    struct Field {
+        uint16_t offset; // Position of the length byte in the payload.
+        uint8_t  length; // The AD length byte, the type byte plus the data.
+        uint8_t  type;   // The AD type.
+    };
+
+    void         build(const uint8_t* data, size_t length);
+    void         clear();
+    void         reserve(size_t count);
+    bool         mayContain(uint8_t type) const;
+    const Field* find(uint8_t type, uint8_t index = 0) const;
+    uint8_t      count(uint8_t type) const;
+    size_t       size() const;
+    const Field* begin() const;
+    const Field* end() const;
+
+  private:
+    static uint32_t typeBit(uint8_t type);
+
+    std::vector<Field> m_fields{};
+    uint32_t           m_typeMask{0};
+};
+
+#endif // NIMBLE_CPP_ADV_FIELD_INDEX_H_
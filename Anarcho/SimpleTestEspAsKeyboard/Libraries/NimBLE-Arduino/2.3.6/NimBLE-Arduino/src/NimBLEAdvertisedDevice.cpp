@@ -30,29 +30,36 @@ static const char* LOG_TAG = "NimBLEAdvertisedDevice";
  * @brief Constructor
  * @param [in] event The advertisement event data.
  */
-NimBLEAdvertisedDevice::NimBLEAdvertisedDevice(const ble_gap_event* event, uint8_t eventType)
+NimBLEAdvertisedDevice::NimBLEAdvertisedDevice(const ble_gap_event* event, uint8_t eventType) {
+    reset(event, eventType);
+} // NimBLEAdvertisedDevice
+
+/**
+ * @brief Reinitialize the device from a new advertiser's report.
+ * @param [in] event The advertisement event data.
+ * @details Used when a pooled device is recycled, the payload buffer keeps its capacity.
+ */
+void NimBLEAdvertisedDevice::reset(const ble_gap_event* event, uint8_t eventType) {
 # if CONFIG_BT_NIMBLE_EXT_ADV
-    : m_address{event->ext_disc.addr},
-      m_advType{eventType},
-      m_rssi{event->ext_disc.rssi},
-      m_callbackSent{0},
-      m_advLength{event->ext_disc.length_data},
-      m_isLegacyAdv{!!(event->ext_disc.props & BLE_HCI_ADV_LEGACY_MASK)},
-      m_dataStatus{event->ext_disc.data_status},
-      m_sid{event->ext_disc.sid},
-      m_primPhy{event->ext_disc.prim_phy},
-      m_secPhy{event->ext_disc.sec_phy},
-      m_periodicItvl{event->ext_disc.periodic_adv_itvl},
-      m_payload(event->ext_disc.data, event->ext_disc.data + event->ext_disc.length_data) {
+    const auto& disc = event->ext_disc;
+    m_isLegacyAdv    = disc.props & BLE_HCI_ADV_LEGACY_MASK;
+    m_dataStatus     = disc.data_status;
+    m_sid            = disc.sid;
+    m_primPhy        = disc.prim_phy;
+    m_secPhy         = disc.sec_phy;
+    m_periodicItvl   = disc.periodic_adv_itvl;
 # else
-    : m_address{event->disc.addr},
-      m_advType{eventType},
-      m_rssi{event->disc.rssi},
-      m_callbackSent{0},
-      m_advLength{event->disc.length_data},
-      m_payload(event->disc.data, event->disc.data + event->disc.length_data) {
+    const auto& disc = event->disc;
 # endif
-} // NimBLEAdvertisedDevice
+    m_address       = NimBLEAddress(disc.addr);
+    m_advType       = eventType;
+    m_rssi          = disc.rssi;
+    m_callbackSent  = 0;
+    m_filterPending = false;
+    m_advLength     = disc.length_data;
+    m_payload.assign(disc.data, disc.data + disc.length_data);
+    m_fieldIndex.build(m_payload.data(), m_payload.size());
+} // reset
 
 /**
  * @brief Update the advertisement data.
@@ -66,6 +73,7 @@ void NimBLEAdvertisedDevice::update(const ble_gap_event* event, uint8_t eventTyp
         m_payload.insert(m_payload.end(), disc.data, disc.data + disc.length_data);
         m_dataStatus = disc.data_status;
         m_advLength  = m_payload.size();
+        m_fieldIndex.build(m_payload.data(), m_payload.size());
         return;
     }
 
@@ -78,10 +86,12 @@ void NimBLEAdvertisedDevice::update(const ble_gap_event* event, uint8_t eventTyp
     m_rssi = disc.rssi;
     if (eventType == BLE_HCI_ADV_RPT_EVTYPE_SCAN_RSP && isLegacyAdvertisement()) {
         m_payload.insert(m_payload.end(), disc.data, disc.data + disc.length_data);
+        m_fieldIndex.build(m_payload.data(), m_payload.size());
         return;
     }
     m_advLength = disc.length_data;
     m_payload.assign(disc.data, disc.data + disc.length_data);
+    m_fieldIndex.build(m_payload.data(), m_payload.size());
     m_callbackSent = 0; // new data, reset callback sent flag
 } // update
 
@@ -460,12 +470,13 @@ NimBLEUUID NimBLEAdvertisedDevice::getServiceUUID(uint8_t index) const {
  * @return The count of services in the advertising packet.
  */
 uint8_t NimBLEAdvertisedDevice::getServiceUUIDCount() const {
-    uint8_t count  = findAdvField(BLE_HS_ADV_TYPE_INCOMP_UUIDS16);
-    count         += findAdvField(BLE_HS_ADV_TYPE_COMP_UUIDS16);
-    count         += findAdvField(BLE_HS_ADV_TYPE_INCOMP_UUIDS32);
-    count         += findAdvField(BLE_HS_ADV_TYPE_COMP_UUIDS32);
-    count         += findAdvField(BLE_HS_ADV_TYPE_INCOMP_UUIDS128);
-    count         += findAdvField(BLE_HS_ADV_TYPE_COMP_UUIDS128);
+    uint8_t count = 0;
+    for (const auto& field : m_fieldIndex) {
+        const uint8_t uuid_bytes = uuidListBytes(field.type);
+        if (uuid_bytes > 0) {
+            count += field.length / uuid_bytes;
+        }
+    }
 
     return count;
 } // getServiceUUIDCount
@@ -476,16 +487,46 @@ uint8_t NimBLEAdvertisedDevice::getServiceUUIDCount() const {
  * @return Return true if service is advertised
  */
 bool NimBLEAdvertisedDevice::isAdvertisingService(const NimBLEUUID& uuid) const {
-    size_t count = getServiceUUIDCount();
-    for (size_t i = 0; i < count; i++) {
-        if (uuid == getServiceUUID(i)) {
-            return true;
+    const NimBLEConstUUID wanted(uuid);
+    for (const auto& field : m_fieldIndex) {
+        const uint8_t uuid_bytes = uuidListBytes(field.type);
+        if (uuid_bytes == 0) {
+            continue;
+        }
+
+        const uint8_t* value = &m_payload[field.offset + 2];
+        const uint8_t  count = (field.length - 1) / uuid_bytes;
+        for (uint8_t i = 0; i < count; i++) {
+            if (NimBLEConstUUID::fromBytes(value + i * uuid_bytes, uuid_bytes) == wanted) {
+                return true;
+            }
         }
     }
 
     return false;
 } // isAdvertisingService
 
+/**
+ * @brief Get the size of the UUIDs in a service UUID list AD type.
+ * @param [in] type The AD type.
+ * @return 2, 4 or 16, or 0 if the type is not a service UUID list.
+ */
+uint8_t NimBLEAdvertisedDevice::uuidListBytes(uint8_t type) {
+    switch (type) {
+        case BLE_HS_ADV_TYPE_INCOMP_UUIDS16:
+        case BLE_HS_ADV_TYPE_COMP_UUIDS16:
+            return 2;
+        case BLE_HS_ADV_TYPE_INCOMP_UUIDS32:
+        case BLE_HS_ADV_TYPE_COMP_UUIDS32:
+            return 4;
+        case BLE_HS_ADV_TYPE_INCOMP_UUIDS128:
+        case BLE_HS_ADV_TYPE_COMP_UUIDS128:
+            return 16;
+        default:
+            return 0;
+    }
+} // uuidListBytes
+
 /**
  * @brief Get the TX Power.
  * @return The TX Power of the advertised device.
@@ -641,42 +682,49 @@ uint8_t NimBLEAdvertisedDevice::getDataStatus() const {
 } // getDataStatus
 # endif
 
+/**
+ * @brief Find an AD structure in the payload using the field index.
+ * @param [in] type The AD type, BLE_HS_ADV_TYPE_COMP_NAME also matches an incomplete name.
+ * @param [in] index The index of the item to find, UUID and target address lists count per item.
+ * @param [out] data_loc If not nullptr, receives the payload offset of the structure holding the item.
+ * @return The number of items of this type found, up to and including the requested one if data_loc is set.
+ */
 uint8_t NimBLEAdvertisedDevice::findAdvField(uint8_t type, uint8_t index, size_t* data_loc) const {
-    size_t  length = m_payload.size();
-    size_t  data   = 0;
-    uint8_t count  = 0;
-
-    while (length > 2) {
-        const ble_hs_adv_field* field = reinterpret_cast<const ble_hs_adv_field*>(&m_payload[data]);
-        if (field->length >= length) {
-            return count;
-        }
+    if (!m_fieldIndex.mayContain(type) &&
+        !(type == BLE_HS_ADV_TYPE_COMP_NAME && m_fieldIndex.mayContain(BLE_HS_ADV_TYPE_INCOMP_NAME))) {
+        return 0;
+    }
+
+    size_t  data  = 0;
+    uint8_t count = 0;
 
-        if (field->type == type || (type == BLE_HS_ADV_TYPE_COMP_NAME && field->type == BLE_HS_ADV_TYPE_INCOMP_NAME)) {
+    for (const auto& field : m_fieldIndex) {
+        data = field.offset;
+        if (field.type == type || (type == BLE_HS_ADV_TYPE_COMP_NAME && field.type == BLE_HS_ADV_TYPE_INCOMP_NAME)) {
             switch (type) {
                 case BLE_HS_ADV_TYPE_INCOMP_UUIDS16:
                 case BLE_HS_ADV_TYPE_COMP_UUIDS16:
-                    count += field->length / 2;
+                    count += field.length / 2;
                     break;
 
                 case BLE_HS_ADV_TYPE_INCOMP_UUIDS32:
                 case BLE_HS_ADV_TYPE_COMP_UUIDS32:
-                    count += field->length / 4;
+                    count += field.length / 4;
                     break;
 
                 case BLE_HS_ADV_TYPE_INCOMP_UUIDS128:
                 case BLE_HS_ADV_TYPE_COMP_UUIDS128:
-                    count += field->length / 16;
+                    count += field.length / 16;
                     break;
 
                 case BLE_HS_ADV_TYPE_PUBLIC_TGT_ADDR:
                 case BLE_HS_ADV_TYPE_RANDOM_TGT_ADDR:
-                    count += field->length / 6;
+                    count += field.length / 6;
                     break;
 
                 case BLE_HS_ADV_TYPE_COMP_NAME:
                     // keep looking for complete name, else use this
-                    if (data_loc != nullptr && field->type == BLE_HS_ADV_TYPE_INCOMP_NAME) {
+                    if (data_loc != nullptr && field.type == BLE_HS_ADV_TYPE_INCOMP_NAME) {
                         *data_loc = data;
                         index++;
                     }
@@ -692,9 +740,6 @@ uint8_t NimBLEAdvertisedDevice::findAdvField(uint8_t type, uint8_t index, size_t
                 }
             }
         }
-
-        length -= 1 + field->length;
-        data   += 1 + field->length;
     }
 
     if (data_loc != nullptr && count > index) {
@@ -22,6 +22,7 @@
 #if CONFIG_BT_ENABLED && CONFIG_BT_NIMBLE_ROLE_OBSERVER
 
 # include "NimBLEAddress.h"
+# include "NimBLEAdvFieldIndex.h"
 # include "NimBLEScan.h"
 # include "NimBLEUUID.h"
 
@@ -152,16 +153,20 @@ class NimBLEAdvertisedDevice {
 
   private:
     friend class NimBLEScan;
+    friend class NimBLEAdvertisedDevicePool;
 
     NimBLEAdvertisedDevice(const ble_gap_event* event, uint8_t eventType);
+    void    reset(const ble_gap_event* event, uint8_t eventType);
     void    update(const ble_gap_event* event, uint8_t eventType);
     uint8_t findAdvField(uint8_t type, uint8_t index = 0, size_t* data_loc = nullptr) const;
     size_t  findServiceData(uint8_t index, uint8_t* bytes) const;
+    static uint8_t uuidListBytes(uint8_t type);
 
     NimBLEAddress m_address{};
     uint8_t       m_advType{};
     int8_t        m_rssi{};
     uint8_t       m_callbackSent{};
+    bool          m_filterPending{};
     uint16_t      m_advLength{};
 
 # if CONFIG_BT_NIMBLE_EXT_ADV
@@ -174,6 +179,7 @@ class NimBLEAdvertisedDevice {
 # endif
 
     std::vector<uint8_t> m_payload;
+    NimBLEAdvFieldIndex  m_fieldIndex;
 };
 
 #endif /* CONFIG_BT_ENABLED && CONFIG_BT_NIMBLE_ROLE_OBSERVER */
@@ -0,0 +1,189 @@
+/*
+ * Copyright 2020-2025 Ryan Powell <ryan@nable-embedded.io> and
+ * esp-nimble-cpp, NimBLE-Arduino contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NimBLEAdvertisedDevicePool.h"
+#if CONFIG_BT_ENABLED && CONFIG_BT_NIMBLE_ROLE_OBSERVER
+
+# include "NimBLEAdvertisedDevice.h"
+# include "NimBLELog.h"
+
+static const char* LOG_TAG = "NimBLEAdvertisedDevicePool";
+
+// AD structures per device kept allocated in the field index, enough for typical advertisements.
+static const size_t FIELD_RESERVE = 16;
+
+/**
+ * @brief Pool destructor, frees all preallocated devices.
+ * @note Devices still handed out become invalid, the scan returns all of them before destroying the pool.
+ */
+NimBLEAdvertisedDevicePool::~NimBLEAdvertisedDevicePool() {
+    freeBlocks();
+} // ~NimBLEAdvertisedDevicePool
+
+/**
+ * @brief Size the pool for the given number of devices.
+ * @param [in] count The number of devices the pool should hold.
+ * @details While devices are handed out the pool can only grow, a new block is added so that the
+ * devices in use keep their address. When all devices are free the pool is rebuilt to the exact size.
+ */
+void NimBLEAdvertisedDevicePool::reserve(uint16_t count) {
+    if (m_stats.inUse == 0 && m_stats.capacity != count) {
+        freeBlocks();
+    }
+
+    if (count <= m_stats.capacity) {
+        return;
+    }
+
+    const uint16_t          add     = count - m_stats.capacity;
+    NimBLEAdvertisedDevice* devices = new NimBLEAdvertisedDevice[add];
+    for (uint16_t i = 0; i < add; i++) {
+        devices[i].m_payload.reserve(PAYLOAD_RESERVE);
+        devices[i].m_fieldIndex.reserve(FIELD_RESERVE);
+    }
+
+    // Reserve the free list in advance too, release() must not allocate.
+    std::vector<NimBLEAdvertisedDevice*> free{};
+    free.reserve(count);
+
+    ble_npl_hw_enter_critical();
+    free.insert(free.end(), m_free.begin(), m_free.end());
+    for (uint16_t i = 0; i < add; i++) {
+        free.push_back(&devices[i]);
+    }
+    m_free.swap(free);
+    m_blocks.push_back(Block{devices, add});
+    m_stats.capacity = count;
+    ble_npl_hw_exit_critical(0);
+
+    NIMBLE_LOGD(LOG_TAG, "Pool sized for %u devices", count);
+} // reserve
+
+/**
+ * @brief Get a device initialized from an advertising report.
+ * @param [in] event The advertisement event data.
+ * @param [in] eventType The advertising event type.
+ * @return A pooled device, or a heap allocated one if the pool is empty.
+ */
+NimBLEAdvertisedDevice* NimBLEAdvertisedDevicePool::acquire(const ble_gap_event* event, uint8_t eventType) {
+    NimBLEAdvertisedDevice* pDevice = nullptr;
+
+    ble_npl_hw_enter_critical();
+    if (!m_free.empty()) {
+        pDevice = m_free.back();
+        m_free.pop_back();
+        if (++m_stats.inUse > m_stats.highWater) {
+            m_stats.highWater = m_stats.inUse;
+        }
+    } else {
+        m_stats.exhausted++;
+        m_stats.heapInUse++;
+    }
+    ble_npl_hw_exit_critical(0);
+
+    if (pDevice == nullptr) {
+        return new NimBLEAdvertisedDevice(event, eventType);
+    }
+
+    pDevice->reset(event, eventType);
+    if (pDevice->m_payload.capacity() > PAYLOAD_RESERVE) {
+        m_stats.payloadFallbacks++;
+    }
+
+    return pDevice;
+} // acquire
+
+/**
+ * @brief Apply a further advertising report to a device, counting payloads that outgrow the reserved buffer.
+ * @param [in] pDevice The device to update.
+ * @param [in] event The advertisement event data.
+ * @param [in] eventType The advertising event type.
+ */
+void NimBLEAdvertisedDevicePool::update(NimBLEAdvertisedDevice* pDevice, const ble_gap_event* event, uint8_t eventType) {
+    const size_t capacity = pDevice->m_payload.capacity();
+    pDevice->update(event, eventType);
+    if (pDevice->m_payload.capacity() > capacity && capacity >= PAYLOAD_RESERVE) {
+        m_stats.payloadFallbacks++;
+    }
+} // update
+
+/**
+ * @brief Return a device to the pool.
+ * @param [in] pDevice The device, heap allocated devices are deleted.
+ * @details A payload buffer that grew beyond the reserved size is given back to the heap so that the
+ * pool footprint stays fixed.
+ */
+void NimBLEAdvertisedDevicePool::release(NimBLEAdvertisedDevice* pDevice) {
+    if (!owns(pDevice)) {
+        ble_npl_hw_enter_critical();
+        m_stats.heapInUse--;
+        ble_npl_hw_exit_critical(0);
+        delete pDevice;
+        return;
+    }
+
+    if (pDevice->m_payload.capacity() > PAYLOAD_RESERVE) {
+        std::vector<uint8_t>().swap(pDevice->m_payload);
+        pDevice->m_payload.reserve(PAYLOAD_RESERVE);
+    }
+
+    ble_npl_hw_enter_critical();
+    m_free.push_back(pDevice);
+    m_stats.inUse--;
+    ble_npl_hw_exit_critical(0);
+} // release
+
+/**
+ * @brief Get the pool usage statistics.
+ */
+NimBLEAdvertisedDevicePool::Stats NimBLEAdvertisedDevicePool::getStats() const {
+    return m_stats;
+} // getStats
+
+/**
+ * @brief Reset the high water mark and the exhaustion counters.
+ */
+void NimBLEAdvertisedDevicePool::resetStats() {
+    m_stats.highWater        = m_stats.inUse;
+    m_stats.exhausted        = 0;
+    m_stats.payloadFallbacks = 0;
+} // resetStats
+
+/**
+ * @brief Check if a device belongs to one of the preallocated blocks.
+ */
+bool NimBLEAdvertisedDevicePool::owns(const NimBLEAdvertisedDevice* pDevice) const {
+    for (const auto& block : m_blocks) {
+        if (pDevice >= block.devices && pDevice < block.devices + block.count) {
+            return true;
+        }
+    }
+
+    return false;
+} // owns
+
+void NimBLEAdvertisedDevicePool::freeBlocks() {
+    for (const auto& block : m_blocks) {
+        delete[] block.devices;
+    }
+
+    m_blocks.clear();
+    m_free.clear();
+    m_stats.capacity = 0;
+} // freeBlocks
+
+#endif /* CONFIG_BT_ENABLED && CONFIG_BT_NIMBLE_ROLE_OBSERVER */
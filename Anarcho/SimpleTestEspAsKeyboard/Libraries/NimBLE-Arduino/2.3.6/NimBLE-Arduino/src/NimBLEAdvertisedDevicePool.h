@@ -0,0 +1,92 @@
+/*
+ * Copyright 2020-2025 Ryan Powell <ryan@nable-embedded.io> and
+ * esp-nimble-cpp, NimBLE-Arduino contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NIMBLE_CPP_ADVERTISED_DEVICE_POOL_H_
+#define NIMBLE_CPP_ADVERTISED_DEVICE_POOL_H_
+
+#include "nimconfig.h"
+#if CONFIG_BT_ENABLED && CONFIG_BT_NIMBLE_ROLE_OBSERVER
+
+# if defined(CONFIG_NIMBLE_CPP_IDF)
+#  include "host/ble_hs_adv.h"
+#  include "host/ble_gap.h"
+# else
+#  include "nimble/nimble/host/include/host/ble_hs_adv.h"
+#  include "nimble/nimble/host/include/host/ble_gap.h"
+# endif
+
+# include <vector>
+
+class NimBLEAdvertisedDevice;
+
+/**
+ * @brief Fixed capacity pool of advertised devices used by the scan.
+ * @details Devices are allocated in blocks when the pool is sized and are recycled afterwards, each
+ * one keeping a payload buffer reserved for a full legacy advertisement plus scan response, or for a
+ * full extended advertising report when extended advertising is enabled. A scan that stays within
+ * the pool capacity therefore does not touch the heap. When the pool is empty, or a fragmented
+ * extended advertisement outgrows the reserved buffer, the heap is used as a fallback and counted
+ * in the statistics.
+ */
+class NimBLEAdvertisedDevicePool {
+  public:
+# if CONFIG_BT_NIMBLE_EXT_ADV
+    static constexpr size_t PAYLOAD_RESERVE = 255;
+# else
+    static constexpr size_t PAYLOAD_RESERVE = 2 * BLE_HS_ADV_MAX_SZ;
+# endif
+
+    /**
+     * @brief Pool usage statistics.
+     */
+    struct Stats {
+        uint16_t capacity;         // Number of preallocated devices.
+        uint16_t inUse;            // Preallocated devices currently handed out.
+        uint16_t highWater;        // Largest value of inUse since the last resetStats().
+        uint16_t heapInUse;        // Devices allocated from the heap because the pool was empty.
+        uint32_t exhausted;        // Number of times the pool was empty when a device was needed.
+        uint32_t payloadFallbacks; // Number of times a payload outgrew the reserved buffer.
+    };
+
+    NimBLEAdvertisedDevicePool() = default;
+    ~NimBLEAdvertisedDevicePool();
+    NimBLEAdvertisedDevicePool(const NimBLEAdvertisedDevicePool&)            = delete;
+    NimBLEAdvertisedDevicePool& operator=(const NimBLEAdvertisedDevicePool&) = delete;
+
+    void                    reserve(uint16_t count);
+    NimBLEAdvertisedDevice* acquire(const ble_gap_event* event, uint8_t eventType);
+    void                    update(NimBLEAdvertisedDevice* pDevice, const ble_gap_event* event, uint8_t eventType);
+    void                    release(NimBLEAdvertisedDevice* pDevice);
+    Stats                   getStats() const;
+    void                    resetStats();
+
+  private:
+    struct Block {
+        NimBLEAdvertisedDevice* devices;
+        uint16_t                count;
+    };
+
+    bool owns(const NimBLEAdvertisedDevice* pDevice) const;
+    void freeBlocks();
+
+    std::vector<Block>                   m_blocks{};
+    std::vector<NimBLEAdvertisedDevice*> m_free{};
+    Stats                                m_stats{};
+};
+
+#endif /* CONFIG_BT_ENABLED && CONFIG_BT_NIMBLE_ROLE_OBSERVER */
+#endif /* NIMBLE_CPP_ADVERTISED_DEVICE_POOL_H_ */
@@ -339,6 +339,26 @@ bool NimBLEAdvertising::setAdvertisementData(const NimBLEAdvertisementData& data
     return true;
 } // setAdvertisementData
 
+/**
+ * @brief Set the advertisement data from a raw payload.
+ * @param [in] data The payload, a sequence of length, type and data fields.
+ * @param [in] length The length of the payload, at most BLE_HS_ADV_MAX_SZ.
+ * @return True if the data was set successfully.
+ * @details Used to update payloads that are patched in place, the payload is copied into the
+ * member object without reallocating once it has reached its size.
+ */
+bool NimBLEAdvertising::setAdvertisementData(const uint8_t* data, size_t length) {
+    int rc = ble_gap_adv_set_data(data, length);
+    if (rc != 0) {
+        NIMBLE_LOGE(LOG_TAG, "ble_gap_adv_set_data: %d %s", rc, NimBLEUtils::returnCodeToString(rc));
+        return false;
+    }
+
+    m_advData.m_payload.assign(data, data + length);
+    m_advDataSet = true;
+    return true;
+} // setAdvertisementData
+
 /**
  * @brief Get the current advertisement data.
  * @returns a reference to the current advertisement data.
@@ -366,6 +386,23 @@ bool NimBLEAdvertising::setScanResponseData(const NimBLEAdvertisementData& data)
     return true;
 } // setScanResponseData
 
+/**
+ * @brief Set the scan response data from a raw payload.
+ * @param [in] data The payload, a sequence of length, type and data fields.
+ * @param [in] length The length of the payload, at most BLE_HS_ADV_MAX_SZ.
+ * @return True if the data was set successfully.
+ */
+bool NimBLEAdvertising::setScanResponseData(const uint8_t* data, size_t length) {
+    int rc = ble_gap_adv_rsp_set_data(data, length);
+    if (rc != 0) {
+        NIMBLE_LOGE(LOG_TAG, "ble_gap_adv_rsp_set_data: %d %s", rc, NimBLEUtils::returnCodeToString(rc));
+        return false;
+    }
+
+    m_scanData.m_payload.assign(data, data + length);
+    return true;
+} // setScanResponseData
+
 /**
  * @brief Get the current scan response data.
  * @returns a reference to the current scan response data.
@@ -35,6 +35,7 @@
 # include "NimBLEUUID.h"
 # include "NimBLEAddress.h"
 # include "NimBLEAdvertisementData.h"
+# include "NimBLEConstAdvData.h"
 
 # include <functional>
 # include <string>
@@ -66,6 +67,8 @@ class NimBLEAdvertising {
 
     bool                           setAdvertisementData(const NimBLEAdvertisementData& advertisementData);
     bool                           setScanResponseData(const NimBLEAdvertisementData& advertisementData);
+    bool                           setAdvertisementData(const uint8_t* data, size_t length);
+    bool                           setScanResponseData(const uint8_t* data, size_t length);
     const NimBLEAdvertisementData& getAdvertisementData();
     const NimBLEAdvertisementData& getScanData();
     void                           clearData();
@@ -88,6 +91,26 @@ class NimBLEAdvertising {
     bool setServiceData(const NimBLEUUID& uuid, const std::string& data);
     bool setServiceData(const NimBLEUUID& uuid, const std::vector<uint8_t>& data);
 
+    /**
+     * @brief Set the advertisement data from a payload built at compile time.
+     * @param [in] data The payload, see NimBLEConstAdvData.
+     * @return True if the data was set successfully.
+     */
+    template <size_t N>
+    bool setAdvertisementData(const NimBLEConstAdvData<N>& data) {
+        return setAdvertisementData(data.data(), data.size());
+    }
+
+    /**
+     * @brief Set the scan response data from a payload built at compile time.
+     * @param [in] data The payload, see NimBLEConstAdvData.
+     * @return True if the data was set successfully.
+     */
+    template <size_t N>
+    bool setScanResponseData(const NimBLEConstAdvData<N>& data) {
+        return setScanResponseData(data.data(), data.size());
+    }
+
   private:
     friend class NimBLEDevice;
     friend class NimBLEServer;
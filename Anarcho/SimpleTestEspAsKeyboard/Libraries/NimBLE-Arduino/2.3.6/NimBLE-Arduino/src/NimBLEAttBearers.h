@@ -0,0 +1,158 @@
+/*
+ * Copyright 2020-2025 Ryan Powell <ryan@nable-embedded.io> and
+ * esp-nimble-cpp, NimBLE-Arduino contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NIMBLE_CPP_ATT_BEARERS_H_
+#define NIMBLE_CPP_ATT_BEARERS_H_
+
+/**
+ * This header has no dependency on the NimBLE stack so that it can also be built on a host
+ * for benchmarking (see Src/Tools/NimBLEBench).
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Statistics of the GATT requests of a connection.
+ * @details The host picks the ATT bearer of each request and does not report it back, so the requests are
+ * counted per connection. More than one request in flight at a time is only possible with EATT bearers.
+ */
+struct NimBLEGattRequestStats {
+    uint8_t  inFlight;    // Requests currently outstanding.
+    uint8_t  maxInFlight; // Most requests outstanding at the same time.
+    uint32_t requests;    // Requests started.
+    uint32_t errors;      // Requests that completed with an error.
+    uint32_t bytes;       // Attribute value bytes read or written.
+    uint32_t busyMs;      // Time from sending the requests to their completion, summed.
+};
+
+/**
+ * @brief The ATT bearers of a connection and the statistics of its GATT requests.
+ * @details The unenhanced ATT bearer always exists, Enhanced ATT (EATT) bearers are added as their L2CAP
+ * channels connect. An ATT bearer carries one request at a time, so the number of bearers is the number of
+ * requests worth keeping in flight. Which bearer a request takes is left to the host.\n
+ * No locking is done, the owner serializes access.
+ * @tparam N The maximum number of bearers, 1 + CONFIG_BT_NIMBLE_EATT_CHAN_NUM.
+ */
+template <size_t N>
+class NimBLEAttBearers {
+  public:
+    /** L2CAP channel ID of the unenhanced ATT bearer. */
+    static constexpr uint16_t ATT_CID = 0x0004;
+
+    NimBLEAttBearers() { reset(); }
+
+    /**
+     * @brief Remove the enhanced bearers and clear the statistics, for a new connection.
+     */
+    void reset() {
+        m_cids[0] = ATT_CID;
+        m_count   = 1;
+        m_stats   = NimBLEGattRequestStats{};
+    }
+
+    /**
+     * @brief Add an enhanced bearer.
+     * @param [in] cid The L2CAP channel ID of the bearer.
+     * @return False if the table is full.
+     */
+    bool add(uint16_t cid) {
+        for (size_t i = 0; i < m_count; i++) {
+            if (m_cids[i] == cid) {
+                return true;
+            }
+        }
+        if (m_count >= N) {
+            return false;
+        }
+
+        m_cids[m_count++] = cid;
+        return true;
+    }
+
+    /**
+     * @brief Remove an enhanced bearer.
+     * @param [in] cid The L2CAP channel ID of the bearer.
+     */
+    void remove(uint16_t cid) {
+        for (size_t i = 1; i < m_count; i++) {
+            if (m_cids[i] == cid) {
+                m_cids[i] = m_cids[--m_count];
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Count a request that is about to be sent.
+     */
+    void start() {
+        m_stats.inFlight++;
+        m_stats.requests++;
+        if (m_stats.inFlight > m_stats.maxInFlight) {
+            m_stats.maxInFlight = m_stats.inFlight;
+        }
+    }
+
+    /**
+     * @brief Record the completion of a request counted with start().
+     * @param [in] error True if the request failed.
+     * @param [in] bytes The number of value bytes transferred.
+     * @param [in] elapsedMs The time from sending the request to its completion.
+     */
+    void finish(bool error, size_t bytes, uint32_t elapsedMs) {
+        if (m_stats.inFlight > 0) {
+            m_stats.inFlight--;
+        }
+        m_stats.errors += error ? 1 : 0;
+        m_stats.bytes  += static_cast<uint32_t>(bytes);
+        m_stats.busyMs += elapsedMs;
+    }
+
+    /**
+     * @brief Clear the statistics, keeping the requests in flight.
+     */
+    void clearStats() {
+        m_stats.maxInFlight = m_stats.inFlight;
+        m_stats.requests    = 0;
+        m_stats.errors      = 0;
+        m_stats.bytes       = 0;
+        m_stats.busyMs      = 0;
+    }
+
+    /**
+     * @brief Get the number of bearers, including the unenhanced one.
+     */
+    size_t size() const { return m_count; }
+
+    /**
+     * @brief Get the L2CAP channel ID of a bearer, index 0 is the unenhanced bearer.
+     */
+    uint16_t operator[](size_t index) const { return m_cids[index]; }
+
+    /**
+     * @brief Get the statistics of the requests.
+     */
+    const NimBLEGattRequestStats& stats() const { return m_stats; }
+
+  private:
+    uint16_t               m_cids[N];
+    size_t                 m_count;
+    NimBLEGattRequestStats m_stats;
+};
+
+#endif // NIMBLE_CPP_ATT_BEARERS_H_
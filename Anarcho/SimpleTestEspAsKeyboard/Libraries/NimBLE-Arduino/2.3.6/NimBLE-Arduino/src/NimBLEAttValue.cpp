@@ -27,27 +27,36 @@
 # include "NimBLELog.h"
 
 static const char* LOG_TAG = "NimBLEAttValue";
+static uint32_t    heapAllocCount;
 
 // Default constructor implementation.
 NimBLEAttValue::NimBLEAttValue(uint16_t init_len, uint16_t max_len)
-    : m_attr_value{static_cast<uint8_t*>(calloc(init_len + 1, 1))},
-      m_attr_max_len{std::min<uint16_t>(BLE_ATT_ATTR_MAX_LEN, max_len)},
-      m_attr_len{},
-      m_capacity{init_len}
+    : m_attr_max_len{std::min<uint16_t>(BLE_ATT_ATTR_MAX_LEN, max_len)},
+      m_attr_len{}
 # if CONFIG_NIMBLE_CPP_ATT_VALUE_TIMESTAMP_ENABLED
       ,
       m_timestamp{}
 # endif
 {
-    NIMBLE_CPP_DEBUG_ASSERT(m_attr_value);
-    if (m_attr_value == nullptr) {
+    if (init_len <= CONFIG_NIMBLE_CPP_ATT_VALUE_INLINE_LENGTH) {
+        return;
+    }
+
+    uint8_t* res = static_cast<uint8_t*>(calloc(init_len + 1, 1));
+    NIMBLE_CPP_DEBUG_ASSERT(res);
+    if (res == nullptr) {
         NIMBLE_LOGE(LOG_TAG, "Failed to calloc ctx");
+        return;
     }
+
+    heapAllocCount++;
+    m_attr_value = res;
+    m_capacity   = init_len;
 }
 
 // Value constructor implementation.
 NimBLEAttValue::NimBLEAttValue(const uint8_t* value, uint16_t len, uint16_t max_len) : NimBLEAttValue(len, max_len) {
-    if (m_attr_value != nullptr) {
+    if (len <= m_capacity) {
         memcpy(m_attr_value, value, len);
         m_attr_len = len;
     }
@@ -55,7 +64,7 @@ NimBLEAttValue::NimBLEAttValue(const uint8_t* value, uint16_t len, uint16_t max_
 
 // Destructor implementation.
 NimBLEAttValue::~NimBLEAttValue() {
-    if (m_attr_value != nullptr) {
+    if (!isInline()) {
         free(m_attr_value);
     }
 }
@@ -63,13 +72,27 @@ NimBLEAttValue::~NimBLEAttValue() {
 // Move assignment operator implementation.
 NimBLEAttValue& NimBLEAttValue::operator=(NimBLEAttValue&& source) {
     if (this != &source) {
-        free(m_attr_value);
-        m_attr_value   = source.m_attr_value;
+        if (!isInline()) {
+            free(m_attr_value);
+        }
+
+        if (source.isInline()) {
+            // Inline storage cannot be taken over, copy the bytes instead.
+            m_attr_value = m_inline;
+            m_capacity   = CONFIG_NIMBLE_CPP_ATT_VALUE_INLINE_LENGTH;
+            memcpy(m_inline, source.m_inline, source.m_attr_len + 1);
+        } else {
+            m_attr_value        = source.m_attr_value;
+            m_capacity          = source.m_capacity;
+            source.m_attr_value = source.m_inline;
+            source.m_capacity   = CONFIG_NIMBLE_CPP_ATT_VALUE_INLINE_LENGTH;
+        }
+
         m_attr_max_len = source.m_attr_max_len;
         m_attr_len     = source.m_attr_len;
-        m_capacity     = source.m_capacity;
         setTimeStamp(source.getTimeStamp());
-        source.m_attr_value = nullptr;
+        source.m_attr_len  = 0;
+        source.m_inline[0] = '\0';
     }
 
     return *this;
@@ -83,20 +106,46 @@ NimBLEAttValue& NimBLEAttValue::operator=(const NimBLEAttValue& source) {
     return *this;
 }
 
-// Copy all the data from the source object to this object, including allocated space.
+// Get a buffer for capacity bytes plus the null terminator holding the current value.
+// The current buffer is not replaced, the caller does that so it can be done in a critical section.
+uint8_t* NimBLEAttValue::grow(uint16_t capacity) {
+    uint8_t* res;
+    if (isInline()) {
+        res = static_cast<uint8_t*>(malloc(capacity + 1));
+        if (res != nullptr) {
+            memcpy(res, m_inline, m_attr_len + 1);
+        }
+    } else {
+        res = static_cast<uint8_t*>(realloc(m_attr_value, capacity + 1));
+    }
+
+    if (res != nullptr) {
+        heapAllocCount++;
+    }
+
+    return res;
+}
+
+// Copy all the data from the source object to this object, allocating only if it does not fit.
+// The buffer grows to the source length, not to the source capacity.
 void NimBLEAttValue::deepCopy(const NimBLEAttValue& source) {
-    uint8_t* res = static_cast<uint8_t*>(realloc(m_attr_value, source.m_capacity + 1));
-    NIMBLE_CPP_DEBUG_ASSERT(res);
-    if (res == nullptr) {
-        NIMBLE_LOGE(LOG_TAG, "Failed to realloc deepCopy");
-        return;
+    uint8_t* res      = m_attr_value;
+    uint16_t capacity = m_capacity;
+    if (source.m_attr_len > m_capacity) {
+        capacity = source.m_attr_len;
+        res      = grow(capacity);
+        NIMBLE_CPP_DEBUG_ASSERT(res);
+        if (res == nullptr) {
+            NIMBLE_LOGE(LOG_TAG, "Failed to realloc deepCopy");
+            return;
+        }
     }
 
     ble_npl_hw_enter_critical();
     m_attr_value   = res;
     m_attr_max_len = source.m_attr_max_len;
     m_attr_len     = source.m_attr_len;
-    m_capacity     = source.m_capacity;
+    m_capacity     = capacity;
     setTimeStamp(source.getTimeStamp());
     memcpy(m_attr_value, source.m_attr_value, m_attr_len + 1);
     ble_npl_hw_exit_critical(0);
@@ -124,14 +173,14 @@ NimBLEAttValue& NimBLEAttValue::append(const uint8_t* value, uint16_t len) {
     uint8_t* res     = m_attr_value;
     uint16_t new_len = m_attr_len + len;
     if (new_len > m_capacity) {
-        res        = static_cast<uint8_t*>(realloc(m_attr_value, (new_len + 1)));
+        res = grow(new_len);
+        NIMBLE_CPP_DEBUG_ASSERT(res);
+        if (res == nullptr) {
+            NIMBLE_LOGE(LOG_TAG, "Failed to realloc append");
+            return *this;
+        }
         m_capacity = new_len;
     }
-    NIMBLE_CPP_DEBUG_ASSERT(res);
-    if (res == nullptr) {
-        NIMBLE_LOGE(LOG_TAG, "Failed to realloc append");
-        return *this;
-    }
 
 # if CONFIG_NIMBLE_CPP_ATT_VALUE_TIMESTAMP_ENABLED
     time_t t = time(nullptr);
@@ -150,6 +199,16 @@ NimBLEAttValue& NimBLEAttValue::append(const uint8_t* value, uint16_t len) {
     return *this;
 }
 
+// Get the number of heap allocations made by all attribute values.
+uint32_t NimBLEAttValue::getHeapAllocCount() {
+    return heapAllocCount;
+}
+
+// Reset the heap allocation counter.
+void NimBLEAttValue::resetHeapAllocCount() {
+    heapAllocCount = 0;
+}
+
 uint8_t NimBLEAttValue::operator[](int pos) const {
     NIMBLE_CPP_DEBUG_ASSERT(pos < m_attr_len);
     if (pos >= m_attr_len) {
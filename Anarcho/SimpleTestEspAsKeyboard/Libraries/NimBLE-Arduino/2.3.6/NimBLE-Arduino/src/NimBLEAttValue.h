@@ -47,6 +47,14 @@
 #  error CONFIG_NIMBLE_CPP_ATT_VALUE_INIT_LENGTH cannot be less than 1; Range = 1 : 512
 # endif
 
+# if !defined(CONFIG_NIMBLE_CPP_ATT_VALUE_INLINE_LENGTH)
+#  define CONFIG_NIMBLE_CPP_ATT_VALUE_INLINE_LENGTH 20
+# elif CONFIG_NIMBLE_CPP_ATT_VALUE_INLINE_LENGTH > BLE_ATT_ATTR_MAX_LEN
+#  error CONFIG_NIMBLE_CPP_ATT_VALUE_INLINE_LENGTH cannot be larger than 512 (BLE_ATT_ATTR_MAX_LEN)
+# elif CONFIG_NIMBLE_CPP_ATT_VALUE_INLINE_LENGTH < 0
+#  error CONFIG_NIMBLE_CPP_ATT_VALUE_INLINE_LENGTH cannot be less than 0; Range = 0 : 512
+# endif
+
 /* Used to determine if the type passed to a template has a data() and size() method. */
 template <typename T, typename = void, typename = void>
 struct Has_data_size : std::false_type {};
@@ -67,17 +75,23 @@ struct Has_c_str_length<T, decltype(void(std::declval<T&>().c_str())), decltype(
  * @brief A specialized container class to hold BLE attribute values.
  * @details This class is designed to be more memory efficient than using\n
  * standard container types for value storage, while being convertible to\n
- * many different container classes.
+ * many different container classes.\n
+ * Values up to CONFIG_NIMBLE_CPP_ATT_VALUE_INLINE_LENGTH bytes are stored inside the object,\n
+ * the heap is only used for longer values.
  */
 class NimBLEAttValue {
-    uint8_t* m_attr_value{};
+    uint8_t* m_attr_value{m_inline};
     uint16_t m_attr_max_len{};
     uint16_t m_attr_len{};
-    uint16_t m_capacity{};
+    uint16_t m_capacity{CONFIG_NIMBLE_CPP_ATT_VALUE_INLINE_LENGTH};
 # if CONFIG_NIMBLE_CPP_ATT_VALUE_TIMESTAMP_ENABLED
     time_t m_timestamp{};
 # endif
-    void deepCopy(const NimBLEAttValue& source);
+    uint8_t m_inline[CONFIG_NIMBLE_CPP_ATT_VALUE_INLINE_LENGTH + 1]{};
+
+    void     deepCopy(const NimBLEAttValue& source);
+    uint8_t* grow(uint16_t capacity);
+    bool     isInline() const { return m_attr_value == m_inline; }
 
   public:
     /**
@@ -152,6 +166,12 @@ class NimBLEAttValue {
     /** @brief Returns the currently allocated capacity in bytes */
     uint16_t capacity() const { return m_capacity; }
 
+    /** @brief Returns true if the value is stored inside the object rather than on the heap */
+    bool isStoredInline() const { return isInline(); }
+
+    static uint32_t getHeapAllocCount();
+    static void     resetHeapAllocCount();
+
     /** @brief Returns the current length of the value in bytes */
     uint16_t length() const { return m_attr_len; }
 
@@ -363,5 +383,85 @@ class NimBLEAttValue {
 # endif
 };
 
+/**
+ * @brief A non-owning, read only view of an attribute value.
+ * @details Reading through a view does not copy the value. The view is only valid as long as the\n
+ * viewed value is neither modified nor destroyed, use it inside callbacks or copy to a NimBLEAttValue\n
+ * when the data has to be kept.
+ */
+class NimBLEAttValueView {
+  public:
+    NimBLEAttValueView() = default;
+
+    /**
+     * @brief Construct a view of a buffer.
+     * @param[in] data A pointer to the data.
+     * @param[in] len The length of the data in bytes.
+     */
+    NimBLEAttValueView(const uint8_t* data, uint16_t len) : m_data{data}, m_len{len} {}
+
+    /**
+     * @brief Construct a view of an attribute value.
+     * @param[in] value The value to view.
+     */
+    NimBLEAttValueView(const NimBLEAttValue& value) : m_data{value.data()}, m_len{value.size()} {}
+
+    /** @brief Returns the length of the value in bytes */
+    uint16_t length() const { return m_len; }
+
+    /** @brief Returns the size of the value in bytes */
+    uint16_t size() const { return m_len; }
+
+    /** @brief Returns true if the value is empty */
+    bool empty() const { return m_len == 0; }
+
+    /** @brief Returns a pointer to the viewed data */
+    const uint8_t* data() const { return m_data; }
+
+    /** @brief Iterator begin */
+    const uint8_t* begin() const { return m_data; }
+
+    /** @brief Iterator end */
+    const uint8_t* end() const { return m_data + m_len; }
+
+    /** @brief Subscript operator, returns 0 if out of range */
+    uint8_t operator[](int pos) const { return pos < m_len ? m_data[pos] : 0; }
+
+    /**
+     * @brief Template to return the value as a <type\>.
+     * @tparam T The type to convert the data to.
+     * @param [in] skipSizeCheck If true it will skip checking if the data size is less than <tt>sizeof(<type\>)</tt>.
+     * @return The data converted to <type\> or NULL if skipSizeCheck is false and the data is\n
+     * less than <tt>sizeof(<type\>)</tt>.
+     */
+    template <typename T>
+    T getValue(bool skipSizeCheck = false) const {
+        if (!skipSizeCheck && m_len < sizeof(T)) {
+            return T();
+        }
+        T value;
+        memcpy(&value, m_data, sizeof(T));
+        return value;
+    }
+
+    /** @brief Operator; Get a copy of the value as a std::vector<uint8_t>. */
+    operator std::vector<uint8_t>() const { return std::vector<uint8_t>(m_data, m_data + m_len); }
+
+    /** @brief Operator; Get a copy of the value as a std::string. */
+    operator std::string() const { return std::string(reinterpret_cast<const char*>(m_data), m_len); }
+
+    /** @brief Equality operator */
+    bool operator==(const NimBLEAttValueView& other) const {
+        return m_len == other.m_len && (m_len == 0 || memcmp(m_data, other.m_data, m_len) == 0);
+    }
+
+    /** @brief Inequality operator */
+    bool operator!=(const NimBLEAttValueView& other) const { return !(*this == other); }
+
+  private:
+    const uint8_t* m_data{nullptr};
+    uint16_t       m_len{0};
+};
+
 #endif // CONFIG_BT_ENABLED
 #endif // NIMBLE_CPP_ATTVALUE_H_
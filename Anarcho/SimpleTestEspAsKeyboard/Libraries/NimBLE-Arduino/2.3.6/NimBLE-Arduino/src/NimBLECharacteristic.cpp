@@ -255,6 +255,28 @@ bool NimBLECharacteristic::notify(const uint8_t* value, size_t length, uint16_t
     return sendValue(value, length, true, connHandle);
 } // indicate
 
+/**
+ * @brief Send an indication to all connected peers and report the outcome for each of them.
+ * @param[in] value A pointer to the data to send.
+ * @param[in] length The length of the data to send.
+ * @param[out] result Receives the connection handle and return code for each peer.
+ * @return True if the indication was sent to every connected peer, false otherwise.
+ */
+bool NimBLECharacteristic::indicate(const uint8_t* value, size_t length, SendResult& result) const {
+    return sendValueToAll(value, length, false, &result);
+} // indicate
+
+/**
+ * @brief Send a notification to all connected peers and report the outcome for each of them.
+ * @param[in] value A pointer to the data to send.
+ * @param[in] length The length of the data to send.
+ * @param[out] result Receives the connection handle and return code for each peer.
+ * @return True if the notification was sent to every connected peer, false otherwise.
+ */
+bool NimBLECharacteristic::notify(const uint8_t* value, size_t length, SendResult& result) const {
+    return sendValueToAll(value, length, true, &result);
+} // notify
+
 /**
  * @brief Sends a notification or indication.
  * @param[in] value A pointer to the data to send.
@@ -287,20 +309,7 @@ bool NimBLECharacteristic::sendValue(const uint8_t* value, size_t length, bool i
         }
 
         // Notify all connected peers unless a specific handle is provided
-        for (const auto& ch : NimBLEDevice::getServer()->getPeerDevices()) {
-            // Must re-create the data buffer on each iteration because it is freed by the calls bellow.
-            om = ble_hs_mbuf_from_flat(value, length);
-            if (!om) {
-                rc = BLE_HS_ENOMEM;
-                goto done;
-            }
-
-            if (isNotification) {
-                rc = ble_gattc_notify_custom(ch, m_handle, om);
-            } else {
-                rc = ble_gattc_indicate_custom(ch, m_handle, om);
-            }
-        }
+        return sendValueToAll(value, length, isNotification, nullptr);
     } else if (connHandle != BLE_HS_CONN_HANDLE_NONE) {
         // Null buffer will read the value from the characteristic
         if (isNotification) {
@@ -321,6 +330,62 @@ done:
     return true;
 } // sendValue
 
+/**
+ * @brief Sends a custom value to all connected peers.
+ * @param[in] value A pointer to the data to send.
+ * @param[in] length The length of the data to send.
+ * @param[in] isNotification if true sends a notification, false sends an indication.
+ * @param[out] result Optional, receives the connection handle and return code for each peer.
+ * @return True if the value was sent to every connected peer, false otherwise.
+ * @details The value is copied into an mbuf once and the last peer is sent that mbuf. Every other peer is
+ * sent an os_mbuf_dup() of it, i.e. one copy of the value per additional peer remains. NimBLE mbufs are not
+ * reference counted and the host consumes each one, prepending the ATT, L2CAP and HCI headers in place,
+ * so a single buffer cannot be shared between peers. A failure for one peer does not stop the others.
+ */
+bool NimBLECharacteristic::sendValueToAll(const uint8_t* value,
+                                          size_t         length,
+                                          bool           isNotification,
+                                          SendResult*    result) const {
+    SendResult  localResult{};
+    SendResult& res = result ? *result : localResult;
+    res             = SendResult{};
+
+    // Take a snapshot of the peers so that a connect/disconnect during the loop cannot leak the buffer.
+    res.count = NimBLEDevice::getServer()->getPeerDevices(res.connHandle.data(), res.connHandle.size());
+
+    if (res.count == 0) {
+        return true;
+    }
+
+    os_mbuf* om = ble_hs_mbuf_from_flat(value, length);
+    for (uint8_t i = 0; i < res.count; i++) {
+        os_mbuf* txom = om;
+        if (om && i + 1 < res.count) {
+            txom = os_mbuf_dup(om);
+        }
+
+        if (!txom) {
+            res.rc[i] = BLE_HS_ENOMEM;
+        } else if (isNotification) {
+            res.rc[i] = ble_gattc_notify_custom(res.connHandle[i], m_handle, txom);
+        } else {
+            res.rc[i] = ble_gattc_indicate_custom(res.connHandle[i], m_handle, txom);
+        }
+
+        if (res.rc[i] == 0) {
+            res.sent++;
+        } else {
+            NIMBLE_LOGE(LOG_TAG,
+                        "failed to send value to conn %u, rc=%d %s",
+                        res.connHandle[i],
+                        res.rc[i],
+                        NimBLEUtils::returnCodeToString(res.rc[i]));
+        }
+    }
+
+    return res.sent == res.count;
+} // sendValueToAll
+
 void NimBLECharacteristic::readEvent(NimBLEConnInfo& connInfo) {
     m_pCallbacks->onRead(this, connInfo);
 } // readEvent
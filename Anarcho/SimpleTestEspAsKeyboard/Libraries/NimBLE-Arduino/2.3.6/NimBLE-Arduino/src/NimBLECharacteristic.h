@@ -29,6 +29,7 @@ class NimBLE2904;
 
 # include "NimBLELocalValueAttribute.h"
 
+# include <array>
 # include <string>
 # include <vector>
 
@@ -40,6 +41,18 @@ class NimBLE2904;
  */
 class NimBLECharacteristic : public NimBLELocalValueAttribute {
   public:
+    /**
+     * @brief Per-peer outcome of a notification or indication sent to all connected peers.
+     * @details Entries [0, count) hold the connection handle and the NimBLE return code for each peer,
+     * in the order the peers were sent to.
+     */
+    struct SendResult {
+        uint8_t                                                count{0};
+        uint8_t                                                sent{0};
+        std::array<uint16_t, CONFIG_BT_NIMBLE_MAX_CONNECTIONS> connHandle{};
+        std::array<int, CONFIG_BT_NIMBLE_MAX_CONNECTIONS>      rc{};
+    };
+
     NimBLECharacteristic(const char*    uuid,
                          uint16_t       properties = NIMBLE_PROPERTY::READ | NIMBLE_PROPERTY::WRITE,
                          uint16_t       maxLen     = BLE_ATT_ATTR_MAX_LEN,
@@ -60,6 +73,8 @@ class NimBLECharacteristic : public NimBLELocalValueAttribute {
     bool        indicate(const uint8_t* value, size_t length, uint16_t connHandle = BLE_HS_CONN_HANDLE_NONE) const;
     bool        notify(uint16_t connHandle = BLE_HS_CONN_HANDLE_NONE) const;
     bool        notify(const uint8_t* value, size_t length, uint16_t connHandle = BLE_HS_CONN_HANDLE_NONE) const;
+    bool        indicate(const uint8_t* value, size_t length, SendResult& result) const;
+    bool        notify(const uint8_t* value, size_t length, SendResult& result) const;
 
     NimBLEDescriptor* createDescriptor(const char* uuid,
                                        uint32_t    properties = NIMBLE_PROPERTY::READ | NIMBLE_PROPERTY::WRITE,
@@ -232,6 +247,7 @@ class NimBLECharacteristic : public NimBLELocalValueAttribute {
                    size_t         length,
                    bool           is_notification = true,
                    uint16_t       connHandle      = BLE_HS_CONN_HANDLE_NONE) const;
+    bool sendValueToAll(const uint8_t* value, size_t length, bool isNotification, SendResult* result) const;
 
     NimBLECharacteristicCallbacks* m_pCallbacks{nullptr};
     NimBLEService*                 m_pService{nullptr};
@@ -20,6 +20,7 @@
 
 # include "NimBLERemoteService.h"
 # include "NimBLERemoteCharacteristic.h"
+# include "NimBLEReadMultiplePlan.h"
 # include "NimBLEDevice.h"
 # include "NimBLELog.h"
 
@@ -67,6 +68,7 @@ NimBLEClient::NimBLEClient(const NimBLEAddress& peerAddress)
       m_connHandle{BLE_HS_CONN_HANDLE_NONE},
       m_terminateFailCount{0},
       m_asyncSecureAttempt{0},
+      m_readMultipleVar{true},
       m_config{},
 # if CONFIG_BT_NIMBLE_EXT_ADV
       m_phyMask{BLE_GAP_LE_PHY_1M_MASK | BLE_GAP_LE_PHY_2M_MASK | BLE_GAP_LE_PHY_CODED_MASK},
@@ -703,6 +705,9 @@ const std::vector<NimBLERemoteService*>& NimBLEClient::getServices(bool refresh)
 
 /**
  * @brief Retrieves the full database of attributes that the peripheral has available.
+ * @details With CONFIG_BT_NIMBLE_GATT_CACHING enabled the host answers the discovery procedures from\n
+ * the database stored for this peer once it has been validated with the peer's Database Hash, so a\n
+ * known peer costs a single read (none if bonded) instead of a round trip per attribute.
  * @return True if successful.
  */
 bool NimBLEClient::discoverAttributes() {
@@ -857,6 +862,216 @@ bool NimBLEClient::setValue(const NimBLEUUID&     serviceUUID,
     return ret;
 } // setValue
 
+/**
+ * @brief Read the values of several remote attributes with as few requests as possible.
+ * @param [in] attributes The attributes to read, they must belong to this client.
+ * @returns true if all values were read, the value of each attribute is updated.
+ * @details The reads are grouped into ATT Read Multiple Variable Length requests that fit the MTU, the
+ * expected size of each value is its length from the last read. Values that were never read (length 0) or
+ * that are too long for one response are read individually, those reads are kept in flight together.
+ * If a value has grown since its last read and the response comes back short, the values of that request
+ * are read again individually.\n
+ * If the peer does not support Read Multiple Variable Length, all reads of this client are done individually.
+ */
+bool NimBLEClient::readValues(const std::vector<NimBLERemoteValueAttribute*>& attributes) {
+    NIMBLE_LOGD(LOG_TAG, ">> readValues: %u attributes", (unsigned)attributes.size());
+
+    std::vector<uint16_t> lengths;
+    lengths.reserve(attributes.size());
+    for (const auto pAttr : attributes) {
+        const size_t len = pAttr->getLength();
+        lengths.push_back(len > 0 ? static_cast<uint16_t>(len) : NimBLEReadMultiplePlan::UNKNOWN_LENGTH);
+    }
+
+    NimBLEReadMultiplePlan plan;
+    plan.build(lengths.data(), lengths.size(), getMTU(), m_readMultipleVar ? MYNEWT_VAL(BLE_GATT_READ_MAX_ATTRS) : 1);
+
+    bool                                     ret = true;
+    std::vector<NimBLERemoteValueAttribute*> singles;
+    NimBLERemoteValueAttribute*              batchAttrs[MYNEWT_VAL(BLE_GATT_READ_MAX_ATTRS)];
+    for (const auto& batch : plan.getBatches()) {
+        for (uint8_t i = 0; i < batch.count; i++) {
+            batchAttrs[i] = attributes[plan.getOrder()[batch.first + i]];
+        }
+
+        if (batch.count > 1 && m_readMultipleVar) {
+            int rc = readMultiple(batchAttrs, batch.count);
+            if (rc == 0) {
+                continue;
+            }
+
+            if (rc == BLE_HS_EBADDATA) {
+                NIMBLE_LOGI(LOG_TAG, "Read multiple response short, reading the batch individually");
+                singles.insert(singles.end(), batchAttrs, batchAttrs + batch.count);
+                continue;
+            }
+
+            if (rc != BLE_HS_ENOTSUP && rc != BLE_HS_ATT_ERR(BLE_ATT_ERR_REQ_NOT_SUPPORTED)) {
+                ret = false;
+                continue;
+            }
+
+            NIMBLE_LOGI(LOG_TAG, "Read Multiple Variable Length not supported, reading individually");
+            m_readMultipleVar = false;
+        }
+
+        singles.insert(singles.end(), batchAttrs, batchAttrs + batch.count);
+    }
+
+    // Started after the Read Multiple requests so that only one request is outstanding at a time.
+    std::vector<NimBLEGattFuture> futures;
+    futures.reserve(singles.size());
+    for (const auto pAttr : singles) {
+        futures.push_back(pAttr->readValueAsync());
+    }
+
+    NimBLEGattFuture::waitAll(futures.data(), futures.size());
+    for (const auto& future : futures) {
+        if (future.getResult() != 0) {
+            ret = false;
+        }
+    }
+
+    NIMBLE_LOGD(LOG_TAG, "<< readValues: %u requests", (unsigned)plan.getBatches().size());
+    return ret;
+} // readValues
+
+/**
+ * @brief Get the number of ATT bearers of the connection.
+ * @returns 1 for the unenhanced ATT bearer plus the number of connected EATT bearers.
+ * @details This is also the number of requests the client keeps in flight at a time.
+ */
+size_t NimBLEClient::getBearerCount() const {
+    ble_npl_hw_enter_critical();
+    const size_t count = m_bearers.size();
+    ble_npl_hw_exit_critical(0);
+    return count;
+} // getBearerCount
+
+/**
+ * @brief Get the statistics of the GATT requests on the connection.
+ * @details Only requests started by the asynchronous and synchronous read and write functions of the
+ * remote attributes are counted, requests of the discovery functions are not. The host picks the ATT
+ * bearer of each request, a maxInFlight above 1 shows that requests ran on several bearers at once.
+ */
+NimBLEGattRequestStats NimBLEClient::getRequestStats() const {
+    ble_npl_hw_enter_critical();
+    const NimBLEGattRequestStats stats = m_bearers.stats();
+    ble_npl_hw_exit_critical(0);
+    return stats;
+} // getRequestStats
+
+/**
+ * @brief Clear the request statistics, the requests in flight are kept.
+ */
+void NimBLEClient::clearRequestStats() {
+    ble_npl_hw_enter_critical();
+    m_bearers.clearStats();
+    ble_npl_hw_exit_critical(0);
+} // clearRequestStats
+
+/**
+ * @brief Count a GATT request that is about to be sent.
+ * @returns The start time of the request, from ble_npl_time_get(), to pass to finishRequest().
+ */
+uint32_t NimBLEClient::startRequest() {
+    ble_npl_hw_enter_critical();
+    m_bearers.start();
+    ble_npl_hw_exit_critical(0);
+    return ble_npl_time_get();
+} // startRequest
+
+/**
+ * @brief Record the completion of a request counted with startRequest().
+ * @param [in] rc The result of the request.
+ * @param [in] bytes The number of value bytes read or written.
+ * @param [in] startTime The value returned by startRequest().
+ */
+void NimBLEClient::finishRequest(int rc, size_t bytes, uint32_t startTime) {
+    const uint32_t elapsed = ble_npl_time_ticks_to_ms32(ble_npl_time_get() - startTime);
+    ble_npl_hw_enter_critical();
+    m_bearers.finish(rc != 0, bytes, elapsed);
+    ble_npl_hw_exit_critical(0);
+} // finishRequest
+
+/**
+ * @brief Read a batch of attributes with one Read Multiple Variable Length request.
+ * @param [in] pAttrs The attributes, at least 2 and at most BLE_GATT_READ_MAX_ATTRS.
+ * @param [in] count The number of attributes.
+ * @return 0 on success, otherwise the NimBLE error code.
+ */
+int NimBLEClient::readMultiple(NimBLERemoteValueAttribute** pAttrs, uint8_t count) {
+    uint16_t       handles[MYNEWT_VAL(BLE_GATT_READ_MAX_ATTRS)];
+    int            retryCount = 1;
+    int            rc         = 0;
+    NimBLETaskData taskData(this, 0, pAttrs);
+
+    for (uint8_t i = 0; i < count; i++) {
+        handles[i] = pAttrs[i]->getHandle();
+    }
+
+    do {
+        rc = ble_gattc_read_mult_var(m_connHandle, handles, count, NimBLEClient::readMultipleCB, &taskData);
+        if (rc != 0) {
+            break;
+        }
+
+        NimBLEUtils::taskWait(taskData, BLE_NPL_TIME_FOREVER);
+        rc = taskData.m_flags;
+        switch (rc) {
+            case 0:
+            case BLE_HS_EDONE:
+                rc = 0;
+                break;
+            case BLE_HS_ATT_ERR(BLE_ATT_ERR_INSUFFICIENT_AUTHEN):
+            case BLE_HS_ATT_ERR(BLE_ATT_ERR_INSUFFICIENT_AUTHOR):
+            case BLE_HS_ATT_ERR(BLE_ATT_ERR_INSUFFICIENT_ENC):
+                if (retryCount && secureConnection()) break;
+            /* Else falls through. */
+            default:
+                retryCount = 0;
+                break;
+        }
+    } while (rc != 0 && retryCount--);
+
+    if (rc != 0) {
+        NIMBLE_LOGE(LOG_TAG, "Read multiple failed rc=%d, %s", rc, NimBLEUtils::returnCodeToString(rc));
+    }
+
+    return rc;
+} // readMultiple
+
+/**
+ * @brief Callback for the Read Multiple Variable Length request, scatters the values to the attributes.
+ * @return success == 0 or error code.
+ */
+int NimBLEClient::readMultipleCB(uint16_t                     connHandle,
+                                 const struct ble_gatt_error* error,
+                                 struct ble_gatt_attr*        attrs,
+                                 uint8_t                      numAttrs,
+                                 void*                        arg) {
+    auto pTaskData = static_cast<NimBLETaskData*>(arg);
+    auto pAttrs    = static_cast<NimBLERemoteValueAttribute**>(pTaskData->m_pBuf);
+    int  rc        = error->status;
+
+    NIMBLE_LOGI(LOG_TAG, "Read multiple complete; status=%d", rc);
+
+    if (rc == 0) {
+        for (uint8_t i = 0; i < numAttrs; i++) {
+            NimBLEAttValue value{};
+            for (os_mbuf* om = attrs[i].om; om != nullptr; om = SLIST_NEXT(om, om_next)) {
+                value.append(om->om_data, om->om_len);
+            }
+
+            value.setTimeStamp();
+            pAttrs[i]->m_value = value;
+        }
+    }
+
+    NimBLEUtils::taskRelease(*pTaskData, rc);
+    return 0;
+} // readMultipleCB
+
 /**
  * @brief Get the remote characteristic with the specified handle.
  * @param [in] handle The handle of the desired characteristic.
@@ -935,7 +1150,10 @@ int NimBLEClient::handleGapEvent(struct ble_gap_event* event, void* arg) {
         case BLE_GAP_EVENT_DISCONNECT: {
 
             // workaround for bug in NimBLE stack where disconnect event argument is not passed correctly
-            pClient = NimBLEDevice::getClientByPeerAddress(event->disconnect.conn.peer_ota_addr);
+            pClient = NimBLEDevice::getClientByHandle(event->disconnect.conn.conn_handle);
+            if (pClient == nullptr) {
+                pClient = NimBLEDevice::getClientByPeerAddress(event->disconnect.conn.peer_ota_addr);
+            }
             if (pClient == nullptr) {
                 pClient = NimBLEDevice::getClientByPeerAddress(event->disconnect.conn.peer_id_addr);
             }
@@ -973,6 +1191,7 @@ int NimBLEClient::handleGapEvent(struct ble_gap_event* event, void* arg) {
                 pClient->m_pClientCallbacks->onDisconnect(pClient, rc);
             }
 
+            NimBLEDevice::m_clientIndex.remove(pClient);
             pClient->m_connHandle = BLE_HS_CONN_HANDLE_NONE;
 
             if (pClient->m_config.deleteOnDisconnect) {
@@ -1003,6 +1222,13 @@ int NimBLEClient::handleGapEvent(struct ble_gap_event* event, void* arg) {
 
             if (rc == 0) {
                 pClient->m_connHandle = event->connect.conn_handle;
+                ble_npl_hw_enter_critical();
+                pClient->m_bearers.reset();
+                ble_npl_hw_exit_critical(0);
+                NimBLEDevice::m_clientIndex.add(pClient,
+                                                pClient->m_connHandle,
+                                                pClient->m_peerAddress.getType(),
+                                                pClient->m_peerAddress.getVal());
 
                 if (pClient->m_config.asyncConnect) {
                     pClient->m_pClientCallbacks->onConnect(pClient);
@@ -1182,6 +1408,24 @@ int NimBLEClient::handleGapEvent(struct ble_gap_event* event, void* arg) {
             break;
         } // BLE_GAP_EVENT_MTU
 
+# if CONFIG_BT_NIMBLE_EATT_CHAN_NUM > 0
+        case BLE_GAP_EVENT_EATT: {
+            if (pClient->m_connHandle != event->eatt.conn_handle) {
+                return 0;
+            }
+
+            NIMBLE_LOGI(LOG_TAG, "EATT bearer %s: cid=%u", event->eatt.status == 0 ? "connected" : "disconnected", event->eatt.cid);
+            ble_npl_hw_enter_critical();
+            if (event->eatt.status == 0) {
+                pClient->m_bearers.add(event->eatt.cid);
+            } else {
+                pClient->m_bearers.remove(event->eatt.cid);
+            }
+            ble_npl_hw_exit_critical(0);
+            return 0;
+        } // BLE_GAP_EVENT_EATT
+# endif
+
         case BLE_GAP_EVENT_PASSKEY_ACTION: {
             if (pClient->m_connHandle != event->passkey.conn_handle) {
                 return 0;
@@ -28,15 +28,21 @@
 # endif
 
 # include "NimBLEAddress.h"
+# include "NimBLEAttBearers.h"
 
 # include <stdint.h>
 # include <vector>
 # include <string>
 
+# if !defined(CONFIG_BT_NIMBLE_EATT_CHAN_NUM)
+#  define CONFIG_BT_NIMBLE_EATT_CHAN_NUM 0
+# endif
+
 class NimBLEAddress;
 class NimBLEUUID;
 class NimBLERemoteService;
 class NimBLERemoteCharacteristic;
+class NimBLERemoteValueAttribute;
 class NimBLEAdvertisedDevice;
 class NimBLEAttValue;
 class NimBLEClientCallbacks;
@@ -94,6 +100,11 @@ class NimBLEClient {
                             const NimBLEUUID&     characteristicUUID,
                             const NimBLEAttValue& value,
                             bool                  response = false);
+    bool           readValues(const std::vector<NimBLERemoteValueAttribute*>& attributes);
+
+    size_t                 getBearerCount() const;
+    NimBLEGattRequestStats getRequestStats() const;
+    void                   clearRequestStats();
 
 # if CONFIG_BT_NIMBLE_EXT_ADV
     void setConnectPhy(uint8_t phyMask);
@@ -125,6 +136,14 @@ class NimBLEClient {
                                    const struct ble_gatt_error* error,
                                    const struct ble_gatt_svc*   service,
                                    void*                        arg);
+    int        readMultiple(NimBLERemoteValueAttribute** pAttrs, uint8_t count);
+    static int readMultipleCB(uint16_t                     connHandle,
+                              const struct ble_gatt_error* error,
+                              struct ble_gatt_attr*        attrs,
+                              uint8_t                      numAttrs,
+                              void*                        arg);
+    uint32_t   startRequest();
+    void       finishRequest(int rc, size_t bytes, uint32_t startTime);
 
     NimBLEAddress                     m_peerAddress;
     mutable int                       m_lastErr;
@@ -135,6 +154,7 @@ class NimBLEClient {
     uint16_t                          m_connHandle;
     uint8_t                           m_terminateFailCount;
     mutable uint8_t                   m_asyncSecureAttempt;
+    bool                              m_readMultipleVar;
     Config                            m_config;
 
 # if CONFIG_BT_NIMBLE_EXT_ADV
@@ -142,8 +162,12 @@ class NimBLEClient {
 # endif
     ble_gap_conn_params m_connParams;
 
+    NimBLEAttBearers<1 + CONFIG_BT_NIMBLE_EATT_CHAN_NUM> m_bearers;
+
     friend class NimBLEDevice;
     friend class NimBLEServer;
+    friend class NimBLERemoteValueAttribute;
+    friend class NimBLEGattFuture;
 }; // class NimBLEClient
 
 /**
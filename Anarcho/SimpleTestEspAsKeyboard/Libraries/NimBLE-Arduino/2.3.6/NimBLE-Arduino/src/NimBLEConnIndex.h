@@ -0,0 +1,151 @@
+/*
+ * Copyright 2020-2025 Ryan Powell <ryan@nable-embedded.io> and
+ * esp-nimble-cpp, NimBLE-Arduino contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NIMBLE_CPP_CONN_INDEX_H_
+#define NIMBLE_CPP_CONN_INDEX_H_
+
+/**
+ * This header has no dependency on the NimBLE stack so that it can also be built on a host
+ * for benchmarking (see Src/Tools/NimBLEBench).
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @brief Index of the connected objects by connection handle and peer address.
+ * @details Entries are added when a connection is established and removed when it ends, so the table
+ * only holds connected objects. An address mask built from the low byte of the peer addresses answers
+ * most "are we connected to this address" queries without touching the table, which is what the scan
+ * path asks for every advertising report.
+ * @tparam T The indexed object type.
+ * @tparam N The maximum number of entries, NIMBLE_MAX_CONNECTIONS.
+ */
+template <typename T, size_t N>
+class NimBLEConnIndex {
+  public:
+    /**
+     * @brief Add or update the entry of an object.
+     * @param [in] obj The connected object.
+     * @param [in] connHandle The connection handle.
+     * @param [in] addrType The peer address type.
+     * @param [in] addrVal The 6 byte peer address value.
+     * @return False if the index is full.
+     */
+    bool add(T* obj, uint16_t connHandle, uint8_t addrType, const uint8_t* addrVal) {
+        Entry* entry = nullptr;
+        for (size_t i = 0; i < m_count; i++) {
+            if (m_entries[i].obj == obj) {
+                entry = &m_entries[i];
+                break;
+            }
+        }
+
+        if (entry == nullptr) {
+            if (m_count >= N) {
+                return false;
+            }
+            entry = &m_entries[m_count++];
+        }
+
+        entry->obj        = obj;
+        entry->connHandle = connHandle;
+        entry->addrType   = addrType;
+        memcpy(entry->addrVal, addrVal, sizeof(entry->addrVal));
+        rebuildMask();
+        return true;
+    }
+
+    /**
+     * @brief Remove the entry of an object, if any.
+     * @param [in] obj The object to remove.
+     */
+    void remove(const T* obj) {
+        for (size_t i = 0; i < m_count; i++) {
+            if (m_entries[i].obj == obj) {
+                m_entries[i] = m_entries[--m_count];
+                rebuildMask();
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Find an object by connection handle.
+     * @param [in] connHandle The connection handle.
+     * @return The object or nullptr if not connected.
+     */
+    T* findByHandle(uint16_t connHandle) const {
+        for (size_t i = 0; i < m_count; i++) {
+            if (m_entries[i].connHandle == connHandle) {
+                return m_entries[i].obj;
+            }
+        }
+
+        return nullptr;
+    }
+
+    /**
+     * @brief Find an object by peer address.
+     * @param [in] addrType The peer address type.
+     * @param [in] addrVal The 6 byte peer address value.
+     * @return The object or nullptr if not connected to that address.
+     */
+    T* findByAddress(uint8_t addrType, const uint8_t* addrVal) const {
+        if ((m_addrMask & addrBit(addrVal)) == 0) {
+            return nullptr;
+        }
+
+        for (size_t i = 0; i < m_count; i++) {
+            const Entry& entry = m_entries[i];
+            if (entry.addrType == addrType && memcmp(entry.addrVal, addrVal, sizeof(entry.addrVal)) == 0) {
+                return entry.obj;
+            }
+        }
+
+        return nullptr;
+    }
+
+    /**
+     * @brief Get the number of indexed objects.
+     */
+    size_t size() const { return m_count; }
+
+  private:
+    struct Entry {
+        T*       obj;
+        uint16_t connHandle;
+        uint8_t  addrType;
+        uint8_t  addrVal[6];
+    };
+
+    static uint32_t addrBit(const uint8_t* addrVal) { return 1UL << (addrVal[0] & 31); }
+
+    void rebuildMask() {
+        m_addrMask = 0;
+        for (size_t i = 0; i < m_count; i++) {
+            m_addrMask |= addrBit(m_entries[i].addrVal);
+        }
+    }
+
+    Entry    m_entries[N]{};
+    size_t   m_count{0};
+    uint32_t m_addrMask{0};
+}; // NimBLEConnIndex
+
+#endif // NIMBLE_CPP_CONN_INDEX_H_
@@ -0,0 +1,278 @@
+/*
+ * Copyright 2020-2025 Ryan Powell <ryan@nable-embedded.io> and
+ * esp-nimble-cpp, NimBLE-Arduino contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NIMBLE_CPP_CONST_ADV_DATA_H_
+#define NIMBLE_CPP_CONST_ADV_DATA_H_
+
+/**
+ * This header has no dependency on the NimBLE stack so that it can also be built on a host
+ * for benchmarking (see Src/Tools/NimBLEBench).
+ */
+
+#include "NimBLEConstUUID.h"
+
+#include <array>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @brief A legacy advertising payload that is built at compile time.
+ * @details Each builder call returns a new, larger payload, the size is part of the type and a payload
+ * that does not fit in 31 bytes fails to compile. Fields that change at runtime are located once with
+ * slot() and then overwritten in place with patch(), e.g.
+ * @code
+ * static constexpr auto kAdv = NimBLEConstAdvData<>()
+ *                                  .flags(BLE_HS_ADV_F_DISC_GEN)
+ *                                  .completeServices16(0x1812)
+ *                                  .appearance(961)
+ *                                  .manufacturerData(0xFFFF, {0x00});
+ * static constexpr auto kCardState = kAdv.slot(BLE_HS_ADV_TYPE_MFG_DATA, 2);
+ *
+ * static auto adv = kAdv;
+ * adv.patch(kCardState, state);
+ * NimBLEDevice::getAdvertising()->setAdvertisementData(adv);
+ * @endcode
+ */
+template <size_t N = 0>
+class NimBLEConstAdvData {
+  public:
+    /** Same value as BLE_HS_ADV_MAX_SZ. */
+    static constexpr size_t MAX_SIZE = 31;
+    static_assert(N <= MAX_SIZE, "Advertisement data exceeds 31 bytes");
+
+    /**
+     * @brief A range of the payload that can be changed with patch().
+     */
+    struct Slot {
+        uint8_t offset;
+        uint8_t length;
+    };
+
+    /**
+     * @brief Create an empty payload.
+     */
+    constexpr NimBLEConstAdvData() = default;
+
+    /**
+     * @brief Add a field with an arbitrary AD type.
+     * @param [in] type The AD type, e.g. BLE_HS_ADV_TYPE_TX_PWR_LVL.
+     * @param [in] data The field data.
+     */
+    template <size_t L>
+    constexpr NimBLEConstAdvData<N + 2 + L> field(uint8_t type, const uint8_t (&data)[L]) const {
+        return append<N + 2 + L>(type, data, L);
+    }
+
+    /**
+     * @brief Add the flags field, BLE_HS_ADV_F_BREDR_UNSUP is always set as in NimBLEAdvertisementData.
+     * @param [in] flag The flags, e.g. BLE_HS_ADV_F_DISC_GEN.
+     */
+    constexpr NimBLEConstAdvData<N + 3> flags(uint8_t flag) const {
+        const uint8_t data[] = {static_cast<uint8_t>(flag | F_BREDR_UNSUP)};
+        return append<N + 3>(TYPE_FLAGS, data, 1);
+    }
+
+    /**
+     * @brief Add the appearance field.
+     * @param [in] appearance The appearance value, e.g. 961 for a keyboard.
+     */
+    constexpr NimBLEConstAdvData<N + 4> appearance(uint16_t appearance) const {
+        const uint8_t data[] = {static_cast<uint8_t>(appearance), static_cast<uint8_t>(appearance >> 8)};
+        return append<N + 4>(TYPE_APPEARANCE, data, 2);
+    }
+
+    /**
+     * @brief Add the complete local name.
+     * @param [in] name The name as string literal.
+     */
+    template <size_t L>
+    constexpr NimBLEConstAdvData<N + 1 + L> name(const char (&name)[L]) const {
+        return appendChars<N + 1 + L>(TYPE_COMP_NAME, name, L - 1);
+    }
+
+    /**
+     * @brief Add the shortened local name.
+     * @param [in] name The name as string literal.
+     */
+    template <size_t L>
+    constexpr NimBLEConstAdvData<N + 1 + L> shortName(const char (&name)[L]) const {
+        return appendChars<N + 1 + L>(TYPE_INCOMP_NAME, name, L - 1);
+    }
+
+    /**
+     * @brief Add the complete list of 16 bit service UUIDs.
+     * @param [in] uuids The 16 bit service UUIDs.
+     */
+    template <typename... Uuids>
+    constexpr NimBLEConstAdvData<N + 2 + 2 * sizeof...(Uuids)> completeServices16(Uuids... uuids) const {
+        static_assert(sizeof...(Uuids) > 0, "At least one UUID is required");
+        const uint16_t values[] = {static_cast<uint16_t>(uuids)...};
+        uint8_t        data[2 * sizeof...(Uuids)]{};
+        for (size_t i = 0; i < sizeof...(Uuids); i++) {
+            data[2 * i]     = static_cast<uint8_t>(values[i]);
+            data[2 * i + 1] = static_cast<uint8_t>(values[i] >> 8);
+        }
+        return append<N + 2 + 2 * sizeof...(Uuids)>(TYPE_COMP_UUIDS16, data, sizeof(data));
+    }
+
+    /**
+     * @brief Add the complete list of 128 bit service UUIDs with a single UUID.
+     * @param [in] uuid The service UUID, a 16 or 32 bit UUID is expanded with the Bluetooth Base UUID.
+     */
+    constexpr NimBLEConstAdvData<N + 18> completeService128(const NimBLEConstUUID& uuid) const {
+        // Bluetooth Base UUID in little endian order.
+        uint8_t data[16] = {0xfb, 0x34, 0x9b, 0x5f, 0x80, 0x00, 0x00, 0x80, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+        if (uuid.bitSize() == 128) {
+            uuid.getBytes(data);
+        } else {
+            const uint32_t value = uuid.getShort();
+            for (size_t i = 0; i < 4; i++) {
+                data[12 + i] = static_cast<uint8_t>(value >> (8 * i));
+            }
+        }
+        return append<N + 18>(TYPE_COMP_UUIDS128, data, 16);
+    }
+
+    /**
+     * @brief Add manufacturer specific data.
+     * @param [in] companyId The company identifier, written in little endian order before the data.
+     * @param [in] data The manufacturer data.
+     */
+    template <size_t L>
+    constexpr NimBLEConstAdvData<N + 4 + L> manufacturerData(uint16_t companyId, const uint8_t (&data)[L]) const {
+        return appendPrefixed<N + 4 + L>(TYPE_MFG_DATA, companyId, data, L);
+    }
+
+    /**
+     * @brief Add service data for a 16 bit service UUID.
+     * @param [in] uuid The 16 bit service UUID, written in little endian order before the data.
+     * @param [in] data The service data.
+     */
+    template <size_t L>
+    constexpr NimBLEConstAdvData<N + 4 + L> serviceData16(uint16_t uuid, const uint8_t (&data)[L]) const {
+        return appendPrefixed<N + 4 + L>(TYPE_SVC_DATA_UUID16, uuid, data, L);
+    }
+
+    /**
+     * @brief Locate a range of a field that is changed at runtime.
+     * @details When used in a constant expression a type that is not in the payload or a range that
+     * exceeds the field fails to compile, otherwise an empty slot is returned that patch() ignores.
+     * @param [in] type The AD type of the field.
+     * @param [in] offset The offset in the field data, e.g. 2 to skip the company identifier of
+     * manufacturer data.
+     * @param [in] length The number of bytes.
+     * @return The slot.
+     */
+    constexpr Slot slot(uint8_t type, size_t offset = 0, size_t length = 1) const {
+        for (size_t pos = 0; pos + 1 < N && m_data[pos] != 0; pos += m_data[pos] + 1) {
+            if (m_data[pos + 1] == type) {
+                if (offset + length > static_cast<size_t>(m_data[pos] - 1)) {
+                    break;
+                }
+                return Slot{static_cast<uint8_t>(pos + 2 + offset), static_cast<uint8_t>(length)};
+            }
+        }
+
+        invalidSlot();
+        return Slot{0, 0};
+    }
+
+    /**
+     * @brief Overwrite the bytes of a slot.
+     * @param [in] slot The slot from slot().
+     * @param [in] data The new bytes, slot.length bytes are copied.
+     */
+    void patch(const Slot& slot, const uint8_t* data) {
+        if (slot.length && slot.offset + slot.length <= N) {
+            memcpy(&m_data[slot.offset], data, slot.length);
+        }
+    }
+
+    /**
+     * @brief Overwrite the first byte of a slot.
+     * @param [in] slot The slot from slot().
+     * @param [in] value The new value.
+     */
+    void patch(const Slot& slot, uint8_t value) { patch(slot, &value); }
+
+    /**
+     * @brief Get a pointer to the payload.
+     */
+    constexpr const uint8_t* data() const { return m_data.data(); }
+
+    /**
+     * @brief Get the size of the payload.
+     */
+    static constexpr size_t size() { return N; }
+
+  private:
+    template <size_t>
+    friend class NimBLEConstAdvData;
+
+    // Same values as the BLE_HS_ADV_TYPE_* and BLE_HS_ADV_F_* definitions of the host.
+    static constexpr uint8_t TYPE_FLAGS           = 0x01;
+    static constexpr uint8_t TYPE_COMP_UUIDS16    = 0x03;
+    static constexpr uint8_t TYPE_COMP_UUIDS128   = 0x07;
+    static constexpr uint8_t TYPE_INCOMP_NAME     = 0x08;
+    static constexpr uint8_t TYPE_COMP_NAME       = 0x09;
+    static constexpr uint8_t TYPE_SVC_DATA_UUID16 = 0x16;
+    static constexpr uint8_t TYPE_APPEARANCE      = 0x19;
+    static constexpr uint8_t TYPE_MFG_DATA        = 0xFF;
+    static constexpr uint8_t F_BREDR_UNSUP        = 0x04;
+
+    // Not constexpr, stops compilation if reached in a constant expression.
+    static void invalidSlot() {}
+
+    template <size_t M>
+    constexpr NimBLEConstAdvData<M> append(uint8_t type, const uint8_t* data, size_t length) const {
+        NimBLEConstAdvData<M> out{};
+        for (size_t i = 0; i < N; i++) {
+            out.m_data[i] = m_data[i];
+        }
+        out.m_data[N]     = static_cast<uint8_t>(length + 1);
+        out.m_data[N + 1] = type;
+        for (size_t i = 0; i < length; i++) {
+            out.m_data[N + 2 + i] = data[i];
+        }
+        return out;
+    }
+
+    template <size_t M>
+    constexpr NimBLEConstAdvData<M> appendChars(uint8_t type, const char* str, size_t length) const {
+        uint8_t data[MAX_SIZE]{};
+        for (size_t i = 0; i < length && i < MAX_SIZE; i++) {
+            data[i] = static_cast<uint8_t>(str[i]);
+        }
+        return append<M>(type, data, length);
+    }
+
+    template <size_t M>
+    constexpr NimBLEConstAdvData<M> appendPrefixed(uint8_t type, uint16_t prefix, const uint8_t* data, size_t length) const {
+        uint8_t buf[MAX_SIZE]{};
+        buf[0] = static_cast<uint8_t>(prefix);
+        buf[1] = static_cast<uint8_t>(prefix >> 8);
+        for (size_t i = 0; i < length && i + 2 < MAX_SIZE; i++) {
+            buf[2 + i] = data[i];
+        }
+        return append<M>(type, buf, length + 2);
+    }
+
+    std::array<uint8_t, N> m_data{};
+}; // NimBLEConstAdvData
+
+#endif // NIMBLE_CPP_CONST_ADV_DATA_H_
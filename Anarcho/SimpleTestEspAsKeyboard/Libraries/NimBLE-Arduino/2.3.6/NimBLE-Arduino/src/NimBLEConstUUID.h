@@ -0,0 +1,220 @@
+/*
+ * Copyright 2020-2025 Ryan Powell <ryan@nable-embedded.io> and
+ * esp-nimble-cpp, NimBLE-Arduino contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NIMBLE_CPP_CONST_UUID_H_
+#define NIMBLE_CPP_CONST_UUID_H_
+
+/**
+ * This header has no dependency on the NimBLE stack so that it can also be built on a host
+ * for benchmarking (see Src/Tools/NimBLEBench).
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief A %BLE UUID that can be created and compared at compile time.
+ * @details The UUID is kept in canonical form: a 128 bit UUID based on the Bluetooth Base UUID
+ * (xxxxxxxx-0000-1000-8000-00805F9B34FB) is stored as 32 bit UUID and a 32 bit UUID with a value
+ * that fits in 16 bit as 16 bit UUID. Equal UUIDs therefore always have the same size and a 16 bit
+ * UUID is compared with a single integer compare.\n
+ * Converts implicitly to and from NimBLEUUID, e.g.
+ * @code
+ * constexpr NimBLEConstUUID hidService("1812");
+ * constexpr NimBLEConstUUID mySvc("dcbc7255-1e9e-49a0-a360-b0430b6c6905");
+ * pClient->getService(hidService);
+ * @endcode
+ */
+class NimBLEConstUUID {
+  public:
+    /**
+     * @brief Create a blank UUID.
+     */
+    constexpr NimBLEConstUUID() = default;
+
+    /**
+     * @brief Create a UUID from the 16 bit value.
+     * @param [in] uuid The 16 bit short form UUID.
+     */
+    constexpr NimBLEConstUUID(uint16_t uuid) : m_low{uuid}, m_type{TYPE_16} {}
+
+    /**
+     * @brief Create a UUID from the 32 bit value.
+     * @param [in] uuid The 32 bit short form UUID.
+     */
+    constexpr NimBLEConstUUID(uint32_t uuid) : m_low{uuid}, m_type{uuid > 0xFFFF ? TYPE_32 : TYPE_16} {}
+
+    /**
+     * @brief Create a UUID from a string literal.
+     * @details Accepts "NNNN", "NNNNNNNN" and "12345678-90ab-cdef-1234-567890abcdef", each optionally
+     * prefixed with "0x". When used in a constant expression an invalid literal fails to compile,
+     * otherwise it creates a blank UUID.
+     * @param [in] uuid The string literal to parse.
+     */
+    template <size_t N>
+    explicit constexpr NimBLEConstUUID(const char (&uuid)[N]) {
+        parse(uuid, N - 1);
+    }
+
+    /**
+     * @brief Create a 128 bit UUID from its two halves, as written in the string form.
+     * @param [in] high The first 64 bit of the UUID, e.g. 0x0000180d00001000.
+     * @param [in] low The last 64 bit of the UUID, e.g. 0x800000805f9b34fb.
+     */
+    static constexpr NimBLEConstUUID from128(uint64_t high, uint64_t low) {
+        NimBLEConstUUID uuid{};
+        uuid.set128(high, low);
+        return uuid;
+    }
+
+    /**
+     * @brief Create a UUID from 2, 4 or 16 bytes in little endian order, as used over the air.
+     * @param [in] data The bytes of the UUID.
+     * @param [in] size The number of bytes.
+     * @return The UUID, blank if the size is invalid.
+     */
+    static constexpr NimBLEConstUUID fromBytes(const uint8_t* data, size_t size) {
+        if (size == 2) {
+            return NimBLEConstUUID(static_cast<uint16_t>(data[0] | data[1] << 8));
+        }
+        if (size == 4) {
+            return NimBLEConstUUID(static_cast<uint32_t>(readLE(data, 4)));
+        }
+        if (size == 16) {
+            return from128(readLE(data + 8, 8), readLE(data, 8));
+        }
+        return NimBLEConstUUID();
+    }
+
+    /**
+     * @brief Get the bit size of the UUID, 16, 32 or 128.
+     * @return The bit size of the UUID or 0 if blank.
+     */
+    constexpr uint8_t bitSize() const { return m_type; }
+
+    /**
+     * @brief Get the value of a 16 or 32 bit UUID.
+     */
+    constexpr uint32_t getShort() const { return m_type == TYPE_128 ? 0 : static_cast<uint32_t>(m_low); }
+
+    /**
+     * @brief Write the UUID in little endian order, bitSize() / 8 bytes.
+     * @param [out] out The buffer to write to.
+     */
+    constexpr void getBytes(uint8_t* out) const {
+        writeLE(out, m_low, m_type == TYPE_128 ? 8 : m_type / 8);
+        if (m_type == TYPE_128) {
+            writeLE(out + 8, m_high, 8);
+        }
+    }
+
+    /**
+     * @brief Compare two UUIDs, blank UUIDs are never equal.
+     */
+    constexpr bool operator==(const NimBLEConstUUID& rhs) const {
+        return m_low == rhs.m_low && m_type == rhs.m_type && m_type != 0 && (m_type != TYPE_128 || m_high == rhs.m_high);
+    }
+
+    constexpr bool operator!=(const NimBLEConstUUID& rhs) const { return !(*this == rhs); }
+
+  private:
+    // Same values as BLE_UUID_TYPE_16/32/128.
+    static constexpr uint8_t TYPE_16  = 16;
+    static constexpr uint8_t TYPE_32  = 32;
+    static constexpr uint8_t TYPE_128 = 128;
+
+    // Bluetooth Base UUID, 00000000-0000-1000-8000-00805F9B34FB.
+    static constexpr uint64_t BASE_HIGH = 0x0000000000001000;
+    static constexpr uint64_t BASE_LOW  = 0x800000805F9B34FB;
+
+    static constexpr uint64_t readLE(const uint8_t* data, size_t size) {
+        uint64_t value = 0;
+        for (size_t i = size; i > 0; i--) {
+            value = value << 8 | data[i - 1];
+        }
+        return value;
+    }
+
+    static constexpr void writeLE(uint8_t* out, uint64_t value, size_t size) {
+        for (size_t i = 0; i < size; i++) {
+            out[i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+    }
+
+    static constexpr int hexValue(char c) {
+        return c >= '0' && c <= '9' ? c - '0' : c >= 'a' && c <= 'f' ? c - 'a' + 10 : c >= 'A' && c <= 'F' ? c - 'A' + 10 : -1;
+    }
+
+    // Not constexpr, stops compilation if reached in a constant expression.
+    static void invalidUUID() {}
+
+    constexpr void set128(uint64_t high, uint64_t low) {
+        if (low == BASE_LOW && (high & 0xFFFFFFFF) == BASE_HIGH) {
+            *this = NimBLEConstUUID(static_cast<uint32_t>(high >> 32));
+        } else {
+            m_high = high;
+            m_low  = low;
+            m_type = TYPE_128;
+        }
+    }
+
+    constexpr void parse(const char* str, size_t len) {
+        if (len > 2 && str[0] == '0' && (str[1] == 'x' || str[1] == 'X')) {
+            str += 2;
+            len -= 2;
+        }
+
+        if (len != 4 && len != 8 && len != 36) {
+            invalidUUID();
+            return;
+        }
+
+        uint64_t high   = 0;
+        uint64_t low    = 0;
+        size_t   digits = 0;
+        for (size_t i = 0; i < len; i++) {
+            if (len == 36 && (i == 8 || i == 13 || i == 18 || i == 23)) {
+                if (str[i] != '-') {
+                    invalidUUID();
+                    return;
+                }
+                continue;
+            }
+
+            const int nibble = hexValue(str[i]);
+            if (nibble < 0) {
+                invalidUUID();
+                return;
+            }
+            high = high << 4 | low >> 60;
+            low  = low << 4 | static_cast<uint64_t>(nibble);
+            digits++;
+        }
+
+        if (digits == 32) {
+            set128(high, low);
+        } else {
+            *this = NimBLEConstUUID(static_cast<uint32_t>(low));
+        }
+    }
+
+    uint64_t m_high{0};
+    uint64_t m_low{0};
+    uint8_t  m_type{0};
+}; // NimBLEConstUUID
+
+#endif // NIMBLE_CPP_CONST_UUID_H_
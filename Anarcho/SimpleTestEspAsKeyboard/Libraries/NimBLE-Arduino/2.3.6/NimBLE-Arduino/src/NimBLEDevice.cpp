@@ -88,7 +88,8 @@ NimBLEAdvertising* NimBLEDevice::m_bleAdvertising = nullptr;
 # endif
 
 # if CONFIG_BT_NIMBLE_ROLE_CENTRAL
-std::array<NimBLEClient*, NIMBLE_MAX_CONNECTIONS> NimBLEDevice::m_pClients{};
+std::array<NimBLEClient*, NIMBLE_MAX_CONNECTIONS>   NimBLEDevice::m_pClients{};
+NimBLEConnIndex<NimBLEClient, NIMBLE_MAX_CONNECTIONS> NimBLEDevice::m_clientIndex{};
 # endif
 
 bool                       NimBLEDevice::m_initialized{false};
@@ -377,6 +378,7 @@ bool NimBLEDevice::deleteClient(NimBLEClient* pClient) {
                     break;
                 }
             } else {
+                m_clientIndex.remove(clt);
                 delete clt;
                 clt = nullptr;
             }
@@ -407,8 +409,14 @@ size_t NimBLEDevice::getCreatedClientCount() {
  * @brief Get a reference to a client by connection handle.
  * @param [in] connHandle The client connection handle to search for.
  * @return A pointer to the client object with the specified connection handle or nullptr.
+ * @details Connected clients are found in the connection index, the client list is only
+ * searched for BLE_HS_CONN_HANDLE_NONE.
  */
 NimBLEClient* NimBLEDevice::getClientByHandle(uint16_t connHandle) {
+    if (connHandle != BLE_HS_CONN_HANDLE_NONE) {
+        return m_clientIndex.findByHandle(connHandle);
+    }
+
     for (const auto clt : m_pClients) {
         if (clt != nullptr && clt->getConnHandle() == connHandle) {
             return clt;
@@ -422,8 +430,15 @@ NimBLEClient* NimBLEDevice::getClientByHandle(uint16_t connHandle) {
  * @brief Get a reference to a client by peer address.
  * @param [in] addr The address of the peer to search for.
  * @return A pointer to the client object with the peer address or nullptr.
+ * @details Connected clients are found in the connection index, the client list is only
+ * searched when no client is connected to the address.
  */
 NimBLEClient* NimBLEDevice::getClientByPeerAddress(const NimBLEAddress& addr) {
+    NimBLEClient* pClient = m_clientIndex.findByAddress(addr.getType(), addr.getVal());
+    if (pClient != nullptr) {
+        return pClient;
+    }
+
     for (const auto clt : m_pClients) {
         if (clt != nullptr && clt->getPeerAddress() == addr) {
             return clt;
@@ -879,6 +894,12 @@ void NimBLEDevice::host_task(void* param) {
  */
 bool NimBLEDevice::init(const std::string& deviceName) {
     if (!m_initialized) {
+# if CONFIG_NIMBLE_CPP_LOG_DEFERRED
+        if (!NimBLELogDeferred::start()) {
+            NIMBLE_LOGE(LOG_TAG, "Unable to start the deferred log task");
+        }
+
+# endif
 # ifdef ESP_PLATFORM
 
 #  if defined(CONFIG_ENABLE_ARDUINO_DEPENDS) && SOC_BT_SUPPORTED
@@ -41,6 +41,7 @@
 # include <vector>
 
 # if CONFIG_BT_NIMBLE_ROLE_CENTRAL
+#  include "NimBLEConnIndex.h"
 #  include <array>
 class NimBLEClient;
 # endif
@@ -245,7 +246,8 @@ class NimBLEDevice {
 # endif
 
 # if CONFIG_BT_NIMBLE_ROLE_CENTRAL
-    static std::array<NimBLEClient*, NIMBLE_MAX_CONNECTIONS> m_pClients;
+    static std::array<NimBLEClient*, NIMBLE_MAX_CONNECTIONS>   m_pClients;
+    static NimBLEConnIndex<NimBLEClient, NIMBLE_MAX_CONNECTIONS> m_clientIndex;
 # endif
 
 # ifdef ESP_PLATFORM
@@ -294,6 +296,7 @@ class NimBLEDevice {
 #  include "NimBLEService.h"
 #  include "NimBLECharacteristic.h"
 #  include "NimBLEDescriptor.h"
+#  include "NimBLEStaticGatt.h"
 #  if CONFIG_BT_NIMBLE_L2CAP_COC_MAX_NUM
 #   include "NimBLEL2CAPServer.h"
 #   include "NimBLEL2CAPChannel.h"
@@ -0,0 +1,412 @@
+/*
+ * Copyright 2020-2025 Ryan Powell <ryan@nable-embedded.io> and
+ * esp-nimble-cpp, NimBLE-Arduino contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NimBLEGattFuture.h"
+#if CONFIG_BT_ENABLED && CONFIG_BT_NIMBLE_ROLE_CENTRAL
+
+# include "NimBLERemoteValueAttribute.h"
+# include "NimBLEClient.h"
+# include "NimBLEUtils.h"
+# include "NimBLELog.h"
+
+# if defined(CONFIG_NIMBLE_CPP_IDF)
+#  include "host/ble_hs.h"
+# else
+#  include "nimble/nimble/host/include/host/ble_hs.h"
+# endif
+
+/****  FIX COMPILATION ****/
+# undef min
+# undef max
+/**************************/
+
+# include <atomic>
+
+static const char* LOG_TAG = "NimBLEGattFuture";
+
+/**
+ * @brief The shared state of a pending operation.
+ * @details While the operation is queued or in flight the state holds a reference to itself in m_self, so it
+ * stays valid for the GATT callbacks even if the caller drops every future referring to it.
+ */
+struct NimBLEGattFuture::State {
+    State(NimBLERemoteValueAttribute* pAttr, bool write)
+        : m_pAttr{pAttr}, m_pClient{pAttr->getClient()}, m_connHandle{m_pClient->getConnHandle()}, m_write{write} {
+        m_semValid = ble_npl_sem_init(&m_sem, 0) == BLE_NPL_OK;
+        if (!m_semValid) {
+            NIMBLE_LOGE(LOG_TAG, "Failed to init semaphore");
+        }
+    }
+
+    ~State() {
+        if (m_semValid) {
+            ble_npl_sem_deinit(&m_sem);
+        }
+    }
+
+    NimBLERemoteValueAttribute* m_pAttr;
+    NimBLEClient*               m_pClient;
+    NimBLEAttValue              m_value{};
+    Callback                    m_callback{};
+    std::shared_ptr<State>      m_self{};
+    State*                      m_pNext{nullptr};
+    ble_npl_sem                 m_sem{};
+    std::atomic<bool>           m_done{false};
+    int                         m_rc{0};
+    uint32_t                    m_startTime{0};
+    uint16_t                    m_connHandle;
+    bool                        m_write;
+    bool                        m_started{false};
+    bool                        m_long{true};
+    bool                        m_semValid{false};
+};
+
+/**
+ * Pending operations of all connections in submission order. Of each connection as many are in flight as it
+ * has ATT bearers (m_started), the others wait for one of them to complete. Only modified inside a critical
+ * section.
+ */
+NimBLEGattFuture::State* NimBLEGattFuture::m_pQueue = nullptr;
+
+/**
+ * @brief Check if the future refers to an operation.
+ * @return False for a default constructed future.
+ */
+bool NimBLEGattFuture::isValid() const {
+    return m_state != nullptr;
+} // isValid
+
+/**
+ * @brief Check if the operation has completed, without blocking.
+ */
+bool NimBLEGattFuture::isReady() const {
+    return m_state != nullptr && m_state->m_done.load(std::memory_order_acquire);
+} // isReady
+
+/**
+ * @brief Block the calling task until the operation completes or the timeout expires.
+ * @param [in] timeout The time to wait in milliseconds, UINT32_MAX waits forever.
+ * @return True if the operation has completed.
+ */
+bool NimBLEGattFuture::wait(uint32_t timeout) const {
+    if (m_state == nullptr) {
+        return false;
+    }
+
+    if (isReady()) {
+        return true;
+    }
+
+    if (!m_state->m_semValid) {
+        return false;
+    }
+
+    ble_npl_time_t ticks;
+    if (timeout == UINT32_MAX) {
+        ticks = BLE_NPL_TIME_FOREVER;
+    } else {
+        ble_npl_time_ms_to_ticks(timeout, &ticks);
+    }
+
+    if (ble_npl_sem_pend(&m_state->m_sem, ticks) != BLE_NPL_OK) {
+        return isReady();
+    }
+
+    // Put the token back so that other tasks waiting on the same operation are released as well.
+    ble_npl_sem_release(&m_state->m_sem);
+    return true;
+} // wait
+
+/**
+ * @brief Wait for several operations to complete.
+ * @param [in] futures An array of futures, invalid entries are skipped.
+ * @param [in] count The number of futures in the array.
+ * @param [in] timeout The total time to wait in milliseconds, UINT32_MAX waits forever.
+ * @return True if all operations have completed.
+ */
+bool NimBLEGattFuture::waitAll(const NimBLEGattFuture* futures, size_t count, uint32_t timeout) {
+    const ble_npl_time_t start = ble_npl_time_get();
+    for (size_t i = 0; i < count; i++) {
+        if (!futures[i].isValid()) {
+            continue;
+        }
+
+        uint32_t remaining = timeout;
+        if (timeout != UINT32_MAX) {
+            const uint32_t elapsed = ble_npl_time_ticks_to_ms32(ble_npl_time_get() - start);
+            remaining              = elapsed < timeout ? timeout - elapsed : 0;
+        }
+
+        if (!futures[i].wait(remaining)) {
+            return false;
+        }
+    }
+
+    return true;
+} // waitAll
+
+/**
+ * @brief Get the result of the completed operation.
+ * @return 0 on success, BLE_HS_EAGAIN while pending, BLE_HS_EINVAL for an invalid future,
+ * otherwise the NimBLE error code.
+ */
+int NimBLEGattFuture::getResult() const {
+    if (m_state == nullptr) {
+        return BLE_HS_EINVAL;
+    }
+
+    return isReady() ? m_state->m_rc : BLE_HS_EAGAIN;
+} // getResult
+
+/**
+ * @brief Get the value of the completed operation.
+ * @return The value read, or the value written for a write. Empty while the operation is pending.
+ */
+NimBLEAttValue NimBLEGattFuture::getValue() const {
+    if (!isReady()) {
+        return NimBLEAttValue{};
+    }
+
+    return m_state->m_value;
+} // getValue
+
+/**
+ * @brief Get the remote attribute the operation was started on.
+ */
+NimBLERemoteValueAttribute* NimBLEGattFuture::getAttribute() const {
+    return m_state != nullptr ? m_state->m_pAttr : nullptr;
+} // getAttribute
+
+/**
+ * @brief Queue a read of a remote attribute.
+ */
+NimBLEGattFuture NimBLEGattFuture::read(NimBLERemoteValueAttribute* pAttr, const Callback& callback) {
+    auto state        = std::make_shared<State>(pAttr, false);
+    state->m_callback = callback;
+    state->m_self     = state;
+    submit(state.get());
+    return NimBLEGattFuture(std::move(state));
+} // read
+
+/**
+ * @brief Queue a write with response to a remote attribute. The data is copied.
+ */
+NimBLEGattFuture NimBLEGattFuture::write(NimBLERemoteValueAttribute* pAttr,
+                                         const uint8_t*              data,
+                                         size_t                      length,
+                                         const Callback&             callback) {
+    auto state        = std::make_shared<State>(pAttr, true);
+    state->m_callback = callback;
+    state->m_self     = state;
+    state->m_value.setValue(data, length);
+    submit(state.get());
+    return NimBLEGattFuture(std::move(state));
+} // write
+
+/**
+ * @brief Append the operation to the queue and start it if its connection has an ATT bearer left.
+ */
+void NimBLEGattFuture::submit(State* pState) {
+    const size_t bearers  = pState->m_pClient->getBearerCount();
+    size_t       inFlight = 0;
+    bool         queued   = false;
+
+    ble_npl_hw_enter_critical();
+    State** ppNext = &m_pQueue;
+    while (*ppNext != nullptr) {
+        if ((*ppNext)->m_connHandle == pState->m_connHandle) {
+            if ((*ppNext)->m_started) {
+                inFlight++;
+            } else {
+                queued = true;
+            }
+        }
+        ppNext = &(*ppNext)->m_pNext;
+    }
+    *ppNext = pState;
+    // Operations that are already waiting go first.
+    const bool startNow = !queued && inFlight < bearers;
+    pState->m_started   = startNow;
+    ble_npl_hw_exit_critical(0);
+
+    if (startNow) {
+        int rc = start(pState);
+        if (rc != 0) {
+            complete(pState, rc);
+        }
+    }
+} // submit
+
+/**
+ * @brief Send the first request of the operation, the host picks an idle ATT bearer for it.
+ * @return 0 if the request was sent, otherwise the NimBLE error code.
+ */
+int NimBLEGattFuture::start(State* pState) {
+    const uint16_t handle = pState->m_pAttr->getHandle();
+    pState->m_startTime   = pState->m_pClient->startRequest();
+    if (!pState->m_write) {
+        return ble_gattc_read_long(pState->m_connHandle, handle, 0, NimBLEGattFuture::onReadCB, pState);
+    }
+
+    const uint16_t mtu = pState->m_pClient->getMTU() - 3;
+    if (pState->m_value.size() > mtu) {
+        os_mbuf* om = ble_hs_mbuf_from_flat(pState->m_value.data(), pState->m_value.size());
+        return ble_gattc_write_long(pState->m_connHandle, handle, 0, om, NimBLEGattFuture::onWriteCB, pState);
+    }
+
+    pState->m_long = false;
+    return ble_gattc_write_flat(pState->m_connHandle,
+                                handle,
+                                pState->m_value.data(),
+                                pState->m_value.size(),
+                                NimBLEGattFuture::onWriteCB,
+                                pState);
+} // start
+
+/**
+ * @brief Finish an operation, release its waiters and start the next queued operation on its connection.
+ * @details Runs on the NimBLE host task, or in the submitting task if an operation could not be started.
+ */
+void NimBLEGattFuture::complete(State* pState, int rc) {
+    while (pState != nullptr) {
+        State*       pNext    = nullptr;
+        size_t       inFlight = 0;
+        const size_t bearers  = pState->m_pClient->getBearerCount();
+
+        pState->m_pClient->finishRequest(rc, rc == 0 ? pState->m_value.size() : 0, pState->m_startTime);
+
+        ble_npl_hw_enter_critical();
+        State** ppCur = &m_pQueue;
+        while (*ppCur != nullptr && *ppCur != pState) {
+            ppCur = &(*ppCur)->m_pNext;
+        }
+        if (*ppCur != nullptr) {
+            *ppCur = pState->m_pNext;
+        }
+        for (State* pCur = m_pQueue; pCur != nullptr; pCur = pCur->m_pNext) {
+            if (pCur->m_connHandle != pState->m_connHandle) {
+                continue;
+            }
+
+            if (pCur->m_started) {
+                inFlight++;
+            } else if (pNext == nullptr) {
+                pNext = pCur;
+            }
+        }
+        if (pNext != nullptr && inFlight < bearers) {
+            pNext->m_started = true;
+        } else {
+            pNext = nullptr;
+        }
+        ble_npl_hw_exit_critical(0);
+
+        if (rc == 0 && !pState->m_write) {
+            pState->m_value.setTimeStamp();
+            pState->m_pAttr->m_value = pState->m_value;
+        }
+
+        if (rc != 0) {
+            NIMBLE_LOGE(LOG_TAG, "%s failed rc=%d, %s", pState->m_write ? "Write" : "Read", rc, NimBLEUtils::returnCodeToString(rc));
+        }
+
+        std::shared_ptr<State> self = std::move(pState->m_self);
+        pState->m_pNext             = nullptr;
+        pState->m_rc                = rc;
+        pState->m_done.store(true, std::memory_order_release);
+        if (pState->m_semValid) {
+            ble_npl_sem_release(&pState->m_sem);
+        }
+
+        if (pState->m_callback) {
+            pState->m_callback(NimBLEGattFuture(self));
+        }
+
+        pState = nullptr;
+        if (pNext != nullptr) {
+            rc = start(pNext);
+            if (rc != 0) {
+                pState = pNext;
+            }
+        }
+    }
+} // complete
+
+/**
+ * @brief Callback for the read operation.
+ * @return success == 0 or error code.
+ */
+int NimBLEGattFuture::onReadCB(uint16_t conn_handle, const ble_gatt_error* error, ble_gatt_attr* attr, void* arg) {
+    auto pState = static_cast<State*>(arg);
+    int  rc     = error->status;
+
+    if (rc == 0 && attr) {
+        uint16_t data_len = OS_MBUF_PKTLEN(attr->om);
+        if ((pState->m_value.size() + data_len) > BLE_ATT_ATTR_MAX_LEN) {
+            rc = BLE_ATT_ERR_INVALID_ATTR_VALUE_LEN;
+        } else {
+            pState->m_value.append(attr->om->om_data, data_len);
+            if (pState->m_long) {
+                return 0;
+            }
+        }
+    } else if (rc == BLE_HS_EDONE) {
+        rc = 0;
+    } else if (rc == BLE_HS_ATT_ERR(BLE_ATT_ERR_ATTR_NOT_LONG) && pState->m_long) {
+        // Not long-readable, read again with a single request.
+        NIMBLE_LOGI(LOG_TAG, "Attribute not long");
+        pState->m_long = false;
+        pState->m_value.setValue(pState->m_value.data(), 0);
+        rc = ble_gattc_read(conn_handle, pState->m_pAttr->getHandle(), NimBLEGattFuture::onReadCB, pState);
+        if (rc == 0) {
+            return 0;
+        }
+    }
+
+    complete(pState, rc);
+    return rc;
+} // onReadCB
+
+/**
+ * @brief Callback for the write operation.
+ * @return success == 0 or error code.
+ */
+int NimBLEGattFuture::onWriteCB(uint16_t conn_handle, const ble_gatt_error* error, ble_gatt_attr* attr, void* arg) {
+    auto pState = static_cast<State*>(arg);
+    int  rc     = error->status;
+
+    if (rc == BLE_HS_ATT_ERR(BLE_ATT_ERR_ATTR_NOT_LONG) && pState->m_long) {
+        const uint16_t mtu = pState->m_pClient->getMTU() - 3;
+        NIMBLE_LOGE(LOG_TAG, "Long write not supported by peer; Truncating length to %d", mtu);
+        pState->m_long = false;
+        pState->m_value = NimBLEAttValue(pState->m_value.data(), mtu);
+        rc = ble_gattc_write_flat(conn_handle,
+                                  pState->m_pAttr->getHandle(),
+                                  pState->m_value.data(),
+                                  pState->m_value.size(),
+                                  NimBLEGattFuture::onWriteCB,
+                                  pState);
+        if (rc == 0) {
+            return 0;
+        }
+    }
+
+    complete(pState, rc);
+    return 0;
+} // onWriteCB
+
+#endif // CONFIG_BT_ENABLED && CONFIG_BT_NIMBLE_ROLE_CENTRAL
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2020-2025 Ryan Powell <ryan@nable-embedded.io> and
+ * esp-nimble-cpp, NimBLE-Arduino contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NIMBLE_CPP_GATT_FUTURE_H_
+#define NIMBLE_CPP_GATT_FUTURE_H_
+
+#include "nimconfig.h"
+#if CONFIG_BT_ENABLED && CONFIG_BT_NIMBLE_ROLE_CENTRAL
+
+# if defined(CONFIG_NIMBLE_CPP_IDF)
+#  include <host/ble_gatt.h>
+# else
+#  include <nimble/nimble/host/include/host/ble_gatt.h>
+# endif
+
+/****  FIX COMPILATION ****/
+# undef min
+# undef max
+/**************************/
+
+# include "NimBLEAttValue.h"
+
+# include <functional>
+# include <memory>
+
+class NimBLERemoteValueAttribute;
+
+/**
+ * @brief The result of an asynchronous read or write of a remote attribute.
+ * @details Returned by NimBLERemoteValueAttribute::readValueAsync() and writeValueAsync(). The operation
+ * completes on the NimBLE host task, so one task can keep operations on several connections in flight and
+ * collect the results later with wait() or a completion callback.\n
+ * ATT allows only one outstanding request per bearer, so operations on the same connection are queued and
+ * as many are kept in flight as the connection has bearers: one, plus one for each Enhanced ATT (EATT)
+ * bearer if CONFIG_BT_NIMBLE_EATT_CHAN_NUM is set. With several bearers, operations on the same connection
+ * may complete out of order. Operations on different connections run concurrently.
+ * @note The remote attribute must not be deleted while an operation on it is pending.
+ */
+class NimBLEGattFuture {
+  public:
+    /**
+     * @brief Completion callback, called on the NimBLE host task. It must not block.
+     */
+    using Callback = std::function<void(const NimBLEGattFuture& future)>;
+
+    NimBLEGattFuture() = default;
+
+    bool                        isValid() const;
+    bool                        isReady() const;
+    bool                        wait(uint32_t timeout = UINT32_MAX) const;
+    int                         getResult() const;
+    NimBLEAttValue              getValue() const;
+    NimBLERemoteValueAttribute* getAttribute() const;
+
+    static bool waitAll(const NimBLEGattFuture* futures, size_t count, uint32_t timeout = UINT32_MAX);
+
+  private:
+    friend class NimBLERemoteValueAttribute;
+
+    struct State;
+    explicit NimBLEGattFuture(std::shared_ptr<State> state) : m_state{std::move(state)} {}
+
+    static NimBLEGattFuture read(NimBLERemoteValueAttribute* pAttr, const Callback& callback);
+    static NimBLEGattFuture write(NimBLERemoteValueAttribute* pAttr, const uint8_t* data, size_t length, const Callback& callback);
+    static void             submit(State* pState);
+    static int              start(State* pState);
+    static void             complete(State* pState, int rc);
+    static int              onReadCB(uint16_t conn_handle, const ble_gatt_error* error, ble_gatt_attr* attr, void* arg);
+    static int              onWriteCB(uint16_t conn_handle, const ble_gatt_error* error, ble_gatt_attr* attr, void* arg);
+
+    static State* m_pQueue;
+
+    std::shared_ptr<State> m_state{};
+};
+
+#endif // CONFIG_BT_ENABLED && CONFIG_BT_NIMBLE_ROLE_CENTRAL
+#endif // NIMBLE_CPP_GATT_FUTURE_H_
@@ -11,8 +11,10 @@
 
 # if defined(CONFIG_NIMBLE_CPP_IDF)
 #  include "host/ble_gap.h"
+#  include "nimble/nimble_port.h"
 # else
 #  include "nimble/nimble/host/include/host/ble_gap.h"
+#  include "nimble/porting/nimble/include/nimble/nimble_port.h"
 # endif
 
 // L2CAP buffer block size
@@ -31,10 +33,14 @@ NimBLEL2CAPChannel::NimBLEL2CAPChannel(uint16_t psm, uint16_t mtu, NimBLEL2CAPCh
     assert(callbacks);      // fail here, if no callbacks are given
     assert(setupMemPool()); // fail here, if the memory pool could not be setup
 
+    ble_npl_event_init(&txEvent, NimBLEL2CAPChannel::handleTxEvent, this);
+
     NIMBLE_LOGI(LOG_TAG, "L2CAP COC 0x%04X initialized w/ L2CAP MTU %i", this->psm, this->mtu);
 };
 
 NimBLEL2CAPChannel::~NimBLEL2CAPChannel() {
+    ble_npl_eventq_remove(nimble_port_get_dflt_eventq(), &txEvent);
+    flushTxQueue(BLE_HS_ENOTCONN);
     teardownMemPool();
 
     NIMBLE_LOGI(LOG_TAG, "L2CAP COC 0x%04X shutdown and freed.", this->psm);
@@ -62,12 +68,6 @@ bool NimBLEL2CAPChannel::setupMemPool() {
         return false;
     }
 
-    this->receiveBuffer = (uint8_t*)malloc(mtu);
-    if (!this->receiveBuffer) {
-        NIMBLE_LOGE(LOG_TAG, "Can't malloc receive buffer: %d, %s", errno, strerror(errno));
-        return false;
-    }
-
     return true;
 }
 
@@ -75,16 +75,42 @@ void NimBLEL2CAPChannel::teardownMemPool() {
     if (this->callbacks) {
         delete this->callbacks;
     }
-    if (this->receiveBuffer) {
-        free(this->receiveBuffer);
-    }
     if (_coc_memory) {
         free(_coc_memory);
     }
 }
 
-int NimBLEL2CAPChannel::writeFragment(std::vector<uint8_t>::const_iterator begin, std::vector<uint8_t>::const_iterator end) {
-    auto toSend = end - begin;
+uint16_t NimBLEL2CAPChannel::negotiatedMTU() const {
+    struct ble_l2cap_chan_info info;
+    ble_l2cap_get_chan_info(channel, &info);
+    // Take the minimum of our and peer MTU
+    return info.peer_coc_mtu < info.our_coc_mtu ? info.peer_coc_mtu : info.our_coc_mtu;
+}
+
+int NimBLEL2CAPChannel::writeFragment(const uint8_t* data, size_t length) {
+    if (length > negotiatedMTU()) {
+        return -BLE_HS_EBADDATA;
+    }
+
+    auto txd = os_mbuf_get_pkthdr(&_coc_mbuf_pool, 0);
+    if (!txd) {
+        NIMBLE_LOGE(LOG_TAG, "Can't os_mbuf_get_pkthdr.");
+        return -BLE_HS_ENOMEM;
+    }
+    auto append = os_mbuf_append(txd, data, length);
+    if (append != 0) {
+        NIMBLE_LOGE(LOG_TAG, "Can't os_mbuf_append: %d", append);
+        os_mbuf_free_chain(txd);
+        return append;
+    }
+
+    // sendSDU retries with the same SDU while the host is busy.
+    return sendSDU(txd);
+}
+
+int NimBLEL2CAPChannel::sendSDU(struct os_mbuf* sdu) {
+    const auto toSend = OS_MBUF_PKTLEN(sdu);
+    (void)toSend; // only used for logging
 
     if (stalled) {
         NIMBLE_LOGD(LOG_TAG, "L2CAP Channel waiting for unstall...");
@@ -96,33 +122,16 @@ int NimBLEL2CAPChannel::writeFragment(std::vector<uint8_t>::const_iterator begin
         NIMBLE_LOGD(LOG_TAG, "L2CAP Channel unstalled!");
     }
 
-    struct ble_l2cap_chan_info info;
-    ble_l2cap_get_chan_info(channel, &info);
-    // Take the minimum of our and peer MTU
-    auto mtu = info.peer_coc_mtu < info.our_coc_mtu ? info.peer_coc_mtu : info.our_coc_mtu;
-
-    if (toSend > mtu) {
-        return -BLE_HS_EBADDATA;
-    }
-
     auto retries = RetryCounter;
 
     while (retries--) {
-        auto txd = os_mbuf_get_pkthdr(&_coc_mbuf_pool, 0);
-        if (!txd) {
-            NIMBLE_LOGE(LOG_TAG, "Can't os_mbuf_get_pkthdr.");
-            return -BLE_HS_ENOMEM;
-        }
-        auto append = os_mbuf_append(txd, &(*begin), toSend);
-        if (append != 0) {
-            NIMBLE_LOGE(LOG_TAG, "Can't os_mbuf_append: %d", append);
-            return append;
-        }
-
-        auto res = ble_l2cap_send(channel, txd);
+        auto res = ble_l2cap_send(channel, sdu);
         switch (res) {
             case 0:
                 NIMBLE_LOGD(LOG_TAG, "L2CAP COC 0x%04X sent %d bytes.", this->psm, toSend);
+                if (txCount) {
+                    ble_npl_eventq_put(nimble_port_get_dflt_eventq(), &txEvent);
+                }
                 return 0;
 
             case BLE_HS_ESTALLED:
@@ -132,21 +141,118 @@ int NimBLEL2CAPChannel::writeFragment(std::vector<uint8_t>::const_iterator begin
                             "ble_l2cap_send returned BLE_HS_ESTALLED. Next send will wait for unstalled event...");
                 return 0;
 
-            case BLE_HS_ENOMEM:
-            case BLE_HS_EAGAIN:
             case BLE_HS_EBUSY:
+                // The previous SDU is still queued, the host did not take this one.
                 NIMBLE_LOGD(LOG_TAG, "ble_l2cap_send returned %d. Retrying shortly...", res);
-                os_mbuf_free_chain(txd);
                 ble_npl_time_delay(ble_npl_time_ms_to_ticks32(RetryTimeout));
                 continue;
 
+            case BLE_HS_EBADDATA:
+                // Rejected before the host took the SDU.
+                NIMBLE_LOGE(LOG_TAG, "ble_l2cap_send failed: SDU of %d bytes exceeds the MTU", toSend);
+                os_mbuf_free_chain(sdu);
+                return res;
+
             default:
+                // The host has freed the SDU, possibly after sending a part of it, so it is not retried.
                 NIMBLE_LOGE(LOG_TAG, "ble_l2cap_send failed: %d", res);
                 return res;
         }
     }
+
     NIMBLE_LOGE(LOG_TAG, "Retries exhausted, dropping %d bytes to send.", toSend);
-    return -BLE_HS_EREJECT;
+    os_mbuf_free_chain(sdu);
+    return BLE_HS_EBUSY;
+}
+
+size_t NimBLEL2CAPChannel::poolBlocks(size_t length) {
+    return CEIL_DIVIDE(length + sizeof(struct os_mbuf_pkthdr), L2CAP_BUF_BLOCK_SIZE - sizeof(struct os_mbuf));
+}
+
+bool NimBLEL2CAPChannel::enqueueSDU(struct os_mbuf* sdu) {
+    bool queued = false;
+
+    ble_npl_hw_enter_critical();
+    if (txCount < CONFIG_NIMBLE_CPP_L2CAP_TX_QUEUE_LEN) {
+        txQueue[(txHead + txCount) % CONFIG_NIMBLE_CPP_L2CAP_TX_QUEUE_LEN] = sdu;
+        txCount++;
+        queued = true;
+    }
+    ble_npl_hw_exit_critical(0);
+
+    if (queued) {
+        // Does nothing if the event is already pending.
+        ble_npl_eventq_put(nimble_port_get_dflt_eventq(), &txEvent);
+    }
+    return queued;
+}
+
+void NimBLEL2CAPChannel::pumpTxQueue() {
+    while (this->channel && !txInFlight) {
+        ble_npl_hw_enter_critical();
+        struct os_mbuf* sdu = txCount ? txQueue[txHead] : nullptr;
+        ble_npl_hw_exit_critical(0);
+        if (!sdu) {
+            return;
+        }
+
+        auto res = ble_l2cap_send(channel, sdu);
+        if (res == BLE_HS_EBUSY) {
+            // The host still holds an SDU of a blocking write, sendSDU schedules us again.
+            NIMBLE_LOGD(LOG_TAG, "L2CAP COC 0x%04X busy, %d SDUs queued.", psm, txCount);
+            return;
+        }
+
+        if (res == BLE_HS_EBADDATA) {
+            os_mbuf_free_chain(sdu);
+        }
+
+        ble_npl_hw_enter_critical();
+        txHead = (txHead + 1) % CONFIG_NIMBLE_CPP_L2CAP_TX_QUEUE_LEN;
+        txCount--;
+        ble_npl_hw_exit_critical(0);
+
+        if (res == BLE_HS_ESTALLED) {
+            // Partially sent, completes with the unstalled event.
+            txInFlight = true;
+            return;
+        }
+
+        if (res != 0) {
+            NIMBLE_LOGE(LOG_TAG, "ble_l2cap_send failed: %d", res);
+        }
+        callbacks->onWriteComplete(this, res);
+    }
+}
+
+void NimBLEL2CAPChannel::flushTxQueue(int status) {
+    if (txInFlight) {
+        // The host frees the SDU it holds when the channel is released.
+        txInFlight = false;
+        callbacks->onWriteComplete(this, status);
+    }
+
+    for (;;) {
+        ble_npl_hw_enter_critical();
+        struct os_mbuf* sdu = nullptr;
+        if (txCount) {
+            sdu    = txQueue[txHead];
+            txHead = (txHead + 1) % CONFIG_NIMBLE_CPP_L2CAP_TX_QUEUE_LEN;
+            txCount--;
+        }
+        ble_npl_hw_exit_critical(0);
+
+        if (!sdu) {
+            return;
+        }
+        os_mbuf_free_chain(sdu);
+        callbacks->onWriteComplete(this, status);
+    }
+}
+
+/* STATIC */
+void NimBLEL2CAPChannel::handleTxEvent(struct ble_npl_event* event) {
+    static_cast<NimBLEL2CAPChannel*>(ble_npl_event_get_arg(event))->pumpTxQueue();
 }
 
 # if CONFIG_BT_NIMBLE_ROLE_CENTRAL
@@ -177,26 +283,97 @@ NimBLEL2CAPChannel* NimBLEL2CAPChannel::connect(NimBLEClient*                cli
 # endif // CONFIG_BT_NIMBLE_ROLE_CENTRAL
 
 bool NimBLEL2CAPChannel::write(const std::vector<uint8_t>& bytes) {
+    return write(bytes.data(), bytes.size());
+}
+
+bool NimBLEL2CAPChannel::write(const uint8_t* data, size_t length) {
     if (!this->channel) {
         NIMBLE_LOGW(LOG_TAG, "L2CAP Channel not open");
         return false;
     }
 
-    struct ble_l2cap_chan_info info;
-    ble_l2cap_get_chan_info(channel, &info);
-    auto mtu = info.peer_coc_mtu < info.our_coc_mtu ? info.peer_coc_mtu : info.our_coc_mtu;
+    const size_t mtu = negotiatedMTU();
 
-    auto start = bytes.begin();
-    while (start != bytes.end()) {
-        auto end = start + mtu < bytes.end() ? start + mtu : bytes.end();
-        if (writeFragment(start, end) < 0) {
+    while (length > 0) {
+        const size_t toSend = length < mtu ? length : mtu;
+        if (writeFragment(data, toSend) != 0) {
             return false;
         }
-        start = end;
+        data   += toSend;
+        length -= toSend;
+    }
+    return true;
+}
+
+bool NimBLEL2CAPChannel::write(struct os_mbuf* sdu) {
+    if (!sdu) {
+        return false;
+    }
+
+    if (!this->channel) {
+        NIMBLE_LOGW(LOG_TAG, "L2CAP Channel not open");
+        os_mbuf_free_chain(sdu);
+        return false;
+    }
+
+    if (OS_MBUF_PKTLEN(sdu) > negotiatedMTU()) {
+        NIMBLE_LOGE(LOG_TAG, "SDU of %d bytes exceeds the MTU of %d", OS_MBUF_PKTLEN(sdu), negotiatedMTU());
+        os_mbuf_free_chain(sdu);
+        return false;
+    }
+
+    return sendSDU(sdu) == 0;
+}
+
+bool NimBLEL2CAPChannel::trySend(const uint8_t* data, size_t length) {
+    if (!this->channel || length > negotiatedMTU()) {
+        return false;
+    }
+
+    // Keep enough blocks for receiving an SDU, the host allocates those from our pool too.
+    if (_coc_mempool.mp_num_free < poolBlocks(length) + poolBlocks(mtu)) {
+        return false;
+    }
+
+    auto txd = os_mbuf_get_pkthdr(&_coc_mbuf_pool, 0);
+    if (!txd) {
+        return false;
+    }
+    if (os_mbuf_append(txd, data, length) != 0 || !enqueueSDU(txd)) {
+        os_mbuf_free_chain(txd);
+        return false;
     }
     return true;
 }
 
+bool NimBLEL2CAPChannel::trySend(struct os_mbuf* sdu) {
+    if (!sdu || !this->channel || OS_MBUF_PKTLEN(sdu) > negotiatedMTU()) {
+        return false;
+    }
+    return enqueueSDU(sdu);
+}
+
+size_t NimBLEL2CAPChannel::getTxQueueCount() const {
+    return txCount + (txInFlight ? 1 : 0);
+}
+
+size_t NimBLEL2CAPSduView::copy(size_t offset, uint8_t* dst, size_t length) const {
+    const size_t total = size();
+    if (offset >= total) {
+        return 0;
+    }
+    if (length > total - offset) {
+        length = total - offset;
+    }
+    return os_mbuf_copydata(sdu, offset, length, dst) == 0 ? length : 0;
+}
+
+void NimBLEL2CAPChannelCallbacks::onRead(NimBLEL2CAPChannel* channel, const NimBLEL2CAPSduView& sdu) {
+    std::vector<uint8_t> data(sdu.size());
+    sdu.copy(0, data.data(), data.size());
+    onRead(channel, data);
+}
+
 // private
 int NimBLEL2CAPChannel::handleConnectionEvent(struct ble_l2cap_event* event) {
     channel = event->connect.chan;
@@ -239,16 +416,13 @@ int NimBLEL2CAPChannel::handleDataReceivedEvent(struct ble_l2cap_event* event) {
     int rx_len = (int)OS_MBUF_PKTLEN(rxd);
     assert(rx_len <= (int)mtu);
 
-    int res = os_mbuf_copydata(rxd, 0, rx_len, receiveBuffer);
-    assert(res == 0);
-
     NIMBLE_LOGD(LOG_TAG, "L2CAP COC 0x%04X received %d bytes.", psm, rx_len);
 
-    res = os_mbuf_free_chain(rxd);
-    assert(res == 0);
+    // The SDU is handed to the callback in place, it is freed afterwards.
+    callbacks->onRead(this, NimBLEL2CAPSduView(rxd));
 
-    std::vector<uint8_t> incomingData(receiveBuffer, receiveBuffer + rx_len);
-    callbacks->onRead(this, incomingData);
+    int res = os_mbuf_free_chain(rxd);
+    assert(res == 0);
 
     struct os_mbuf* next = os_mbuf_get_pkthdr(&_coc_mbuf_pool, 0);
     assert(next != NULL);
@@ -265,12 +439,20 @@ int NimBLEL2CAPChannel::handleTxUnstalledEvent(struct ble_l2cap_event* event) {
     }
 
     NIMBLE_LOGI(LOG_TAG, "L2CAP COC 0x%04X transmit unstalled.", psm);
+
+    if (txInFlight) {
+        txInFlight = false;
+        callbacks->onWriteComplete(this, event->tx_unstalled.status);
+    }
+    // Called in the host task, the next SDU goes out without waiting for an application task.
+    pumpTxQueue();
     return 0;
 }
 
 int NimBLEL2CAPChannel::handleDisconnectionEvent(struct ble_l2cap_event* event) {
     NIMBLE_LOGI(LOG_TAG, "L2CAP COC 0x%04X disconnected.", psm);
     channel = NULL;
+    flushTxQueue(BLE_HS_ENOTCONN);
     callbacks->onDisconnect(this);
     return 0;
 }
@@ -17,6 +17,12 @@
 #  include "nimble/porting/nimble/include/os/os_mbuf.h"
 # endif
 
+# if !defined(CONFIG_NIMBLE_CPP_L2CAP_TX_QUEUE_LEN)
+#  define CONFIG_NIMBLE_CPP_L2CAP_TX_QUEUE_LEN 8
+# elif CONFIG_NIMBLE_CPP_L2CAP_TX_QUEUE_LEN < 1 || CONFIG_NIMBLE_CPP_L2CAP_TX_QUEUE_LEN > 255
+#  error CONFIG_NIMBLE_CPP_L2CAP_TX_QUEUE_LEN must be in the range 1 : 255
+# endif
+
 /****  FIX COMPILATION ****/
 # undef min
 # undef max
@@ -29,6 +35,43 @@ class NimBLEClient;
 class NimBLEL2CAPChannelCallbacks;
 struct NimBLETaskData;
 
+/**
+ * @brief Read-only view of a received SDU.
+ *
+ * The SDU stays in the mbuf chain it was received in, nothing is copied until the
+ * view is read. The view is only valid during NimBLEL2CAPChannelCallbacks::onRead.
+ */
+class NimBLEL2CAPSduView {
+  public:
+    explicit NimBLEL2CAPSduView(const struct os_mbuf* sdu) : sdu(sdu) {}
+
+    /// @return The length of the SDU in bytes.
+    size_t size() const { return OS_MBUF_PKTLEN(sdu); }
+
+    /// @brief Copy part of the SDU.
+    /// @param[in] offset The offset in the SDU to start copying from.
+    /// @param[out] dst The buffer to copy to.
+    /// @param[in] length The maximum number of bytes to copy.
+    /// @return The number of bytes copied.
+    size_t copy(size_t offset, uint8_t* dst, size_t length) const;
+
+    /// @brief Call `fn(const uint8_t* data, size_t length)` for each segment of the SDU, in order.
+    template <typename F>
+    void forEachSegment(F fn) const {
+        for (const struct os_mbuf* om = sdu; om != nullptr; om = SLIST_NEXT(om, om_next)) {
+            if (om->om_len) {
+                fn(om->om_data, om->om_len);
+            }
+        }
+    }
+
+    /// @return The first mbuf of the chain, which holds the packet header.
+    const struct os_mbuf* mbuf() const { return sdu; }
+
+  private:
+    const struct os_mbuf* sdu;
+};
+
 /**
  * @brief Encapsulates a L2CAP channel.
  *
@@ -56,6 +99,45 @@ class NimBLEL2CAPChannel {
     /// NOTE: This function will block until the data has been sent or an error occurred.
     bool write(const std::vector<uint8_t>& bytes);
 
+    /// @brief Write data to the channel.
+    ///
+    /// Like write(const std::vector<uint8_t>&), each byte is copied once into the channel's
+    /// buffer pool and not into an intermediate container.
+    bool write(const uint8_t* data, size_t length);
+
+    /// @brief Write an SDU that is already held in an mbuf chain, without copying it.
+    ///
+    /// The mbuf must be a packet header mbuf, e.g. from `os_msys_get_pkthdr`, and must not
+    /// exceed the negotiated MTU. The channel takes ownership of the chain in every case,
+    /// it is freed once sent or if the SDU can't be sent.
+    /// @return true on success, after the data has been queued for sending.
+    ///
+    /// NOTE: This function will block while the channel is stalled.
+    bool write(struct os_mbuf* sdu);
+
+    /// @brief Queue data as one SDU for sending, without blocking.
+    ///
+    /// The data is copied once into the channel's buffer pool. Queued SDUs are handed to the
+    /// host from the NimBLE host task as soon as the previous SDU has been sent, so the link
+    /// does not idle between SDUs while the peer has credits.
+    /// NimBLEL2CAPChannelCallbacks::onWriteComplete is called for every queued SDU.
+    /// @return true if the SDU has been queued.
+    /// @return false, if the channel is not connected, the data exceeds the negotiated MTU,
+    /// the queue is full or the buffer pool can't hold the SDU right now. Retry after the next
+    /// onWriteComplete in that case.
+    ///
+    /// NOTE: Don't mix this with the blocking `write` functions on the same channel.
+    bool trySend(const uint8_t* data, size_t length);
+
+    /// @brief Queue an SDU that is already held in an mbuf chain, without copying or blocking.
+    ///
+    /// Like trySend(const uint8_t*, size_t). The channel takes ownership of the chain only if
+    /// it has been queued, otherwise it stays with the caller.
+    bool trySend(struct os_mbuf* sdu);
+
+    /// @return The number of SDUs queued with trySend that have not completed yet.
+    size_t getTxQueueCount() const;
+
     /// @return True, if the channel is connected. False, otherwise.
     bool isConnected() const { return !!channel; }
 
@@ -77,7 +159,6 @@ class NimBLEL2CAPChannel {
     const uint16_t               mtu; // The requested (local) MTU of the channel, might be larger than negotiated MTU
     struct ble_l2cap_chan*       channel = nullptr;
     NimBLEL2CAPChannelCallbacks* callbacks;
-    uint8_t*                     receiveBuffer = nullptr; // buffers a full (local) MTU
 
     // NimBLE memory pool
     void*               _coc_memory = nullptr;
@@ -88,12 +169,41 @@ class NimBLEL2CAPChannel {
     std::atomic<bool> stalled{false};
     NimBLETaskData*   m_pTaskData{nullptr};
 
+    // Queue of trySend, only sent from the host task
+    struct os_mbuf*      txQueue[CONFIG_NIMBLE_CPP_L2CAP_TX_QUEUE_LEN];
+    uint8_t              txHead     = 0;
+    uint8_t              txCount    = 0;
+    bool                 txInFlight = false; // The front SDU is with the host and waiting for credits
+    struct ble_npl_event txEvent;
+
     // Allocate / deallocate NimBLE memory pool
     bool setupMemPool();
     void teardownMemPool();
 
+    // Returns the negotiated MTU, the minimum of our and peer MTU.
+    uint16_t negotiatedMTU() const;
+
     // Writes data up to the size of the negotiated MTU to the channel.
-    int writeFragment(std::vector<uint8_t>::const_iterator begin, std::vector<uint8_t>::const_iterator end);
+    int writeFragment(const uint8_t* data, size_t length);
+
+    // Sends an SDU, waiting for the channel to unstall first and retrying it while the host is busy.
+    // Always consumes the SDU.
+    int sendSDU(struct os_mbuf* sdu);
+
+    // Returns the number of pool blocks an SDU of the given length occupies.
+    static size_t poolBlocks(size_t length);
+
+    // Adds an SDU to the queue of trySend and schedules sending it.
+    bool enqueueSDU(struct os_mbuf* sdu);
+
+    // Hands queued SDUs to the host until it stalls. Must run in the host task.
+    void pumpTxQueue();
+
+    // Frees queued SDUs, reporting them as failed.
+    void flushTxQueue(int status);
+
+    // Host task event to run pumpTxQueue
+    static void handleTxEvent(struct ble_npl_event* event);
 
     // L2CAP event handler
     static int handleL2capEvent(struct ble_l2cap_event* event, void* arg);
@@ -117,6 +227,14 @@ class NimBLEL2CAPChannelCallbacks {
     /// Called when data has been read from the channel.
     /// Default implementation does nothing.
     virtual void onRead(NimBLEL2CAPChannel* channel, std::vector<uint8_t>& data) {};
+    /// Called when an SDU has been received, with a view of the SDU in the receive buffer.
+    /// Override this instead of the `std::vector` variant to avoid copying the data.
+    /// Default implementation copies the SDU into a vector and calls the `std::vector` variant.
+    virtual void onRead(NimBLEL2CAPChannel* channel, const NimBLEL2CAPSduView& sdu);
+    /// Called when an SDU queued with trySend has been completely handed to the controller (status 0),
+    /// or has been dropped (status is the host error code).
+    /// Default implementation does nothing.
+    virtual void onWriteComplete(NimBLEL2CAPChannel* channel, int status) {};
     /// Called after the channel has been disconnected.
     /// Default implementation does nothing.
     virtual void onDisconnect(NimBLEL2CAPChannel* channel) {};
@@ -173,6 +173,29 @@
 
 # endif  /* CONFIG_NIMBLE_CPP_IDF */
 
+# if CONFIG_NIMBLE_CPP_LOG_DEFERRED
+#  include "NimBLELogDeferred.h"
+#  undef NIMBLE_LOGD
+#  undef NIMBLE_LOGI
+#  undef NIMBLE_LOGW
+#  undef NIMBLE_LOGE
+
+#  define NIMBLE_CPP_LOG_WRITE_DEFERRED(level, letter, tag, format, ...)                                       \
+      do {                                                                                                     \
+        if (CONFIG_NIMBLE_CPP_LOG_LEVEL >= level) NimBLELogDeferred::write(letter, tag, format, ##__VA_ARGS__); \
+      } while (0)
+
+#  define NIMBLE_LOGD(tag, format, ...) NIMBLE_CPP_LOG_WRITE_DEFERRED(4, 'D', tag, format, ##__VA_ARGS__)
+#  define NIMBLE_LOGI(tag, format, ...) NIMBLE_CPP_LOG_WRITE_DEFERRED(3, 'I', tag, format, ##__VA_ARGS__)
+#  define NIMBLE_LOGW(tag, format, ...) NIMBLE_CPP_LOG_WRITE_DEFERRED(2, 'W', tag, format, ##__VA_ARGS__)
+#  define NIMBLE_LOGE(tag, format, ...) NIMBLE_CPP_LOG_WRITE_DEFERRED(1, 'E', tag, format, ##__VA_ARGS__)
+
+// Addresses are recorded as 7 bytes and only formatted when the message is printed.
+#  define NIMBLE_LOG_ADDR(addr) (addr)
+# else
+#  define NIMBLE_LOG_ADDR(addr) (addr).toString().c_str()
+# endif
+
 #  define NIMBLE_LOGD_IF(cond, tag, format, ...) { if (cond) { NIMBLE_LOGD(tag, format, ##__VA_ARGS__); }}
 #  define NIMBLE_LOGI_IF(cond, tag, format, ...) { if (cond) { NIMBLE_LOGI(tag, format, ##__VA_ARGS__); }}
 #  define NIMBLE_LOGW_IF(cond, tag, format, ...) { if (cond) { NIMBLE_LOGW(tag, format, ##__VA_ARGS__); }}
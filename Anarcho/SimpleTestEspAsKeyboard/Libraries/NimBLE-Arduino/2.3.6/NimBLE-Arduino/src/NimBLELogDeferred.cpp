@@ -0,0 +1,166 @@
+/*
+ * Copyright 2020-2025 Ryan Powell <ryan@nable-embedded.io> and
+ * esp-nimble-cpp, NimBLE-Arduino contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NimBLELogDeferred.h"
+#if CONFIG_BT_ENABLED && CONFIG_NIMBLE_CPP_LOG_DEFERRED
+
+# include "NimBLELog.h"
+
+# include "esp_log.h"
+# include "freertos/FreeRTOS.h"
+# include "freertos/task.h"
+
+# include <algorithm>
+# include <atomic>
+# include <string.h>
+
+namespace {
+struct LogRing {
+    uint8_t               buf[CONFIG_NIMBLE_CPP_LOG_DEFERRED];
+    std::atomic<uint32_t> head{0}; // Written only by the core that owns the ring.
+    std::atomic<uint32_t> tail{0}; // Written only by the consumer.
+    uint32_t              dropped{0};
+};
+
+LogRing          logRings[portNUM_PROCESSORS];
+TaskHandle_t     logTask = nullptr;
+std::atomic_flag logConsuming = ATOMIC_FLAG_INIT;
+uint32_t         logDroppedReported = 0;
+} // namespace
+
+/**
+ * @brief Append a record to the ring of the calling core.
+ * @param [in] rec The record, the timestamp is set here.
+ */
+void NimBLELogDeferred::commit(uint8_t* rec) {
+    NimBLELogRecord::setTimestamp(rec, esp_log_timestamp());
+    const uint32_t len = rec[0];
+
+    // Masking the interrupts of this core makes it the single producer of its ring.
+    const uint32_t irq  = portSET_INTERRUPT_MASK_FROM_ISR();
+    LogRing&       ring = logRings[xPortGetCoreID()];
+    const uint32_t head = ring.head.load(std::memory_order_relaxed);
+    if (sizeof(ring.buf) - (head - ring.tail.load(std::memory_order_acquire)) < len) {
+        ring.dropped++;
+    } else {
+        const uint32_t offset = head % sizeof(ring.buf);
+        const uint32_t first  = std::min<uint32_t>(len, sizeof(ring.buf) - offset);
+        memcpy(ring.buf + offset, rec, first);
+        memcpy(ring.buf, rec + first, len - first);
+        ring.head.store(head + len, std::memory_order_release);
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(irq);
+} // commit
+
+/**
+ * @brief Format and print the recorded messages.
+ * @return The number of messages printed.
+ * @details Called periodically by the log task, can also be called to print the pending messages
+ * immediately, e.g. before entering deep sleep. Returns 0 if another task is printing already.
+ */
+size_t NimBLELogDeferred::flush() {
+    if (logConsuming.test_and_set(std::memory_order_acquire)) {
+        return 0;
+    }
+
+    size_t  count = 0;
+    uint8_t rec[NimBLELogRecord::MAX_SIZE];
+    char    line[192];
+    for (auto& ring : logRings) {
+        uint32_t tail = ring.tail.load(std::memory_order_relaxed);
+        while (tail != ring.head.load(std::memory_order_acquire)) {
+            const uint32_t offset = tail % sizeof(ring.buf);
+            const uint32_t len    = ring.buf[offset];
+            const uint32_t first  = std::min<uint32_t>(len, sizeof(ring.buf) - offset);
+            memcpy(rec, ring.buf + offset, first);
+            memcpy(rec + first, ring.buf, len - first);
+            tail += len;
+            ring.tail.store(tail, std::memory_order_release);
+
+# ifdef CONFIG_NIMBLE_CPP_ADDR_FMT_UPPERCASE
+            const bool upperCase = true;
+# else
+            const bool upperCase = false;
+# endif
+# ifdef CONFIG_NIMBLE_CPP_ADDR_FMT_EXCLUDE_DELIMITER
+            const char* delimiter = "";
+# else
+            const char* delimiter = ":";
+# endif
+            NimBLELogRecord::format(rec, line, sizeof(line), upperCase, delimiter);
+            const char  level = NimBLELogRecord::getLevel(rec);
+            const char* tag   = NimBLELogRecord::getTag(rec);
+# if defined(CONFIG_NIMBLE_CPP_IDF)
+            const esp_log_level_t espLevel = level == 'E'   ? ESP_LOG_ERROR
+                                             : level == 'W' ? ESP_LOG_WARN
+                                             : level == 'I' ? ESP_LOG_INFO
+                                                            : ESP_LOG_DEBUG;
+            esp_log_write(espLevel, tag, "%c (%lu) %s: %s\n", level, (unsigned long)NimBLELogRecord::getTimestamp(rec), tag, line);
+# else
+            console_printf("%c %s: %s\n", level, tag, line);
+# endif
+            count++;
+        }
+    }
+
+    const uint32_t dropped = getDroppedCount();
+    if (dropped != logDroppedReported) {
+        console_printf("W NimBLELog: %lu log messages dropped\n", (unsigned long)(dropped - logDroppedReported));
+        logDroppedReported = dropped;
+    }
+
+    logConsuming.clear(std::memory_order_release);
+    return count;
+} // flush
+
+/**
+ * @brief Get the number of messages dropped because a ring was full.
+ */
+uint32_t NimBLELogDeferred::getDroppedCount() {
+    uint32_t dropped = 0;
+    for (const auto& ring : logRings) {
+        dropped += ring.dropped;
+    }
+
+    return dropped;
+} // getDroppedCount
+
+/**
+ * @brief Task printing the recorded messages.
+ */
+void NimBLELogDeferred::task(void* arg) {
+    for (;;) {
+        flush();
+        vTaskDelay(pdMS_TO_TICKS(20));
+    }
+} // task
+
+/**
+ * @brief Start the task that prints the recorded messages, called by NimBLEDevice::init.
+ * @param [in] priority The task priority, below the NimBLE host task.
+ * @param [in] stackSize The task stack size in bytes.
+ * @return True if the task is running.
+ */
+bool NimBLELogDeferred::start(uint32_t priority, uint32_t stackSize) {
+    if (logTask != nullptr) {
+        return true;
+    }
+
+    return xTaskCreate(task, "nimble_log", stackSize, nullptr, priority, &logTask) == pdPASS;
+} // start
+
+#endif // CONFIG_BT_ENABLED && CONFIG_NIMBLE_CPP_LOG_DEFERRED
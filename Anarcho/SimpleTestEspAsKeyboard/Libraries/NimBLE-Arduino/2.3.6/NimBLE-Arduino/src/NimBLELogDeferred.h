@@ -0,0 +1,68 @@
+/*
+ * Copyright 2020-2025 Ryan Powell <ryan@nable-embedded.io> and
+ * esp-nimble-cpp, NimBLE-Arduino contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NIMBLE_CPP_LOG_DEFERRED_H_
+#define NIMBLE_CPP_LOG_DEFERRED_H_
+
+#include "nimconfig.h"
+#if CONFIG_BT_ENABLED && CONFIG_NIMBLE_CPP_LOG_DEFERRED
+
+# ifndef ESP_PLATFORM
+#  error CONFIG_NIMBLE_CPP_LOG_DEFERRED is only supported on ESP32
+# endif
+
+# if CONFIG_NIMBLE_CPP_LOG_DEFERRED < 256 || CONFIG_NIMBLE_CPP_LOG_DEFERRED > 32768
+#  error CONFIG_NIMBLE_CPP_LOG_DEFERRED out of range; Range = 256 : 32768
+# endif
+
+# include "NimBLELogRecord.h"
+
+/**
+ * @brief Deferred backend of the NIMBLE_LOGx macros.
+ * @details A log call encodes the format string pointer and the raw arguments with NimBLELogRecord and
+ * appends the record to the ring of the calling core. Nothing is formatted or printed by the caller,
+ * a low priority task started by NimBLEDevice::init formats and prints the records.
+ * Each core has its own ring and only masks its own interrupts while appending, so the cores never
+ * wait on each other. Records that do not fit in a full ring are dropped and counted.
+ */
+class NimBLELogDeferred {
+  public:
+    /**
+     * @brief Record a log message.
+     * @param [in] level The level letter, 'E', 'W', 'I' or 'D'.
+     * @param [in] tag The log tag, a string literal.
+     * @param [in] format The printf style format string, a string literal.
+     * @param [in] args The arguments, see NimBLELogRecord.
+     */
+    template <typename... Args>
+    static void write(char level, const char* tag, const char* format, const Args&... args) {
+        uint8_t rec[NimBLELogRecord::MAX_SIZE];
+        NimBLELogRecord::encode(rec, level, tag, format, args...);
+        commit(rec);
+    }
+
+    static bool     start(uint32_t priority = 1, uint32_t stackSize = 3072);
+    static size_t   flush();
+    static uint32_t getDroppedCount();
+
+  private:
+    static void commit(uint8_t* rec);
+    static void task(void* arg);
+};
+
+#endif // CONFIG_BT_ENABLED && CONFIG_NIMBLE_CPP_LOG_DEFERRED
+#endif // NIMBLE_CPP_LOG_DEFERRED_H_
@@ -0,0 +1,212 @@
+/*
+ * Copyright 2020-2025 Ryan Powell <ryan@nable-embedded.io> and
+ * esp-nimble-cpp, NimBLE-Arduino contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NimBLELogRecord.h"
+
+#include <stdio.h>
+
+/**
+ * @brief Set the timestamp of a record.
+ * @param [in] rec The record.
+ * @param [in] timestamp The timestamp in milliseconds.
+ */
+void NimBLELogRecord::setTimestamp(uint8_t* rec, uint32_t timestamp) {
+    memcpy(rec + 4, &timestamp, sizeof(timestamp));
+} // setTimestamp
+
+/**
+ * @brief Get the timestamp of a record in milliseconds.
+ */
+uint32_t NimBLELogRecord::getTimestamp(const uint8_t* rec) {
+    uint32_t timestamp;
+    memcpy(&timestamp, rec + 4, sizeof(timestamp));
+    return timestamp;
+} // getTimestamp
+
+/**
+ * @brief Get the level letter of a record.
+ */
+char NimBLELogRecord::getLevel(const uint8_t* rec) {
+    return static_cast<char>(rec[1]);
+} // getLevel
+
+/**
+ * @brief Get the tag of a record.
+ */
+const char* NimBLELogRecord::getTag(const uint8_t* rec) {
+    const char* tag;
+    memcpy(&tag, rec + TAG_OFFSET, sizeof(tag));
+    return tag;
+} // getTag
+
+/**
+ * @brief Format the message of a record, as printf would have done with the original arguments.
+ * @param [in] rec The record.
+ * @param [out] out The text buffer, always null terminated.
+ * @param [in] size The size of the text buffer.
+ * @param [in] upperCaseAddr Format addresses with upper case hex digits.
+ * @param [in] addrDelimiter The delimiter between the address bytes.
+ * @return The length of the text, truncated to the buffer size.
+ * @details Conversions without a matching argument are replaced by '?'.
+ */
+size_t NimBLELogRecord::format(const uint8_t* rec, char* out, size_t size, bool upperCaseAddr, const char* addrDelimiter) {
+    if (size == 0) {
+        return 0;
+    }
+
+    const char* fmt;
+    memcpy(&fmt, rec + FORMAT_OFFSET, sizeof(fmt));
+    const size_t recLen = rec[0];
+    size_t       pos    = HEADER_SIZE;
+    size_t       n      = 0;
+
+    auto emit = [&](const char* text, size_t len) {
+        for (size_t i = 0; i < len && n + 1 < size; i++) {
+            out[n++] = text[i];
+        }
+    };
+
+    while (*fmt != '\0') {
+        if (*fmt != '%') {
+            const char* start = fmt;
+            while (*fmt != '\0' && *fmt != '%') {
+                fmt++;
+            }
+            emit(start, fmt - start);
+            continue;
+        }
+
+        if (fmt[1] == '%') {
+            emit("%", 1);
+            fmt += 2;
+            continue;
+        }
+
+        // Flags, width and precision are kept, the length modifier is replaced to match the stored type.
+        char   spec[16] = {'%'};
+        size_t specLen  = 1;
+        fmt++;
+        while (*fmt != '\0' && strchr("-+ #0123456789.", *fmt) != nullptr) {
+            if (specLen < sizeof(spec) - 4) {
+                spec[specLen++] = *fmt;
+            }
+            fmt++;
+        }
+        while (*fmt != '\0' && strchr("hljztL", *fmt) != nullptr) {
+            fmt++;
+        }
+        const char conv = *fmt;
+        if (conv == '\0') {
+            break;
+        }
+        fmt++;
+
+        if (pos >= recLen) {
+            emit("?", 1);
+            continue;
+        }
+
+        const uint8_t type = rec[pos];
+        char          text[64];
+        int           len = -1;
+        if (type == ARG_STRING || type == ARG_ADDRESS) {
+            char str[MAX_STRING + 1];
+            if (type == ARG_STRING) {
+                const size_t strLen = rec[pos + 1];
+                memcpy(str, rec + pos + 2, strLen);
+                str[strLen] = '\0';
+                pos += 2 + strLen;
+            } else {
+                const uint8_t* val = rec + pos + 2;
+                snprintf(str,
+                         sizeof(str),
+                         upperCaseAddr ? "%02X%s%02X%s%02X%s%02X%s%02X%s%02X" : "%02x%s%02x%s%02x%s%02x%s%02x%s%02x",
+                         val[5],
+                         addrDelimiter,
+                         val[4],
+                         addrDelimiter,
+                         val[3],
+                         addrDelimiter,
+                         val[2],
+                         addrDelimiter,
+                         val[1],
+                         addrDelimiter,
+                         val[0]);
+                pos += 1 + 7;
+            }
+
+            if (conv == 's') {
+                spec[specLen++] = 's';
+                spec[specLen]   = '\0';
+                len             = snprintf(text, sizeof(text), spec, str);
+            }
+        } else if (type == ARG_DOUBLE) {
+            double value;
+            memcpy(&value, rec + pos + 1, sizeof(value));
+            pos += 1 + sizeof(value);
+            if (strchr("fFeEgGaA", conv) != nullptr) {
+                spec[specLen++] = conv;
+                spec[specLen]   = '\0';
+                len             = snprintf(text, sizeof(text), spec, value);
+            }
+        } else {
+            uint64_t raw = 0;
+            if (type == ARG_INT32 || type == ARG_UINT32) {
+                uint32_t value;
+                memcpy(&value, rec + pos + 1, sizeof(value));
+                raw = type == ARG_INT32 ? static_cast<uint64_t>(static_cast<int64_t>(static_cast<int32_t>(value))) : value;
+                pos += 1 + sizeof(value);
+            } else {
+                memcpy(&raw, rec + pos + 1, sizeof(raw));
+                pos += 1 + sizeof(raw);
+            }
+
+            if (conv == 'p') {
+                spec[specLen++] = 'p';
+                spec[specLen]   = '\0';
+                len             = snprintf(text, sizeof(text), spec, reinterpret_cast<void*>(static_cast<uintptr_t>(raw)));
+            } else if (conv == 'c') {
+                spec[specLen++] = 'c';
+                spec[specLen]   = '\0';
+                len             = snprintf(text, sizeof(text), spec, static_cast<int>(raw));
+            } else if (strchr("diuoxX", conv) != nullptr) {
+                // A 32 bit value printed unsigned keeps its 32 bit width, e.g. %x of -1 is ffffffff.
+                if ((type == ARG_INT32 || type == ARG_UINT32) && conv != 'd' && conv != 'i') {
+                    raw = static_cast<uint32_t>(raw);
+                }
+                spec[specLen++] = 'l';
+                spec[specLen++] = 'l';
+                spec[specLen++] = conv;
+                spec[specLen]   = '\0';
+                if (conv == 'd' || conv == 'i') {
+                    len = snprintf(text, sizeof(text), spec, static_cast<long long>(raw));
+                } else {
+                    len = snprintf(text, sizeof(text), spec, static_cast<unsigned long long>(raw));
+                }
+            }
+        }
+
+        if (len < 0) {
+            emit("?", 1);
+        } else {
+            emit(text, static_cast<size_t>(len) < sizeof(text) ? static_cast<size_t>(len) : sizeof(text) - 1);
+        }
+    }
+
+    out[n] = '\0';
+    return n;
+} // format
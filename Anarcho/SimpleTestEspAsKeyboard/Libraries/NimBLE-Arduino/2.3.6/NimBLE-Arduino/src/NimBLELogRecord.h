@@ -0,0 +1,153 @@
+/*
+ * Copyright 2020-2025 Ryan Powell <ryan@nable-embedded.io> and
+ * esp-nimble-cpp, NimBLE-Arduino contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NIMBLE_CPP_LOG_RECORD_H_
+#define NIMBLE_CPP_LOG_RECORD_H_
+
+/**
+ * This header has no dependency on the NimBLE stack so that it can also be built on a host
+ * for benchmarking (see Src/Tools/NimBLEBench).
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+#include <utility>
+
+/* Used to determine if a log argument is an address with getType() and getVal(), e.g. NimBLEAddress. */
+template <typename T, typename = void, typename = void>
+struct Has_type_val : std::false_type {};
+
+template <typename T>
+struct Has_type_val<T, decltype(void(std::declval<const T&>().getType())), decltype(void(std::declval<const T&>().getVal()))>
+    : std::true_type {};
+
+/**
+ * @brief Binary form of a log message: the format string and tag pointers plus the raw arguments.
+ * @details Encoding only copies the arguments, the text is produced later by format(). The format string
+ * and the tag must be string literals, string arguments are copied (up to MAX_STRING bytes) and
+ * addresses are stored as 7 bytes and formatted as with NimBLEAddress::toString().\n
+ * Layout: length, level, argument count, reserved, 32 bit timestamp, tag pointer, format pointer,
+ * then per argument a type byte followed by its value.
+ */
+class NimBLELogRecord {
+  public:
+    /** Maximum size of a record, arguments that do not fit are dropped. */
+    static constexpr size_t MAX_SIZE = 128;
+    /** Maximum number of bytes kept of a string argument. */
+    static constexpr size_t MAX_STRING = 64;
+
+    /**
+     * @brief Encode a log message.
+     * @param [out] out The record buffer, at least MAX_SIZE bytes.
+     * @param [in] level The level letter, 'E', 'W', 'I' or 'D'.
+     * @param [in] tag The log tag, a string literal.
+     * @param [in] format The printf style format string, a string literal.
+     * @param [in] args The arguments.
+     * @return The size of the record.
+     */
+    template <typename... Args>
+    static size_t encode(uint8_t* out, char level, const char* tag, const char* format, const Args&... args) {
+        out[1] = static_cast<uint8_t>(level);
+        out[2] = 0;
+        out[3] = 0;
+        memset(out + 4, 0, sizeof(uint32_t));
+        memcpy(out + TAG_OFFSET, &tag, sizeof(tag));
+        memcpy(out + FORMAT_OFFSET, &format, sizeof(format));
+        size_t len = HEADER_SIZE;
+        ((len = put(out, len, args)), ...);
+        out[0] = static_cast<uint8_t>(len);
+        return len;
+    }
+
+    static void        setTimestamp(uint8_t* rec, uint32_t timestamp);
+    static uint32_t    getTimestamp(const uint8_t* rec);
+    static char        getLevel(const uint8_t* rec);
+    static const char* getTag(const uint8_t* rec);
+    static size_t      format(const uint8_t* rec, char* out, size_t size, bool upperCaseAddr = false, const char* addrDelimiter = ":");
+
+  private:
+    enum ArgType : uint8_t { ARG_INT32 = 1, ARG_UINT32, ARG_INT64, ARG_UINT64, ARG_DOUBLE, ARG_STRING, ARG_ADDRESS, ARG_POINTER };
+
+    static constexpr size_t TAG_OFFSET    = 8;
+    static constexpr size_t FORMAT_OFFSET = TAG_OFFSET + sizeof(const char*);
+    static constexpr size_t HEADER_SIZE   = FORMAT_OFFSET + sizeof(const char*);
+
+    static size_t putValue(uint8_t* out, size_t len, uint8_t type, const void* value, size_t size) {
+        if (len + 1 + size > MAX_SIZE) {
+            return len;
+        }
+
+        out[len] = type;
+        memcpy(out + len + 1, value, size);
+        out[2]++;
+        return len + 1 + size;
+    }
+
+    static size_t putString(uint8_t* out, size_t len, const char* str) {
+        size_t n = 0;
+        if (str == nullptr) {
+            str = "(null)";
+        }
+        while (n < MAX_STRING && str[n] != '\0') {
+            n++;
+        }
+
+        if (len + 2 + n > MAX_SIZE) {
+            return len;
+        }
+
+        out[len]     = ARG_STRING;
+        out[len + 1] = static_cast<uint8_t>(n);
+        memcpy(out + len + 2, str, n);
+        out[2]++;
+        return len + 2 + n;
+    }
+
+    template <typename T>
+    static size_t put(uint8_t* out, size_t len, const T& arg) {
+        using D = typename std::decay<T>::type;
+        if constexpr (Has_type_val<D>::value) {
+            uint8_t addr[7];
+            addr[0] = static_cast<uint8_t>(arg.getType());
+            memcpy(addr + 1, arg.getVal(), 6);
+            return putValue(out, len, ARG_ADDRESS, addr, sizeof(addr));
+        } else if constexpr (std::is_same<D, const char*>::value || std::is_same<D, char*>::value) {
+            return putString(out, len, arg);
+        } else if constexpr (std::is_pointer<D>::value) {
+            const uint64_t value = reinterpret_cast<uintptr_t>(arg);
+            return putValue(out, len, ARG_POINTER, &value, sizeof(value));
+        } else if constexpr (std::is_floating_point<D>::value) {
+            const double value = arg;
+            return putValue(out, len, ARG_DOUBLE, &value, sizeof(value));
+        } else if constexpr (std::is_enum<D>::value) {
+            return put(out, len, static_cast<typename std::underlying_type<D>::type>(arg));
+        } else {
+            static_assert(std::is_integral<D>::value, "Unsupported log argument type");
+            if constexpr (sizeof(D) > sizeof(uint32_t)) {
+                const uint64_t value = static_cast<uint64_t>(arg);
+                return putValue(out, len, std::is_signed<D>::value ? ARG_INT64 : ARG_UINT64, &value, sizeof(value));
+            } else {
+                const uint32_t value = static_cast<uint32_t>(arg);
+                return putValue(out, len, std::is_signed<D>::value ? ARG_INT32 : ARG_UINT32, &value, sizeof(value));
+            }
+        }
+    }
+}; // NimBLELogRecord
+
+#endif // NIMBLE_CPP_LOG_RECORD_H_
@@ -0,0 +1,52 @@
+/*
+ * Copyright 2020-2025 Ryan Powell <ryan@nable-embedded.io> and
+ * esp-nimble-cpp, NimBLE-Arduino contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "NimBLENotifyPlan.h"
+
+/**
+ * @brief Plan the PDUs for a set of notifications.
+ * @param [in] lengths The value length of each notification.
+ * @param [in] count The number of notifications.
+ * @param [in] mtu The ATT MTU of the connection.
+ * @param [in] multiple True if the peer supports ATT Multiple Handle Value Notifications.
+ */
+void NimBLENotifyPlan::build(const uint16_t* lengths, size_t count, uint16_t mtu, bool multiple) {
+    clear();
+
+    // Opcode, then handle and length of each entry. used is 0 while the last PDU cannot take more entries.
+    const uint32_t budget = mtu > 1 ? mtu - 1U : 0;
+    uint32_t       used   = 0;
+    for (size_t i = 0; i < count; i++) {
+        const uint32_t size = lengths[i] + 4U;
+        if (used > 0 && used + size <= budget) {
+            m_pdus.back().count++;
+            used += size;
+            continue;
+        }
+
+        m_pdus.push_back(Pdu{static_cast<uint16_t>(i), 1});
+        used = multiple && size <= budget ? size : 0;
+    }
+} // build
+
+/**
+ * @brief Remove all PDUs, keeping the allocated memory.
+ */
+void NimBLENotifyPlan::clear() {
+    m_pdus.clear();
+} // clear
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2020-2025 Ryan Powell <ryan@nable-embedded.io> and
+ * esp-nimble-cpp, NimBLE-Arduino contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NIMBLE_CPP_NOTIFY_PLAN_H_
+#define NIMBLE_CPP_NOTIFY_PLAN_H_
+
+/**
+ * This header has no dependency on the NimBLE stack so that it can also be built on a host
+ * for benchmarking (see Src/Tools/NimBLEBench).
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @brief Groups pending notifications into as few ATT PDUs as fit the MTU.
+ * @details An ATT Multiple Handle Value Notification carries a 2 byte handle, a 2 byte length and the value
+ * of each characteristic after the 1 byte opcode and must fit in the MTU. The notifications are kept in the
+ * order they were added and packed greedily, which gives the fewest PDUs for an order preserving split.\n
+ * A PDU with one entry is sent as a plain Handle Value Notification, which is also used for every entry
+ * when the peer does not support multiple notifications and for values too long to share a PDU.
+ */
+class NimBLENotifyPlan {
+  public:
+    /**
+     * @brief A range of notifications, in the order they were added, that is sent with one PDU.
+     */
+    struct Pdu {
+        uint16_t first;
+        uint16_t count;
+    };
+
+    void build(const uint16_t* lengths, size_t count, uint16_t mtu, bool multiple);
+    void clear();
+
+    /**
+     * @brief Get the PDUs in the order they are sent.
+     */
+    const std::vector<Pdu>& getPdus() const { return m_pdus; }
+
+  private:
+    std::vector<Pdu> m_pdus{};
+};
+
+#endif // NIMBLE_CPP_NOTIFY_PLAN_H_
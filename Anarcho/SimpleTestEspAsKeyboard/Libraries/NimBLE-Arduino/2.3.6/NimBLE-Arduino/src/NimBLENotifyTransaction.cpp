@@ -0,0 +1,205 @@
+/*
+ * Copyright 2020-2025 Ryan Powell <ryan@nable-embedded.io> and
+ * esp-nimble-cpp, NimBLE-Arduino contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "NimBLENotifyTransaction.h"
+#if CONFIG_BT_ENABLED && CONFIG_BT_NIMBLE_ROLE_PERIPHERAL
+
+# include "NimBLECharacteristic.h"
+# include "NimBLEDevice.h"
+# include "NimBLEUtils.h"
+# include "NimBLELog.h"
+
+# if defined(CONFIG_NIMBLE_CPP_IDF)
+#  include "host/ble_hs.h"
+# else
+#  include "nimble/nimble/host/include/host/ble_hs.h"
+# endif
+
+/****  FIX COMPILATION ****/
+# undef min
+# undef max
+/**************************/
+
+// Client Supported Features octet 0, bit 2: the peer accepts ATT Multiple Handle Value Notifications.
+static const uint8_t MULTIPLE_NOTIFY_FEATURE = 0x04;
+static const char*   LOG_TAG                 = "NimBLENotifyTransaction";
+
+/**
+ * @brief Construct an empty transaction.
+ * @param [in] connHandle The peer to send to, BLE_HS_CONN_HANDLE_NONE for every connected peer.
+ */
+NimBLENotifyTransaction::NimBLENotifyTransaction(uint16_t connHandle) : m_connHandle{connHandle} {}
+
+/**
+ * @brief Add the current value of a characteristic.
+ * @param [in] pChr The characteristic to notify.
+ * @return True if added.
+ */
+bool NimBLENotifyTransaction::add(const NimBLECharacteristic* pChr) {
+    if (pChr == nullptr) {
+        return false;
+    }
+
+    const NimBLEAttValue value = pChr->getValue();
+    return add(pChr, value.data(), value.size());
+} // add
+
+/**
+ * @brief Add a custom value for a characteristic.
+ * @param [in] pChr The characteristic to notify.
+ * @param [in] value A pointer to the data to send, copied before returning.
+ * @param [in] length The length of the data.
+ * @return True if added, false if the characteristic has no handle yet or the value is too long.
+ */
+bool NimBLENotifyTransaction::add(const NimBLECharacteristic* pChr, const uint8_t* value, size_t length) {
+    if (pChr == nullptr || pChr->getHandle() == 0 || length > BLE_ATT_ATTR_MAX_LEN || (value == nullptr && length > 0)) {
+        NIMBLE_LOGE(LOG_TAG, "Cannot add notification, invalid characteristic or value");
+        return false;
+    }
+
+    Entry* pEntry = nullptr;
+    for (auto& entry : m_entries) {
+        if (entry.handle == pChr->getHandle()) {
+            pEntry = &entry;
+            break;
+        }
+    }
+
+    if (pEntry == nullptr) {
+        m_entries.push_back(Entry{pChr->getHandle(), 0, 0});
+        pEntry = &m_entries.back();
+    }
+
+    // A replaced value is left in the buffer, the buffer is reset by clear() or commit().
+    pEntry->offset = static_cast<uint32_t>(m_data.size());
+    pEntry->length = static_cast<uint16_t>(length);
+    m_data.insert(m_data.end(), value, value + length);
+    return true;
+} // add
+
+/**
+ * @brief Send the collected notifications and empty the transaction.
+ * @return True if every PDU was sent to every peer.
+ * @details The PDUs are sent in the order the characteristics were first added. If a PDU cannot be sent to a
+ * peer the remaining PDUs for that peer are dropped, other peers are still sent to.
+ */
+bool NimBLENotifyTransaction::commit() {
+    bool success = true;
+    m_pduCount   = 0;
+
+    if (!m_entries.empty()) {
+        if (m_connHandle != BLE_HS_CONN_HANDLE_NONE) {
+            success = send(m_connHandle);
+        } else {
+            // Take a snapshot of the peers so that a connect/disconnect during the loop has no effect.
+            uint16_t      peers[CONFIG_BT_NIMBLE_MAX_CONNECTIONS];
+            const uint8_t count = NimBLEDevice::getServer()->getPeerDevices(peers, CONFIG_BT_NIMBLE_MAX_CONNECTIONS);
+            for (uint8_t i = 0; i < count; i++) {
+                if (!send(peers[i])) {
+                    success = false;
+                }
+            }
+        }
+    }
+
+    clear();
+    return success;
+} // commit
+
+/**
+ * @brief Remove all notifications, keeping the allocated memory.
+ */
+void NimBLENotifyTransaction::clear() {
+    m_entries.clear();
+    m_data.clear();
+} // clear
+
+/**
+ * @brief Get the number of characteristics in the transaction.
+ */
+size_t NimBLENotifyTransaction::size() const {
+    return m_entries.size();
+} // size
+
+/**
+ * @brief Get the number of ATT PDUs sent by the last commit(), summed over all peers.
+ */
+uint16_t NimBLENotifyTransaction::getPduCount() const {
+    return m_pduCount;
+} // getPduCount
+
+/**
+ * @brief Send the collected notifications to one peer.
+ */
+bool NimBLENotifyTransaction::send(uint16_t connHandle) {
+    const uint16_t mtu = ble_att_mtu(connHandle);
+    if (mtu == 0) {
+        NIMBLE_LOGE(LOG_TAG, "Cannot send notifications, conn %u not found", connHandle);
+        return false;
+    }
+
+    uint8_t    features = 0;
+    const bool multiple = ble_gatts_peer_cl_sup_feat_get(connHandle, &features, 1) == 0 &&
+                          (features & MULTIPLE_NOTIFY_FEATURE) != 0;
+
+    m_lengths.clear();
+    for (const auto& entry : m_entries) {
+        m_lengths.push_back(entry.length);
+    }
+    m_plan.build(m_lengths.data(), m_lengths.size(), mtu, multiple);
+
+    for (const auto& pdu : m_plan.getPdus()) {
+        int rc = 0;
+        m_tuples.clear();
+        for (uint16_t i = pdu.first; i < pdu.first + pdu.count; i++) {
+            const Entry& entry = m_entries[i];
+            os_mbuf*     om    = ble_hs_mbuf_from_flat(m_data.data() + entry.offset, entry.length);
+            if (om == nullptr) {
+                rc = BLE_HS_ENOMEM;
+                break;
+            }
+            m_tuples.push_back(ble_gatt_notif{entry.handle, om});
+        }
+
+        if (rc != 0) {
+            for (auto& tuple : m_tuples) {
+                os_mbuf_free_chain(tuple.value);
+            }
+        } else if (m_tuples.size() == 1) {
+            rc = ble_gattc_notify_custom(connHandle, m_tuples[0].handle, m_tuples[0].value);
+        } else {
+            // The plan only groups entries that fit one PDU, so the host sends exactly one ATT PDU.
+            rc = ble_gatts_notify_multiple_custom(connHandle, m_tuples.size(), m_tuples.data());
+        }
+
+        if (rc != 0) {
+            NIMBLE_LOGE(LOG_TAG,
+                        "failed to send notifications to conn %u, rc=%d %s",
+                        connHandle,
+                        rc,
+                        NimBLEUtils::returnCodeToString(rc));
+            return false;
+        }
+
+        m_pduCount++;
+    }
+
+    return true;
+} // send
+
+#endif // CONFIG_BT_ENABLED && CONFIG_BT_NIMBLE_ROLE_PERIPHERAL
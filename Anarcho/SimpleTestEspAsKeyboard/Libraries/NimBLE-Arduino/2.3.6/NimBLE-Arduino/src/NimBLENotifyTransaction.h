@@ -0,0 +1,81 @@
+/*
+ * Copyright 2020-2025 Ryan Powell <ryan@nable-embedded.io> and
+ * esp-nimble-cpp, NimBLE-Arduino contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef NIMBLE_CPP_NOTIFY_TRANSACTION_H_
+#define NIMBLE_CPP_NOTIFY_TRANSACTION_H_
+
+#include "nimconfig.h"
+#if CONFIG_BT_ENABLED && CONFIG_BT_NIMBLE_ROLE_PERIPHERAL
+
+# if defined(CONFIG_NIMBLE_CPP_IDF)
+#  include "host/ble_gatt.h"
+# else
+#  include "nimble/nimble/host/include/host/ble_gatt.h"
+# endif
+
+/****  FIX COMPILATION ****/
+# undef min
+# undef max
+/**************************/
+
+# include "NimBLENotifyPlan.h"
+
+# include <vector>
+
+class NimBLECharacteristic;
+
+/**
+ * @brief Collects notifications of several characteristics and sends them together.
+ * @details Created with NimBLEServer::beginNotify(). Values are copied when they are added, adding a
+ * characteristic again replaces its value but keeps its place. commit() sends everything to the peer, or to
+ * every connected peer, in as few ATT PDUs as the MTU allows: one Multiple Handle Value Notification per PDU
+ * if the peer has set the multiple notifications bit in its Client Supported Features, otherwise one Handle
+ * Value Notification per characteristic, sent back to back.
+ */
+class NimBLENotifyTransaction {
+  public:
+    bool     add(const NimBLECharacteristic* pChr);
+    bool     add(const NimBLECharacteristic* pChr, const uint8_t* value, size_t length);
+    bool     commit();
+    void     clear();
+    size_t   size() const;
+    uint16_t getPduCount() const;
+
+  private:
+    friend class NimBLEServer;
+
+    struct Entry {
+        uint16_t handle;
+        uint16_t length;
+        uint32_t offset;
+    };
+
+    NimBLENotifyTransaction(uint16_t connHandle);
+    bool send(uint16_t connHandle);
+
+    uint16_t                    m_connHandle;
+    uint16_t                    m_pduCount{0};
+    std::vector<Entry>          m_entries{};
+    std::vector<uint8_t>        m_data{};
+    std::vector<uint16_t>       m_lengths{};
+    std::vector<ble_gatt_notif> m_tuples{};
+    NimBLENotifyPlan            m_plan{};
+};
+
+#endif // CONFIG_BT_ENABLED && CONFIG_BT_NIMBLE_ROLE_PERIPHERAL
+#endif // NIMBLE_CPP_NOTIFY_TRANSACTION_H_
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2020-2025 Ryan Powell <ryan@nable-embedded.io> and
+ * esp-nimble-cpp, NimBLE-Arduino contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NimBLEReadMultiplePlan.h"
+
+#include <algorithm>
+
+/**
+ * @brief Plan the requests for a set of attribute reads.
+ * @param [in] lengths The expected value length of each attribute, UNKNOWN_LENGTH if not known.
+ * @param [in] count The number of attributes.
+ * @param [in] mtu The ATT MTU of the connection.
+ * @param [in] maxHandles The most handles the stack accepts in one Read Multiple request.
+ */
+void NimBLEReadMultiplePlan::build(const uint16_t* lengths, size_t count, uint16_t mtu, uint8_t maxHandles) {
+    clear();
+    if (count == 0) {
+        return;
+    }
+
+    const uint16_t budget = mtu > 1 ? mtu - 1 : 0;
+    if (maxHandles > budget / 2) {
+        maxHandles = budget / 2;
+    }
+
+    // Sort by expected response size, largest first, unknown lengths sort first and stay alone.
+    m_order.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        m_order[i] = static_cast<uint16_t>(i);
+    }
+    std::stable_sort(m_order.begin(), m_order.end(), [lengths](uint16_t a, uint16_t b) { return lengths[a] > lengths[b]; });
+
+    m_binOf.resize(count);
+    for (uint16_t index : m_order) {
+        const uint32_t size      = lengths[index] == UNKNOWN_LENGTH ? UINT32_MAX : lengths[index] + 2U;
+        const bool     shareable = size <= budget && maxHandles > 1;
+
+        // First fit, bins with count 0 hold a single value that cannot share a request.
+        size_t bin = m_bins.size();
+        if (shareable) {
+            for (size_t i = 0; i < m_bins.size(); i++) {
+                if (m_bins[i].count > 0 && m_bins[i].count < maxHandles && m_bins[i].used + size <= budget) {
+                    bin = i;
+                    break;
+                }
+            }
+        }
+
+        if (bin == m_bins.size()) {
+            m_bins.push_back(Bin{0, 0});
+        }
+
+        if (shareable) {
+            m_bins[bin].count++;
+            m_bins[bin].used += static_cast<uint16_t>(size);
+        }
+        m_binOf[index] = static_cast<uint16_t>(bin);
+    }
+
+    // Counting sort of the indexes by bin, keeping the input order within a bin.
+    m_batches.resize(m_bins.size(), Batch{0, 0});
+    for (size_t i = 0; i < count; i++) {
+        m_batches[m_binOf[i]].count++;
+    }
+
+    uint16_t first = 0;
+    for (auto& batch : m_batches) {
+        batch.first = first;
+        first += batch.count;
+        batch.count = 0;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        Batch& batch                          = m_batches[m_binOf[i]];
+        m_order[batch.first + batch.count++] = static_cast<uint16_t>(i);
+    }
+} // build
+
+/**
+ * @brief Remove all batches, keeping the allocated memory.
+ */
+void NimBLEReadMultiplePlan::clear() {
+    m_batches.clear();
+    m_order.clear();
+    m_binOf.clear();
+    m_bins.clear();
+} // clear
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2020-2025 Ryan Powell <ryan@nable-embedded.io> and
+ * esp-nimble-cpp, NimBLE-Arduino contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NIMBLE_CPP_READ_MULTIPLE_PLAN_H_
+#define NIMBLE_CPP_READ_MULTIPLE_PLAN_H_
+
+/**
+ * This header has no dependency on the NimBLE stack so that it can also be built on a host
+ * for benchmarking (see Src/Tools/NimBLEBench).
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @brief Groups attribute reads into as few ATT Read Multiple Variable Length requests as fit the MTU.
+ * @details The response carries a 2 byte length and the value of each attribute and must fit in MTU - 1
+ * bytes, the request carries 2 bytes per handle and must fit in MTU - 1 bytes as well. The values are packed
+ * first fit decreasing by their expected length, which is within 11/9 of the fewest possible requests.\n
+ * Values of unknown length, or too long for a single response, get a batch of their own and are read with a
+ * (long) read. A batch with one entry is always read that way, Read Multiple needs at least two handles.
+ */
+class NimBLEReadMultiplePlan {
+  public:
+    static constexpr uint16_t UNKNOWN_LENGTH = 0xFFFF;
+
+    /**
+     * @brief A range of getOrder() that is read with one request.
+     */
+    struct Batch {
+        uint16_t first;
+        uint8_t  count;
+    };
+
+    void build(const uint16_t* lengths, size_t count, uint16_t mtu, uint8_t maxHandles);
+    void clear();
+
+    /**
+     * @brief Get the batches, one per request.
+     */
+    const std::vector<Batch>& getBatches() const { return m_batches; }
+
+    /**
+     * @brief Get the input indexes ordered by batch.
+     */
+    const std::vector<uint16_t>& getOrder() const { return m_order; }
+
+  private:
+    struct Bin {
+        uint16_t used;
+        uint8_t  count;
+    };
+
+    std::vector<Batch>    m_batches{};
+    std::vector<uint16_t> m_order{};
+    std::vector<uint16_t> m_binOf{};
+    std::vector<Bin>      m_bins{};
+};
+
+#endif // NIMBLE_CPP_READ_MULTIPLE_PLAN_H_
@@ -23,15 +23,34 @@
 # include "NimBLEClient.h"
 # include "NimBLEUtils.h"
 # include "NimBLELog.h"
+# include "NimBLEWriteQueue.h"
+
+# if defined(CONFIG_NIMBLE_CPP_IDF)
+#  include "nimble/nimble_port.h"
+# else
+#  include "nimble/porting/nimble/include/nimble/nimble_port.h"
+# endif
 
 # include <climits>
 
+// Number of msys buffers the write queue leaves for received data and other writes.
+# define WRITE_QUEUE_MSYS_RESERVE 4
+
 struct NimBLEDescriptorFilter {
     NimBLERemoteDescriptor* dsc;
     const NimBLEUUID*       uuid;
     void*                   taskData;
 };
 
+struct NimBLERemoteCharacteristic::WriteQueue {
+    WriteQueue() : values{CONFIG_NIMBLE_CPP_WRITE_QUEUE_SIZE} {}
+
+    NimBLEWriteQueue     values;
+    write_queue_callback drainedCallback{nullptr};
+    ble_npl_event        event;
+    ble_npl_callout      retry;
+};
+
 static const char* LOG_TAG = "NimBLERemoteCharacteristic";
 
 /**
@@ -57,6 +76,14 @@ NimBLERemoteCharacteristic::NimBLERemoteCharacteristic(const NimBLERemoteService
  */
 NimBLERemoteCharacteristic::~NimBLERemoteCharacteristic() {
     deleteDescriptors();
+
+    if (m_pWriteQueue) {
+        ble_npl_callout_stop(&m_pWriteQueue->retry);
+        ble_npl_eventq_remove(nimble_port_get_dflt_eventq(), &m_pWriteQueue->event);
+        ble_npl_callout_deinit(&m_pWriteQueue->retry);
+        ble_npl_event_deinit(&m_pWriteQueue->event);
+        delete m_pWriteQueue;
+    }
 } // ~NimBLERemoteCharacteristic
 
 /**
@@ -257,6 +284,121 @@ bool NimBLERemoteCharacteristic::unsubscribe(bool response) const {
     return setNotify(0x00, nullptr, response);
 } // unsubscribe
 
+/**
+ * @brief Get the write queue of this characteristic, creating it on first use.
+ */
+NimBLERemoteCharacteristic::WriteQueue* NimBLERemoteCharacteristic::getWriteQueue() const {
+    if (!m_pWriteQueue) {
+        m_pWriteQueue = new WriteQueue();
+        ble_npl_event_init(&m_pWriteQueue->event, NimBLERemoteCharacteristic::writeQueueEvent, const_cast<NimBLERemoteCharacteristic*>(this));
+        ble_npl_callout_init(&m_pWriteQueue->retry,
+                             nimble_port_get_dflt_eventq(),
+                             NimBLERemoteCharacteristic::writeQueueEvent,
+                             const_cast<NimBLERemoteCharacteristic*>(this));
+    }
+
+    return m_pWriteQueue;
+} // getWriteQueue
+
+/**
+ * @brief Queue a write without response, without blocking.
+ * @param [in] data A pointer to the value, the value is copied.
+ * @param [in] length The length of the value, at most the MTU - 3.
+ * @return True if the value has been queued, false if not connected, the value is too long or the queue is full.
+ * @details The queued values are written in order from the NimBLE host task. When the host runs out of buffers
+ * the write is retried once it has sent some, instead of failing. A full queue means the peer
+ * does not keep up, retry after the drained callback or when getWriteQueueCount() has dropped.\n
+ * The queue holds CONFIG_NIMBLE_CPP_WRITE_QUEUE_SIZE bytes, each value takes its length plus 2 bytes.
+ * It is created by the first call, which should not be made from several tasks at once.
+ */
+bool NimBLERemoteCharacteristic::writeValueQueued(const uint8_t* data, size_t length) const {
+    const NimBLEClient* pClient = getClient();
+    if (!pClient->isConnected() || length > static_cast<size_t>(pClient->getMTU() - 3)) {
+        return false;
+    }
+
+    WriteQueue* pQueue = getWriteQueue();
+    ble_npl_hw_enter_critical();
+    bool queued = pQueue->values.push(data, length);
+    ble_npl_hw_exit_critical(0);
+
+    if (queued) {
+        // Does nothing if the event is already pending.
+        ble_npl_eventq_put(nimble_port_get_dflt_eventq(), &pQueue->event);
+    }
+
+    return queued;
+} // writeValueQueued
+
+/**
+ * @brief Get the number of values queued with writeValueQueued that have not been handed to the host yet.
+ */
+size_t NimBLERemoteCharacteristic::getWriteQueueCount() const {
+    return m_pWriteQueue ? m_pWriteQueue->values.getCount() : 0;
+} // getWriteQueueCount
+
+/**
+ * @brief Set a callback that is invoked on the NimBLE host task when the write queue has been emptied.
+ * @param [in] callback The callback, nullptr to remove it.
+ */
+void NimBLERemoteCharacteristic::setWriteQueueDrainedCallback(const write_queue_callback callback) const {
+    getWriteQueue()->drainedCallback = callback;
+} // setWriteQueueDrainedCallback
+
+/**
+ * @brief Hand queued values to the host until it runs out of buffers. Runs in the host task.
+ */
+void NimBLERemoteCharacteristic::pumpWriteQueue() const {
+    WriteQueue* pQueue = m_pWriteQueue;
+    bool        sent   = false;
+
+    for (;;) {
+        size_t length = 0;
+        ble_npl_hw_enter_critical();
+        const uint8_t* data = pQueue->values.front(&length);
+        ble_npl_hw_exit_critical(0);
+        if (!data) {
+            break;
+        }
+
+        int rc = BLE_HS_ENOMEM;
+        if (os_msys_num_free() > WRITE_QUEUE_MSYS_RESERVE) {
+            rc = ble_gattc_write_no_rsp_flat(getClient()->getConnHandle(), getHandle(), data, length);
+        }
+
+        if (rc == BLE_HS_ENOMEM) {
+            // Buffers are freed as the controller completes packets, try again on the next tick.
+            ble_npl_callout_reset(&pQueue->retry, 1);
+            return;
+        }
+
+        if (rc != 0) {
+            NIMBLE_LOGE(LOG_TAG, "Queued write failed, rc: %d %s", rc, NimBLEUtils::returnCodeToString(rc));
+        }
+
+        ble_npl_hw_enter_critical();
+        if (rc == BLE_HS_ENOTCONN) {
+            // None of the remaining values can be written either.
+            pQueue->values.clear();
+        } else {
+            pQueue->values.pop();
+        }
+        ble_npl_hw_exit_critical(0);
+        sent = true;
+    }
+
+    if (sent && pQueue->drainedCallback) {
+        pQueue->drainedCallback(const_cast<NimBLERemoteCharacteristic*>(this));
+    }
+} // pumpWriteQueue
+
+/**
+ * @brief Host task event to run pumpWriteQueue.
+ */
+void NimBLERemoteCharacteristic::writeQueueEvent(struct ble_npl_event* event) {
+    static_cast<NimBLERemoteCharacteristic*>(ble_npl_event_get_arg(event))->pumpWriteQueue();
+} // writeQueueEvent
+
 /**
  * @brief Delete the descriptors in the descriptor vector.
  * @details We maintain a vector called m_vDescriptors that contains pointers to NimBLERemoteDescriptors
@@ -25,6 +25,12 @@
 # include <vector>
 # include <functional>
 
+# if !defined(CONFIG_NIMBLE_CPP_WRITE_QUEUE_SIZE)
+#  define CONFIG_NIMBLE_CPP_WRITE_QUEUE_SIZE 1024
+# elif CONFIG_NIMBLE_CPP_WRITE_QUEUE_SIZE < 64 || CONFIG_NIMBLE_CPP_WRITE_QUEUE_SIZE > 65535
+#  error CONFIG_NIMBLE_CPP_WRITE_QUEUE_SIZE must be in the range 64 : 65535
+# endif
+
 class NimBLEUUID;
 class NimBLERemoteService;
 class NimBLERemoteDescriptor;
@@ -51,9 +57,15 @@ class NimBLERemoteCharacteristic : public NimBLERemoteValueAttribute {
 
     typedef std::function<void(NimBLERemoteCharacteristic* pBLERemoteCharacteristic, uint8_t* pData, size_t length, bool isNotify)> notify_callback;
 
+    typedef std::function<void(NimBLERemoteCharacteristic* pBLERemoteCharacteristic)> write_queue_callback;
+
     bool subscribe(bool notifications = true, const notify_callback notifyCallback = nullptr, bool response = true) const;
     bool unsubscribe(bool response = true) const;
 
+    bool   writeValueQueued(const uint8_t* data, size_t length) const;
+    size_t getWriteQueueCount() const;
+    void   setWriteQueueDrainedCallback(const write_queue_callback callback) const;
+
     std::vector<NimBLERemoteDescriptor*>::iterator begin() const;
     std::vector<NimBLERemoteDescriptor*>::iterator end() const;
     NimBLERemoteDescriptor*                        getDescriptor(const NimBLEUUID& uuid) const;
@@ -63,19 +75,25 @@ class NimBLERemoteCharacteristic : public NimBLERemoteValueAttribute {
     friend class NimBLEClient;
     friend class NimBLERemoteService;
 
+    struct WriteQueue;
+
     NimBLERemoteCharacteristic(const NimBLERemoteService* pRemoteService, const ble_gatt_chr* chr);
     ~NimBLERemoteCharacteristic();
 
     bool setNotify(uint16_t val, notify_callback notifyCallback = nullptr, bool response = true) const;
     bool retrieveDescriptors(NimBLEDescriptorFilter* pFilter = nullptr) const;
+    WriteQueue* getWriteQueue() const;
+    void        pumpWriteQueue() const;
 
     static int descriptorDiscCB(
         uint16_t connHandle, const ble_gatt_error* error, uint16_t chrHandle, const ble_gatt_dsc* dsc, void* arg);
+    static void writeQueueEvent(struct ble_npl_event* event);
 
     const NimBLERemoteService*                   m_pRemoteService{nullptr};
     uint8_t                                      m_properties{0};
     mutable notify_callback                      m_notifyCallback{nullptr};
     mutable std::vector<NimBLERemoteDescriptor*> m_vDescriptors{};
+    mutable WriteQueue*                          m_pWriteQueue{nullptr};
 
 }; // NimBLERemoteCharacteristic
 
@@ -29,11 +29,13 @@ static const char* LOG_TAG = "NimBLERemoteValueAttribute";
 bool NimBLERemoteValueAttribute::writeValue(const uint8_t* data, size_t length, bool response) const {
     NIMBLE_LOGD(LOG_TAG, ">> writeValue()");
 
-    const NimBLEClient* pClient    = getClient();
-    int                 retryCount = 1;
-    int                 rc         = 0;
-    uint16_t            mtu        = pClient->getMTU() - 3;
-    NimBLETaskData      taskData(const_cast<NimBLERemoteValueAttribute*>(this));
+    NimBLEClient*  pClient    = getClient();
+    int            retryCount = 1;
+    int            rc         = 0;
+    uint16_t       mtu        = pClient->getMTU() - 3;
+    bool           counted    = false;
+    uint32_t       startTime  = 0;
+    NimBLETaskData taskData(const_cast<NimBLERemoteValueAttribute*>(this));
 
     // Check if the data length is longer than we can write in one connection event.
     // If so we must do a long write which requires a response.
@@ -42,6 +44,8 @@ bool NimBLERemoteValueAttribute::writeValue(const uint8_t* data, size_t length,
         goto Done;
     }
 
+    startTime = pClient->startRequest();
+    counted   = true;
     do {
         if (length > mtu) {
             NIMBLE_LOGI(LOG_TAG, "writeValue: long write");
@@ -84,6 +88,10 @@ bool NimBLERemoteValueAttribute::writeValue(const uint8_t* data, size_t length,
     } while (rc != 0 && retryCount--);
 
 Done:
+    if (counted) {
+        pClient->finishRequest(rc, rc == 0 ? length : 0, startTime);
+    }
+
     if (rc != 0) {
         NIMBLE_LOGE(LOG_TAG, "<< writeValue failed, rc: %d %s", rc, NimBLEUtils::returnCodeToString(rc));
     } else {
@@ -124,11 +132,12 @@ int NimBLERemoteValueAttribute::onWriteCB(uint16_t conn_handle, const ble_gatt_e
 NimBLEAttValue NimBLERemoteValueAttribute::readValue(time_t* timestamp) {
     NIMBLE_LOGD(LOG_TAG, ">> readValue()");
 
-    NimBLEAttValue      value{};
-    const NimBLEClient* pClient    = getClient();
-    int                 rc         = 0;
-    int                 retryCount = 1;
-    NimBLETaskData      taskData(const_cast<NimBLERemoteValueAttribute*>(this), 0, &value);
+    NimBLEAttValue value{};
+    NimBLEClient*  pClient    = getClient();
+    int            rc         = 0;
+    int            retryCount = 1;
+    const uint32_t startTime  = pClient->startRequest();
+    NimBLETaskData taskData(const_cast<NimBLERemoteValueAttribute*>(this), 0, &value);
 
     do {
         rc = ble_gattc_read_long(pClient->getConnHandle(), getHandle(), 0, NimBLERemoteValueAttribute::onReadCB, &taskData);
@@ -169,6 +178,7 @@ NimBLEAttValue NimBLERemoteValueAttribute::readValue(time_t* timestamp) {
     }
 
 Done:
+    pClient->finishRequest(rc, rc == 0 ? value.size() : 0, startTime);
     if (rc != 0) {
         NIMBLE_LOGE(LOG_TAG, "<< readValue failed rc=%d, %s", rc, NimBLEUtils::returnCodeToString(rc));
     } else {
@@ -217,4 +227,31 @@ int NimBLERemoteValueAttribute::onReadCB(uint16_t conn_handle, const ble_gatt_er
     return rc;
 } // onReadCB
 
+/**
+ * @brief Read the value of the remote attribute without blocking.
+ * @param [in] callback (Optional) Called on the NimBLE host task when the read completes.
+ * @return A future that completes with the value read.
+ * @details Unlike readValue() a read failing with insufficient authentication or encryption is not retried
+ * after securing the connection, as that would block the host task.
+ */
+NimBLEGattFuture NimBLERemoteValueAttribute::readValueAsync(const NimBLEGattFuture::Callback& callback) {
+    NIMBLE_LOGD(LOG_TAG, ">> readValueAsync()");
+    return NimBLEGattFuture::read(this, callback);
+} // readValueAsync
+
+/**
+ * @brief Write a new value to the remote attribute with response, without blocking.
+ * @param [in] data A pointer to a data buffer, the data is copied.
+ * @param [in] length The length of the data in the data buffer.
+ * @param [in] callback (Optional) Called on the NimBLE host task when the write completes.
+ * @return A future that completes when the peer has acknowledged the write.
+ * @details Values longer than the MTU are written with a long write, as in writeValue().
+ */
+NimBLEGattFuture NimBLERemoteValueAttribute::writeValueAsync(const uint8_t*                    data,
+                                                             size_t                            length,
+                                                             const NimBLEGattFuture::Callback& callback) {
+    NIMBLE_LOGD(LOG_TAG, ">> writeValueAsync()");
+    return NimBLEGattFuture::write(this, data, length, callback);
+} // writeValueAsync
+
 #endif // CONFIG_BT_ENABLED && CONFIG_BT_NIMBLE_ROLE_CENTRAL
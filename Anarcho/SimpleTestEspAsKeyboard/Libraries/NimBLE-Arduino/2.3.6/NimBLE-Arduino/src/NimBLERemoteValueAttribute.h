@@ -34,6 +34,7 @@
 
 # include "NimBLEValueAttribute.h"
 # include "NimBLEAttValue.h"
+# include "NimBLEGattFuture.h"
 
 class NimBLEClient;
 
@@ -46,6 +47,22 @@ class NimBLERemoteValueAttribute : public NimBLEValueAttribute, public NimBLEAtt
      */
     NimBLEAttValue readValue(time_t* timestamp = nullptr);
 
+    /**
+     * @brief Read the value of the remote attribute without blocking.
+     * @param [in] callback (Optional) Called on the NimBLE host task when the read completes.
+     * @return A future that completes with the value read, the attribute value is updated as well.
+     */
+    NimBLEGattFuture readValueAsync(const NimBLEGattFuture::Callback& callback = nullptr);
+
+    /**
+     * @brief Write a new value to the remote attribute with response, without blocking.
+     * @param [in] data A pointer to a data buffer, the data is copied.
+     * @param [in] length The length of the data in the data buffer.
+     * @param [in] callback (Optional) Called on the NimBLE host task when the write completes.
+     * @return A future that completes when the peer has acknowledged the write.
+     */
+    NimBLEGattFuture writeValueAsync(const uint8_t* data, size_t length, const NimBLEGattFuture::Callback& callback = nullptr);
+
     /**
      * Get the client instance that owns this attribute.
      */
@@ -166,6 +183,9 @@ class NimBLERemoteValueAttribute : public NimBLEValueAttribute, public NimBLEAtt
      */
     virtual ~NimBLERemoteValueAttribute() = default;
 
+    friend class NimBLEClient;
+    friend class NimBLEGattFuture;
+
     static int onReadCB(uint16_t conn_handle, const ble_gatt_error* error, ble_gatt_attr* attr, void* arg);
     static int onWriteCB(uint16_t conn_handle, const ble_gatt_error* error, ble_gatt_attr* attr, void* arg);
 };
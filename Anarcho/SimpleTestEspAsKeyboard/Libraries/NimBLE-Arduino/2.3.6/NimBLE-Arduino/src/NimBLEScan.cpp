@@ -27,6 +27,9 @@
 static const char*         LOG_TAG = "NimBLEScan";
 static NimBLEScanCallbacks defaultScanCallbacks;
 
+// Devices only live until their scan response arrives when results are not stored (maxResults = 0).
+static const uint16_t CALLBACK_POOL_SIZE = 8;
+
 /**
  * @brief Scan constructor.
  */
@@ -35,14 +38,16 @@ NimBLEScan::NimBLEScan()
       // default interval + window, no whitelist scan filter,not limited scan, no scan response, filter_duplicates
       m_scanParams{0, 0, BLE_HCI_SCAN_FILT_NO_WL, 0, 1, 1},
       m_pTaskData{nullptr},
-      m_maxResults{0xFF} {}
+      m_maxResults{0xFF} {
+    m_devicePool.reserve(CALLBACK_POOL_SIZE);
+}
 
 /**
  * @brief Scan destructor, release any allocated resources.
  */
 NimBLEScan::~NimBLEScan() {
     for (const auto& dev : m_scanResults.m_deviceVec) {
-        delete dev;
+        m_devicePool.release(dev);
     }
 }
 
@@ -72,31 +77,49 @@ int NimBLEScan::handleGapEvent(ble_gap_event* event, void* arg) {
             const bool  isLegacyAdv = true;
             const auto  event_type  = disc.event_type;
 # endif
+# if CONFIG_BT_NIMBLE_EXT_ADV
+            // Same address but different set ID should create a new advertised device.
+            const uint8_t sid = disc.sid;
+# else
+            const uint8_t sid = 0;
+# endif
+# if CONFIG_BT_NIMBLE_EXT_ADV
+            const uint8_t dataStatus = disc.data_status;
+# else
+            const uint8_t dataStatus = 0;
+# endif
+
+            // In streaming mode reports are only copied to the ring, the application task reads them from there.
+            if (pScan->m_stream.capacity() > 0) {
+                pScan->streamReport(disc.addr,
+                                    disc.rssi,
+                                    event_type,
+                                    sid,
+                                    dataStatus,
+                                    disc.data,
+                                    disc.length_data,
+                                    isLegacyAdv);
+                return 0;
+            }
+
+            // If we've seen this device before get a pointer to it from the index
+            NimBLEAdvertisedDevice* advertisedDevice = pScan->findDevice(disc.addr, sid);
+
+            // Check the address and RSSI of new advertisers on the raw report, before anything is allocated.
+            if (advertisedDevice == nullptr && !pScan->m_filter.isEmpty() &&
+                !pScan->m_filter.matchAddress(disc.addr, disc.rssi)) {
+                return 0;
+            }
+
             NimBLEAddress advertisedAddress(disc.addr);
 
 # if CONFIG_BT_NIMBLE_ROLE_CENTRAL
-            // stop processing if already connected
-            NimBLEClient* pClient = NimBLEDevice::getClientByPeerAddress(advertisedAddress);
-            if (pClient != nullptr && pClient->isConnected()) {
-                NIMBLE_LOGI(LOG_TAG, "Ignoring device: address: %s, already connected", advertisedAddress.toString().c_str());
+            // stop processing if already connected, the index only holds connected clients
+            if (NimBLEDevice::m_clientIndex.findByAddress(disc.addr.type, disc.addr.val) != nullptr) {
+                NIMBLE_LOGI(LOG_TAG, "Ignoring device: address: %s, already connected", NIMBLE_LOG_ADDR(advertisedAddress));
                 return 0;
             }
 # endif
-            NimBLEAdvertisedDevice* advertisedDevice = nullptr;
-
-            // If we've seen this device before get a pointer to it from the vector
-            for (const auto& dev : pScan->m_scanResults.m_deviceVec) {
-# if CONFIG_BT_NIMBLE_EXT_ADV
-                // Same address but different set ID should create a new advertised device.
-                if (dev->getAddress() == advertisedAddress && dev->getSetId() == disc.sid)
-# else
-                if (dev->getAddress() == advertisedAddress)
-# endif
-                {
-                    advertisedDevice = dev;
-                    break;
-                }
-            }
 
             // If we haven't seen this device before; create a new instance and insert it in the vector.
             // Otherwise just update the relevant parameters of the already known device.
@@ -109,19 +132,34 @@ int NimBLEScan::handleGapEvent(ble_gap_event* event, void* arg) {
                 }
 
                 if (isLegacyAdv && event_type == BLE_HCI_ADV_RPT_EVTYPE_SCAN_RSP) {
-                    NIMBLE_LOGI(LOG_TAG, "Scan response without advertisement: %s", advertisedAddress.toString().c_str());
+                    NIMBLE_LOGI(LOG_TAG, "Scan response without advertisement: %s", NIMBLE_LOG_ADDR(advertisedAddress));
+                }
+
+                // A complete report with no scan response to wait for is checked on its own content, so that
+                // rejected advertisers never take a device.
+                bool filterPending = pScan->m_filter.hasContentCriteria();
+                if (filterPending && dataStatus == BLE_HCI_ADV_DATA_STATUS_COMPLETE) {
+                    const bool scannable = isLegacyAdv && (event_type == BLE_HCI_ADV_RPT_EVTYPE_ADV_IND ||
+                                                           event_type == BLE_HCI_ADV_RPT_EVTYPE_SCAN_IND);
+                    if (pScan->m_scanParams.passive || !scannable) {
+                        if (!pScan->m_filter.matchContent(disc.data, disc.length_data, true)) {
+                            return 0;
+                        }
+                        filterPending = false;
+                    }
                 }
 
-                advertisedDevice = new NimBLEAdvertisedDevice(event, event_type);
-                pScan->m_scanResults.m_deviceVec.push_back(advertisedDevice);
-                NIMBLE_LOGI(LOG_TAG, "New advertiser: %s", advertisedAddress.toString().c_str());
+                advertisedDevice                  = pScan->m_devicePool.acquire(event, event_type);
+                advertisedDevice->m_filterPending = filterPending;
+                pScan->addDevice(advertisedDevice, sid);
+                NIMBLE_LOGI(LOG_TAG, "New advertiser: %s", NIMBLE_LOG_ADDR(advertisedAddress));
             } else {
-                advertisedDevice->update(event, event_type);
+                pScan->m_devicePool.update(advertisedDevice, event, event_type);
                 if (isLegacyAdv) {
                     if (event_type == BLE_HCI_ADV_RPT_EVTYPE_SCAN_RSP) {
-                        NIMBLE_LOGI(LOG_TAG, "Scan response from: %s", advertisedAddress.toString().c_str());
+                        NIMBLE_LOGI(LOG_TAG, "Scan response from: %s", NIMBLE_LOG_ADDR(advertisedAddress));
                     } else {
-                        NIMBLE_LOGI(LOG_TAG, "Duplicate; updated: %s", advertisedAddress.toString().c_str());
+                        NIMBLE_LOGI(LOG_TAG, "Duplicate; updated: %s", NIMBLE_LOG_ADDR(advertisedAddress));
                     }
                 }
             }
@@ -133,6 +171,23 @@ int NimBLEScan::handleGapEvent(ble_gap_event* event, void* arg) {
             }
 # endif
 
+            // The content criteria are checked on the complete payload. A scannable advertiser may carry the
+            // wanted data in its scan response, it is kept without callbacks until the response arrives.
+            if (advertisedDevice->m_filterPending) {
+                const bool waitForScanRsp = !pScan->m_scanParams.passive && isLegacyAdv &&
+                                            advertisedDevice->isScannable() &&
+                                            event_type != BLE_HCI_ADV_RPT_EVTYPE_SCAN_RSP;
+                const auto& payload = advertisedDevice->getPayload();
+                if (!pScan->m_filter.matchContent(payload.data(), payload.size(), !waitForScanRsp)) {
+                    if (!waitForScanRsp) {
+                        pScan->erase(advertisedDevice);
+                    }
+                    return 0;
+                }
+
+                advertisedDevice->m_filterPending = false;
+            }
+
             if (!advertisedDevice->m_callbackSent) {
                 advertisedDevice->m_callbackSent++;
                 pScan->m_pScanCallbacks->onDiscovered(advertisedDevice);
@@ -162,7 +217,10 @@ int NimBLEScan::handleGapEvent(ble_gap_event* event, void* arg) {
 
             if (pScan->m_maxResults == 0) {
                 pScan->clearResults();
+            } else {
+                pScan->removeFilterPending();
             }
+            pScan->m_held.active = false;
 
             pScan->m_pScanCallbacks->onScanEnd(pScan->m_scanResults, event->disc_complete.reason);
 
@@ -236,11 +294,102 @@ void NimBLEScan::setFilterPolicy(uint8_t filter) {
  * @brief Sets the max number of results to store.
  * @param [in] maxResults The number of results to limit storage to\n
  * 0 == none (callbacks only) 0xFF == unlimited, any other value is the limit.
+ * @details A limit also sizes the device pool, so a scan within the limit does not allocate from the heap.
+ * With no limit the pool keeps a small default size and further devices are allocated from the heap.
  */
 void NimBLEScan::setMaxResults(uint8_t maxResults) {
     m_maxResults = maxResults;
+    if (maxResults > 0 && maxResults < 0xFF) {
+        m_scanIndex.reserve(maxResults);
+        m_devicePool.reserve(maxResults);
+    } else {
+        m_devicePool.reserve(CALLBACK_POOL_SIZE);
+    }
 } // setMaxResults
 
+/**
+ * @brief Get the usage statistics of the advertised device pool.
+ * @return The pool capacity, occupancy, high water mark and the number of heap fallbacks.
+ */
+NimBLEAdvertisedDevicePool::Stats NimBLEScan::getPoolStats() const {
+    return m_devicePool.getStats();
+} // getPoolStats
+
+/**
+ * @brief Reset the high water mark and the heap fallback counters of the advertised device pool.
+ */
+void NimBLEScan::resetPoolStats() {
+    m_devicePool.resetStats();
+} // resetPoolStats
+
+/**
+ * @brief Set the criteria new advertisers must meet to be reported and stored.
+ * @param [in] filter The filter criteria, copied into the scan.
+ * @details Reports whose address or RSSI do not match are dropped in the GAP event handler before a
+ * device is created. The content criteria are checked once the data is complete, including the scan
+ * response of a scannable advertiser; until then no callbacks are invoked and a device that fails is
+ * deleted. Devices still waiting when the scan ends are deleted too. The filter hit counters are reset.
+ * @note Set the filter while the scan is stopped.
+ */
+void NimBLEScan::setFilter(const NimBLEScanFilter& filter) {
+    m_filter = filter;
+    m_filter.resetStats();
+} // setFilter
+
+/**
+ * @brief Remove all filter criteria, every advertiser is reported again.
+ */
+void NimBLEScan::clearFilter() {
+    m_filter.clear();
+} // clearFilter
+
+/**
+ * @brief Get the filter hit counters.
+ * @return The number of evaluated and passed reports and the rejections per criterion.
+ */
+NimBLEScanFilter::Stats NimBLEScan::getFilterStats() const {
+    return m_filter.getStats();
+} // getFilterStats
+
+/**
+ * @brief Reset the filter hit counters.
+ */
+void NimBLEScan::resetFilterStats() {
+    m_filter.resetStats();
+} // resetFilterStats
+
+/**
+ * @brief Enable or disable the streaming mode.
+ * @param [in] capacity The number of records the ring holds, rounded up to a power of two, 0 to disable.
+ * @return True if the ring was allocated, or streaming was disabled.
+ * @details In streaming mode every report that passes the filter is copied into a ring of compact
+ * NimBLEScanRecord entries and the GAP event handler returns. No devices are created or stored and
+ * onDiscovered/onResult are not called, an application task reads the records with getStream().
+ * When the consumer falls behind new reports are dropped and counted as overruns.
+ * @note Call while the scan is stopped.
+ */
+bool NimBLEScan::setStreaming(uint16_t capacity) {
+    if (capacity == 0) {
+        m_stream.end();
+        return true;
+    }
+
+    if (!m_stream.begin(capacity)) {
+        NIMBLE_LOGE(LOG_TAG, "Failed to allocate scan stream of %u records", capacity);
+        return false;
+    }
+
+    return true;
+} // setStreaming
+
+/**
+ * @brief Get the ring the streaming mode writes to.
+ * @return The ring, read it from a single application task with pop() or peek()/consume().
+ */
+NimBLEScanRing& NimBLEScan::getStream() {
+    return m_stream;
+} // getStream
+
 /**
  * @brief Set the call backs to be invoked.
  * @param [in] pScanCallbacks Call backs to be invoked.
@@ -396,7 +545,10 @@ bool NimBLEScan::stop() {
 
     if (m_maxResults == 0) {
         clearResults();
+    } else {
+        removeFilterPending();
     }
+    m_held.active = false;
 
     if (m_pTaskData != nullptr) {
         NimBLEUtils::taskRelease(*m_pTaskData);
@@ -406,19 +558,193 @@ bool NimBLEScan::stop() {
     return true;
 } // stop
 
+/**
+ * @brief Find a stored device by its address and advertising set ID.
+ * @param [in] addr The address of the device.
+ * @param [in] sid The advertising set ID, 0 for legacy advertising.
+ * @return A pointer to the device or nullptr if not found.
+ */
+NimBLEAdvertisedDevice* NimBLEScan::findDevice(const ble_addr_t& addr, uint8_t sid) const {
+    const uint16_t pos = m_scanIndex.find(addr.val, addr.type, sid);
+    if (pos == NimBLEScanIndex::NOT_FOUND) {
+        return nullptr;
+    }
+
+    return m_scanResults.m_deviceVec[pos];
+} // findDevice
+
+/**
+ * @brief Append a device to the scan results and index it.
+ * @param [in] pDevice The device to add.
+ * @param [in] sid The advertising set ID, 0 for legacy advertising.
+ */
+void NimBLEScan::addDevice(NimBLEAdvertisedDevice* pDevice, uint8_t sid) {
+    const ble_addr_t* addr = pDevice->getAddress().getBase();
+    m_scanResults.m_deviceVec.push_back(pDevice);
+    m_scanIndex.insert(addr->val, addr->type, sid, m_scanResults.m_deviceVec.size() - 1);
+} // addDevice
+
+/**
+ * @brief Delete the device at the given position of the results vector.
+ * @details Stored results keep their order, the index positions behind the device are shifted down.
+ * When results are not stored (maxResults 0) the vector only holds devices waiting for their scan
+ * response, there the last device is moved into the freed position instead, which is O(1).
+ * @param [in] pos The position of the device in the results vector.
+ */
+void NimBLEScan::removeDevice(size_t pos) {
+    auto&                   devices = m_scanResults.m_deviceVec;
+    NimBLEAdvertisedDevice* pDevice = devices[pos];
+    NimBLEAdvertisedDevice* pLast   = devices.back();
+# if CONFIG_BT_NIMBLE_EXT_ADV
+    const uint8_t sid     = pDevice->getSetId();
+    const uint8_t lastSid = pLast->getSetId();
+# else
+    const uint8_t sid     = 0;
+    const uint8_t lastSid = 0;
+# endif
+
+    const ble_addr_t* addr = pDevice->getAddress().getBase();
+    m_scanIndex.erase(addr->val, addr->type, sid);
+    if (pLast == pDevice) {
+        devices.pop_back();
+    } else if (m_maxResults == 0) {
+        const ble_addr_t* lastAddr = pLast->getAddress().getBase();
+        devices[pos]               = pLast;
+        m_scanIndex.update(lastAddr->val, lastAddr->type, lastSid, pos);
+        devices.pop_back();
+    } else {
+        m_scanIndex.removePosition(pos);
+        devices.erase(devices.begin() + pos);
+    }
+
+    m_devicePool.release(pDevice);
+} // removeDevice
+
+/**
+ * @brief Delete the devices still waiting for the data the content filter needs, called when the scan ends.
+ */
+void NimBLEScan::removeFilterPending() {
+    auto& devices = m_scanResults.m_deviceVec;
+    for (size_t i = devices.size(); i-- > 0;) {
+        if (devices[i]->m_filterPending) {
+            removeDevice(i);
+        }
+    }
+} // removeFilterPending
+
+/**
+ * @brief Filter a report and copy it into the stream ring.
+ * @param [in] addr The advertiser address.
+ * @param [in] rssi The RSSI of the report.
+ * @param [in] eventType The event type or extended advertising properties.
+ * @param [in] sid The advertising set ID.
+ * @param [in] dataStatus The extended advertising data status, 0 for legacy reports.
+ * @param [in] data The report payload.
+ * @param [in] length The payload length.
+ * @param [in] isLegacyAdv True for a legacy advertising report.
+ * @details Without content criteria each report is checked and pushed on its own. With content criteria
+ * the fragments of an extended advertisement are collected and checked once the last one arrives, then
+ * pushed as one record. The advertisement of a scannable legacy advertiser that does not match is held
+ * until its scan response arrives, both are checked together and pushed if they match. One report is
+ * held at a time, a report from another advertiser drops it.
+ */
+void NimBLEScan::streamReport(const ble_addr_t& addr,
+                              int8_t            rssi,
+                              uint8_t           eventType,
+                              uint8_t           sid,
+                              uint8_t           dataStatus,
+                              const uint8_t*    data,
+                              size_t            length,
+                              bool              isLegacyAdv) {
+    if (m_filter.isEmpty()) {
+        m_stream.push(addr.val, addr.type, rssi, eventType, sid, dataStatus, data, length);
+        return;
+    }
+
+    if (!m_filter.hasContentCriteria()) {
+        if (m_filter.matchAddress(addr, rssi)) {
+            m_stream.push(addr.val, addr.type, rssi, eventType, sid, dataStatus, data, length);
+        }
+        return;
+    }
+
+    HeldReport& held      = m_held;
+    const bool  continues = held.active && held.sid == sid && ble_addr_cmp(&held.addr, &addr) == 0;
+    held.active           = false;
+
+    if (continues && held.chained) {
+        held.data.insert(held.data.end(), data, data + length);
+# if CONFIG_BT_NIMBLE_EXT_ADV
+        if (dataStatus == BLE_GAP_EXT_ADV_DATA_STATUS_INCOMPLETE) {
+            held.active = true;
+            return;
+        }
+# endif
+        if (m_filter.matchContent(held.data.data(), held.data.size())) {
+            m_stream.push(addr.val, addr.type, held.rssi, held.eventType, sid, dataStatus, held.data.data(), held.data.size());
+        }
+        return;
+    }
+
+    if (continues && isLegacyAdv && eventType == BLE_HCI_ADV_RPT_EVTYPE_SCAN_RSP) {
+        held.data.insert(held.data.end(), data, data + length);
+        if (m_filter.matchContent(held.data.data(), held.data.size())) {
+            m_stream.push(addr.val, addr.type, held.rssi, held.eventType, sid, 0, held.data.data(), held.advLength);
+            m_stream.push(addr.val, addr.type, rssi, eventType, sid, dataStatus, data, length);
+        }
+        return;
+    }
+
+    if (!m_filter.matchAddress(addr, rssi)) {
+        return;
+    }
+
+# if CONFIG_BT_NIMBLE_EXT_ADV
+    const bool chained = dataStatus == BLE_GAP_EXT_ADV_DATA_STATUS_INCOMPLETE;
+# else
+    const bool chained = false;
+# endif
+    const bool waitForScanRsp =
+        !chained && !m_scanParams.passive && isLegacyAdv &&
+        (eventType == BLE_HCI_ADV_RPT_EVTYPE_ADV_IND || eventType == BLE_HCI_ADV_RPT_EVTYPE_SCAN_IND);
+    if (!chained && m_filter.matchContent(data, length, !waitForScanRsp)) {
+        m_stream.push(addr.val, addr.type, rssi, eventType, sid, dataStatus, data, length);
+        return;
+    }
+
+    if (chained || waitForScanRsp) {
+        held.data.assign(data, data + length);
+        held.addr      = addr;
+        held.sid       = sid;
+        held.rssi      = rssi;
+        held.eventType = eventType;
+        held.advLength = static_cast<uint8_t>(length);
+        held.chained   = chained;
+        held.active    = true;
+    }
+} // streamReport
+
 /**
  * @brief Delete peer device from the scan results vector.
  * @param [in] address The address of the device to delete from the results.
  */
 void NimBLEScan::erase(const NimBLEAddress& address) {
     NIMBLE_LOGD(LOG_TAG, "erase device: %s", address.toString().c_str());
-    for (auto it = m_scanResults.m_deviceVec.begin(); it != m_scanResults.m_deviceVec.end(); ++it) {
-        if ((*it)->getAddress() == address) {
-            delete *it;
-            m_scanResults.m_deviceVec.erase(it);
+# if CONFIG_BT_NIMBLE_EXT_ADV
+    // The set ID is not known here, delete the first device with this address.
+    const auto& devices = m_scanResults.m_deviceVec;
+    for (size_t i = 0; i < devices.size(); i++) {
+        if (devices[i]->getAddress() == address) {
+            removeDevice(i);
             break;
         }
     }
+# else
+    const uint16_t pos = m_scanIndex.find(address.getBase()->val, address.getType(), 0);
+    if (pos != NimBLEScanIndex::NOT_FOUND) {
+        removeDevice(pos);
+    }
+# endif
 }
 
 /**
@@ -427,12 +753,15 @@ void NimBLEScan::erase(const NimBLEAddress& address) {
  */
 void NimBLEScan::erase(const NimBLEAdvertisedDevice* device) {
     NIMBLE_LOGD(LOG_TAG, "erase device: %s", device->getAddress().toString().c_str());
-    for (auto it = m_scanResults.m_deviceVec.begin(); it != m_scanResults.m_deviceVec.end(); ++it) {
-        if ((*it) == device) {
-            delete *it;
-            m_scanResults.m_deviceVec.erase(it);
-            break;
-        }
+# if CONFIG_BT_NIMBLE_EXT_ADV
+    const uint8_t sid = device->getSetId();
+# else
+    const uint8_t sid = 0;
+# endif
+    const ble_addr_t* addr = device->getAddress().getBase();
+    const uint16_t    pos  = m_scanIndex.find(addr->val, addr->type, sid);
+    if (pos != NimBLEScanIndex::NOT_FOUND && m_scanResults.m_deviceVec[pos] == device) {
+        removeDevice(pos);
     }
 }
 
@@ -487,9 +816,11 @@ void NimBLEScan::clearResults() {
         std::vector<NimBLEAdvertisedDevice*> vSwap{};
         ble_npl_hw_enter_critical();
         vSwap.swap(m_scanResults.m_deviceVec);
+        // Keeps the table allocated so a size reserved by setMaxResults survives into the next scan.
+        m_scanIndex.clear();
         ble_npl_hw_exit_critical(0);
         for (const auto& dev : vSwap) {
-            delete dev;
+            m_devicePool.release(dev);
         }
     }
 } // clearResults
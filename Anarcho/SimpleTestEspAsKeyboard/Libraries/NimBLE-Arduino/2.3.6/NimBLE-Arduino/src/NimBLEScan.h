@@ -22,6 +22,10 @@
 #if CONFIG_BT_ENABLED && CONFIG_BT_NIMBLE_ROLE_OBSERVER
 
 # include "NimBLEAdvertisedDevice.h"
+# include "NimBLEAdvertisedDevicePool.h"
+# include "NimBLEScanFilter.h"
+# include "NimBLEScanIndex.h"
+# include "NimBLEScanRing.h"
 # include "NimBLEUtils.h"
 
 # if defined(CONFIG_NIMBLE_CPP_IDF)
@@ -83,6 +87,15 @@ class NimBLEScan {
     void              erase(const NimBLEAddress& address);
     void              erase(const NimBLEAdvertisedDevice* device);
 
+    NimBLEAdvertisedDevicePool::Stats getPoolStats() const;
+    void                              resetPoolStats();
+    void                              setFilter(const NimBLEScanFilter& filter);
+    void                              clearFilter();
+    NimBLEScanFilter::Stats           getFilterStats() const;
+    void                              resetFilterStats();
+    bool                              setStreaming(uint16_t capacity);
+    NimBLEScanRing&                   getStream();
+
 # if CONFIG_BT_NIMBLE_EXT_ADV
     enum Phy { SCAN_1M = 0x01, SCAN_CODED = 0x02, SCAN_ALL = 0x03 };
     void setPhy(Phy phyMask);
@@ -94,14 +107,45 @@ class NimBLEScan {
 
     NimBLEScan();
     ~NimBLEScan();
-    static int handleGapEvent(ble_gap_event* event, void* arg);
-    void       onHostSync();
-
-    NimBLEScanCallbacks* m_pScanCallbacks;
-    ble_gap_disc_params  m_scanParams;
-    NimBLEScanResults    m_scanResults;
-    NimBLETaskData*      m_pTaskData;
-    uint8_t              m_maxResults;
+    static int              handleGapEvent(ble_gap_event* event, void* arg);
+    void                    onHostSync();
+    NimBLEAdvertisedDevice* findDevice(const ble_addr_t& addr, uint8_t sid) const;
+    void                    addDevice(NimBLEAdvertisedDevice* pDevice, uint8_t sid);
+    void                    removeDevice(size_t pos);
+    void                    removeFilterPending();
+    void                    streamReport(const ble_addr_t& addr,
+                                         int8_t            rssi,
+                                         uint8_t           eventType,
+                                         uint8_t           sid,
+                                         uint8_t           dataStatus,
+                                         const uint8_t*    data,
+                                         size_t            length,
+                                         bool              isLegacyAdv);
+
+    /**
+     * @brief A report held back in streaming mode until the data for the content filter is complete.
+     */
+    struct HeldReport {
+        std::vector<uint8_t> data;      // Collected payload, the advertisement first.
+        ble_addr_t           addr;      // Advertiser address.
+        uint8_t              sid;       // Advertising set ID.
+        int8_t               rssi;      // RSSI of the first report.
+        uint8_t              eventType; // Event type of the first report.
+        uint8_t              advLength; // Length of the held advertisement, when waiting for a scan response.
+        bool                 chained;   // True for extended advertising fragments, false for a scan response.
+        bool                 active;    // True while a report is held.
+    };
+
+    NimBLEScanCallbacks*       m_pScanCallbacks;
+    ble_gap_disc_params        m_scanParams;
+    NimBLEScanResults          m_scanResults;
+    NimBLEScanIndex            m_scanIndex;
+    NimBLEAdvertisedDevicePool m_devicePool;
+    NimBLEScanFilter           m_filter;
+    NimBLEScanRing             m_stream;
+    HeldReport                 m_held{};
+    NimBLETaskData*            m_pTaskData;
+    uint8_t                    m_maxResults;
 
 # if CONFIG_BT_NIMBLE_EXT_ADV
     uint8_t  m_phy{SCAN_ALL};
@@ -0,0 +1,288 @@
+/*
+ * Copyright 2020-2025 Ryan Powell <ryan@nable-embedded.io> and
+ * esp-nimble-cpp, NimBLE-Arduino contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NimBLEScanFilter.h"
+#if CONFIG_BT_ENABLED && CONFIG_BT_NIMBLE_ROLE_OBSERVER
+
+# if defined(CONFIG_NIMBLE_CPP_IDF)
+#  include "host/ble_hs_adv.h"
+# else
+#  include "nimble/nimble/host/include/host/ble_hs_adv.h"
+# endif
+
+# include <string.h>
+
+/**
+ * @brief Copy the criteria of another filter, the hit counters start at 0.
+ * @param [in] other The filter to copy.
+ */
+NimBLEScanFilter::NimBLEScanFilter(const NimBLEScanFilter& other)
+    : m_serviceUUIDs(other.m_serviceUUIDs),
+      m_companyIds(other.m_companyIds),
+      m_addresses(other.m_addresses),
+      m_namePrefix(other.m_namePrefix),
+      m_minRSSI(other.m_minRSSI) {} // NimBLEScanFilter
+
+/**
+ * @brief Copy the criteria of another filter, the hit counters are kept.
+ * @param [in] other The filter to copy.
+ * @return A reference to this filter.
+ */
+NimBLEScanFilter& NimBLEScanFilter::operator=(const NimBLEScanFilter& other) {
+    if (this != &other) {
+        m_serviceUUIDs = other.m_serviceUUIDs;
+        m_companyIds   = other.m_companyIds;
+        m_addresses    = other.m_addresses;
+        m_namePrefix   = other.m_namePrefix;
+        m_minRSSI      = other.m_minRSSI;
+    }
+
+    return *this;
+} // operator=
+
+/**
+ * @brief Accept advertisers listing this service UUID.
+ * @param [in] uuid The service UUID, matched against the complete and incomplete UUID lists.
+ * @return A reference to this filter.
+ */
+NimBLEScanFilter& NimBLEScanFilter::addServiceUUID(const NimBLEUUID& uuid) {
+    m_serviceUUIDs.push_back(uuid);
+    return *this;
+} // addServiceUUID
+
+/**
+ * @brief Accept advertisers with manufacturer data from this company.
+ * @param [in] companyId The Bluetooth SIG company identifier, the first 2 bytes of the manufacturer data.
+ * @return A reference to this filter.
+ */
+NimBLEScanFilter& NimBLEScanFilter::addCompanyId(uint16_t companyId) {
+    m_companyIds.push_back(companyId);
+    return *this;
+} // addCompanyId
+
+/**
+ * @brief Accept only advertisers whose complete or shortened name starts with the prefix.
+ * @param [in] prefix The name prefix, an empty string disables the criterion.
+ * @return A reference to this filter.
+ */
+NimBLEScanFilter& NimBLEScanFilter::setNamePrefix(const std::string& prefix) {
+    m_namePrefix = prefix;
+    return *this;
+} // setNamePrefix
+
+/**
+ * @brief Accept only reports received with at least this signal strength.
+ * @param [in] rssi The minimum RSSI in dBm, -128 disables the criterion.
+ * @return A reference to this filter.
+ */
+NimBLEScanFilter& NimBLEScanFilter::setMinRSSI(int8_t rssi) {
+    m_minRSSI = rssi;
+    return *this;
+} // setMinRSSI
+
+/**
+ * @brief Accept advertisers with this address.
+ * @param [in] address The address, the address type must match too.
+ * @return A reference to this filter.
+ */
+NimBLEScanFilter& NimBLEScanFilter::addAddress(const NimBLEAddress& address) {
+    m_addresses.push_back(address);
+    return *this;
+} // addAddress
+
+/**
+ * @brief Remove all criteria, the statistics are kept.
+ */
+void NimBLEScanFilter::clear() {
+    m_serviceUUIDs.clear();
+    m_companyIds.clear();
+    m_addresses.clear();
+    m_namePrefix.clear();
+    m_minRSSI = -128;
+} // clear
+
+/**
+ * @brief Check if no criterion is configured.
+ */
+bool NimBLEScanFilter::isEmpty() const {
+    return m_serviceUUIDs.empty() && m_companyIds.empty() && m_addresses.empty() && m_namePrefix.empty() &&
+           m_minRSSI == -128;
+} // isEmpty
+
+/**
+ * @brief Check if a service UUID, company ID or name criterion is configured.
+ */
+bool NimBLEScanFilter::hasContentCriteria() const {
+    return !m_serviceUUIDs.empty() || !m_companyIds.empty() || !m_namePrefix.empty();
+} // hasContentCriteria
+
+/**
+ * @brief Check the address and RSSI of a report from a new advertiser and count the result.
+ * @param [in] addr The advertiser address.
+ * @param [in] rssi The RSSI of the report.
+ * @return True if both criteria match. Without content criteria the advertiser is counted as passed,
+ * otherwise matchContent() decides once the data is complete.
+ */
+bool NimBLEScanFilter::matchAddress(const ble_addr_t& addr, int8_t rssi) {
+    m_evaluated.fetch_add(1, std::memory_order_relaxed);
+
+    if (!m_addresses.empty()) {
+        bool found = false;
+        for (const auto& address : m_addresses) {
+            if (address.getType() == addr.type && memcmp(address.getVal(), addr.val, sizeof(addr.val)) == 0) {
+                found = true;
+                break;
+            }
+        }
+
+        if (!found) {
+            m_rejectedAddress.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+
+    if (rssi < m_minRSSI) {
+        m_rejectedRSSI.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    if (!hasContentCriteria()) {
+        m_passed.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return true;
+} // matchAddress
+
+/**
+ * @brief Match the service UUID, company ID and name criteria in a single walk over the AD structures.
+ * @param [in] data The complete advertisement data, followed by the scan response data if there is one.
+ * @param [in] length The length of the data.
+ * @param [in] final False if more data may still arrive (a scan response), a failure is then not counted.
+ * @return True if all content criteria match.
+ */
+bool NimBLEScanFilter::matchContent(const uint8_t* data, size_t length, bool final) {
+    bool serviceFound = m_serviceUUIDs.empty();
+    bool companyFound = m_companyIds.empty();
+    bool nameFound    = m_namePrefix.empty();
+
+    size_t pos = 0;
+    while (length - pos > 2 && !(serviceFound && companyFound && nameFound)) {
+        const uint8_t  fieldLength = data[pos];
+        const uint8_t  type        = data[pos + 1];
+        const uint8_t* value       = data + pos + 2;
+        if (fieldLength >= length - pos) {
+            break;
+        }
+
+        const uint8_t valueLength = fieldLength > 0 ? fieldLength - 1 : 0;
+        switch (type) {
+            case BLE_HS_ADV_TYPE_INCOMP_UUIDS16:
+            case BLE_HS_ADV_TYPE_COMP_UUIDS16:
+            case BLE_HS_ADV_TYPE_INCOMP_UUIDS32:
+            case BLE_HS_ADV_TYPE_COMP_UUIDS32:
+            case BLE_HS_ADV_TYPE_INCOMP_UUIDS128:
+            case BLE_HS_ADV_TYPE_COMP_UUIDS128: {
+                if (serviceFound) {
+                    break;
+                }
+
+                const uint8_t uuidBytes = type < BLE_HS_ADV_TYPE_INCOMP_UUIDS32    ? 2
+                                          : type < BLE_HS_ADV_TYPE_INCOMP_UUIDS128 ? 4
+                                                                                   : 16;
+                for (uint8_t i = 0; i + uuidBytes <= valueLength && !serviceFound; i += uuidBytes) {
+                    const NimBLEUUID uuid(value + i, uuidBytes);
+                    for (const auto& wanted : m_serviceUUIDs) {
+                        if (wanted == uuid) {
+                            serviceFound = true;
+                            break;
+                        }
+                    }
+                }
+                break;
+            }
+
+            case BLE_HS_ADV_TYPE_MFG_DATA: {
+                if (companyFound || valueLength < 2) {
+                    break;
+                }
+
+                const uint16_t companyId = value[0] | value[1] << 8;
+                for (const auto& wanted : m_companyIds) {
+                    if (wanted == companyId) {
+                        companyFound = true;
+                        break;
+                    }
+                }
+                break;
+            }
+
+            case BLE_HS_ADV_TYPE_COMP_NAME:
+            case BLE_HS_ADV_TYPE_INCOMP_NAME:
+                if (!nameFound && valueLength >= m_namePrefix.length()) {
+                    nameFound = memcmp(value, m_namePrefix.data(), m_namePrefix.length()) == 0;
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        pos += 1 + fieldLength;
+    }
+
+    if (serviceFound && companyFound && nameFound) {
+        m_passed.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    if (final) {
+        auto& rejected = !serviceFound ? m_rejectedService : !companyFound ? m_rejectedCompany : m_rejectedName;
+        rejected.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return false;
+} // matchContent
+
+/**
+ * @brief Get the filter hit counters.
+ */
+NimBLEScanFilter::Stats NimBLEScanFilter::getStats() const {
+    Stats stats{};
+    stats.evaluated       = m_evaluated.load(std::memory_order_relaxed);
+    stats.passed          = m_passed.load(std::memory_order_relaxed);
+    stats.rejectedAddress = m_rejectedAddress.load(std::memory_order_relaxed);
+    stats.rejectedRSSI    = m_rejectedRSSI.load(std::memory_order_relaxed);
+    stats.rejectedService = m_rejectedService.load(std::memory_order_relaxed);
+    stats.rejectedCompany = m_rejectedCompany.load(std::memory_order_relaxed);
+    stats.rejectedName    = m_rejectedName.load(std::memory_order_relaxed);
+    return stats;
+} // getStats
+
+/**
+ * @brief Reset the filter hit counters.
+ */
+void NimBLEScanFilter::resetStats() {
+    m_evaluated.store(0, std::memory_order_relaxed);
+    m_passed.store(0, std::memory_order_relaxed);
+    m_rejectedAddress.store(0, std::memory_order_relaxed);
+    m_rejectedRSSI.store(0, std::memory_order_relaxed);
+    m_rejectedService.store(0, std::memory_order_relaxed);
+    m_rejectedCompany.store(0, std::memory_order_relaxed);
+    m_rejectedName.store(0, std::memory_order_relaxed);
+} // resetStats
+
+#endif /* CONFIG_BT_ENABLED && CONFIG_BT_NIMBLE_ROLE_OBSERVER */
@@ -0,0 +1,96 @@
+/*
+ * Copyright 2020-2025 Ryan Powell <ryan@nable-embedded.io> and
+ * esp-nimble-cpp, NimBLE-Arduino contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NIMBLE_CPP_SCAN_FILTER_H_
+#define NIMBLE_CPP_SCAN_FILTER_H_
+
+#include "nimconfig.h"
+#if CONFIG_BT_ENABLED && CONFIG_BT_NIMBLE_ROLE_OBSERVER
+
+# include "NimBLEAddress.h"
+# include "NimBLEUUID.h"
+
+# if defined(CONFIG_NIMBLE_CPP_IDF)
+#  include "host/ble_gap.h"
+# else
+#  include "nimble/nimble/host/include/host/ble_gap.h"
+# endif
+
+# include <atomic>
+# include <string>
+# include <vector>
+
+/**
+ * @brief Criteria a new advertiser has to meet before the scan creates a device for it.
+ * @details Each configured criterion must match, a list criterion matches if any of its entries does.
+ * NimBLEScan checks the address and RSSI criteria on the raw report received from the stack, before any
+ * device is allocated. The content criteria (service UUID, company ID, name prefix) are checked once the
+ * data is complete. A report that is complete on its own is checked before allocation as well. A chained
+ * extended advertisement is checked after its last fragment. A scannable legacy advertiser under active
+ * scanning is checked on the advertisement together with its scan response. Until then no callback is
+ * invoked, a device that fails is discarded.
+ * Devices that passed are not filtered again. The hit counters may be read from any task.
+ */
+class NimBLEScanFilter {
+  public:
+    /**
+     * @brief Filter hit counters.
+     */
+    struct Stats {
+        uint32_t evaluated;       // Reports of new advertisers checked against the filter.
+        uint32_t passed;          // Advertisers that matched all criteria.
+        uint32_t rejectedAddress; // Rejected by the address allow-list.
+        uint32_t rejectedRSSI;    // Rejected by the RSSI threshold.
+        uint32_t rejectedService; // Rejected by the service UUID list.
+        uint32_t rejectedCompany; // Rejected by the manufacturer company ID list.
+        uint32_t rejectedName;    // Rejected by the name prefix.
+    };
+
+    NimBLEScanFilter() = default;
+    NimBLEScanFilter(const NimBLEScanFilter& other);
+    NimBLEScanFilter& operator=(const NimBLEScanFilter& other);
+
+    NimBLEScanFilter& addServiceUUID(const NimBLEUUID& uuid);
+    NimBLEScanFilter& addCompanyId(uint16_t companyId);
+    NimBLEScanFilter& setNamePrefix(const std::string& prefix);
+    NimBLEScanFilter& setMinRSSI(int8_t rssi);
+    NimBLEScanFilter& addAddress(const NimBLEAddress& address);
+    void              clear();
+    bool              isEmpty() const;
+    bool              hasContentCriteria() const;
+    bool              matchAddress(const ble_addr_t& addr, int8_t rssi);
+    bool              matchContent(const uint8_t* data, size_t length, bool final = true);
+    Stats             getStats() const;
+    void              resetStats();
+
+  private:
+    std::vector<NimBLEUUID>    m_serviceUUIDs{};
+    std::vector<uint16_t>      m_companyIds{};
+    std::vector<NimBLEAddress> m_addresses{};
+    std::string                m_namePrefix{};
+    int8_t                     m_minRSSI{-128};
+    std::atomic<uint32_t>      m_evaluated{0};
+    std::atomic<uint32_t>      m_passed{0};
+    std::atomic<uint32_t>      m_rejectedAddress{0};
+    std::atomic<uint32_t>      m_rejectedRSSI{0};
+    std::atomic<uint32_t>      m_rejectedService{0};
+    std::atomic<uint32_t>      m_rejectedCompany{0};
+    std::atomic<uint32_t>      m_rejectedName{0};
+};
+
+#endif /* CONFIG_BT_ENABLED && CONFIG_BT_NIMBLE_ROLE_OBSERVER */
+#endif /* NIMBLE_CPP_SCAN_FILTER_H_ */
@@ -0,0 +1,216 @@
+/*
+ * Copyright 2020-2025 Ryan Powell <ryan@nable-embedded.io> and
+ * esp-nimble-cpp, NimBLE-Arduino contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NimBLEScanIndex.h"
+
+static const size_t MIN_CAPACITY = 16;
+
+/**
+ * @brief Pack the address, type and set ID into a single comparable key.
+ * @details Empty slots are marked by pos == NOT_FOUND, so every key value is usable.
+ */
+uint64_t NimBLEScanIndex::makeKey(const uint8_t* addr, uint8_t type, uint8_t sid) {
+    uint64_t key = 0;
+    for (int i = 5; i >= 0; i--) {
+        key = (key << 8) | addr[i];
+    }
+
+    return key | (static_cast<uint64_t>(sid) << 48) | (static_cast<uint64_t>(type) << 56);
+} // makeKey
+
+/**
+ * @brief Fibonacci hashing, the high bits of the product are well mixed even for sequential addresses.
+ */
+size_t NimBLEScanIndex::hash(uint64_t key, size_t mask) {
+    return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+} // hash
+
+/**
+ * @brief Find the slot holding the key, or the empty slot where it would be inserted.
+ * @details Must not be called on an empty table.
+ */
+size_t NimBLEScanIndex::findSlot(uint64_t key) const {
+    const size_t mask = m_slots.size() - 1;
+    size_t       i    = hash(key, mask);
+    while (m_slots[i].pos != NOT_FOUND && m_slots[i].key != key) {
+        i = (i + 1) & mask;
+    }
+
+    return i;
+} // findSlot
+
+/**
+ * @brief Look up the results vector position of an advertiser.
+ * @param [in] addr The 6 byte address, little endian as in ble_addr_t.
+ * @param [in] type The address type.
+ * @param [in] sid The advertising set ID, 0 for legacy advertising.
+ * @return The position, or NOT_FOUND.
+ */
+uint16_t NimBLEScanIndex::find(const uint8_t* addr, uint8_t type, uint8_t sid) const {
+    if (m_count == 0) {
+        return NOT_FOUND;
+    }
+
+    return m_slots[findSlot(makeKey(addr, type, sid))].pos;
+} // find
+
+/**
+ * @brief Add an advertiser to the index.
+ * @return False if the advertiser is already indexed or the position is invalid.
+ */
+bool NimBLEScanIndex::insert(const uint8_t* addr, uint8_t type, uint8_t sid, uint16_t pos) {
+    if (pos == NOT_FOUND) {
+        return false;
+    }
+
+    if ((m_count + 1) * 2 > m_slots.size()) {
+        rehash(m_slots.empty() ? MIN_CAPACITY : m_slots.size() * 2);
+    }
+
+    const uint64_t key  = makeKey(addr, type, sid);
+    Slot&          slot = m_slots[findSlot(key)];
+    if (slot.pos != NOT_FOUND) {
+        return false;
+    }
+
+    slot.key = key;
+    slot.pos = pos;
+    m_count++;
+    return true;
+} // insert
+
+/**
+ * @brief Change the stored position of an indexed advertiser, used when the results vector is compacted.
+ * @return False if the advertiser is not indexed.
+ */
+bool NimBLEScanIndex::update(const uint8_t* addr, uint8_t type, uint8_t sid, uint16_t pos) {
+    if (m_count == 0) {
+        return false;
+    }
+
+    Slot& slot = m_slots[findSlot(makeKey(addr, type, sid))];
+    if (slot.pos == NOT_FOUND) {
+        return false;
+    }
+
+    slot.pos = pos;
+    return true;
+} // update
+
+/**
+ * @brief Remove an advertiser from the index.
+ * @details Backward shift deletion: the entries following the removed one in its probe run are moved
+ * back so that every entry stays reachable from its home slot without tombstones.
+ * @return False if the advertiser was not indexed.
+ */
+bool NimBLEScanIndex::erase(const uint8_t* addr, uint8_t type, uint8_t sid) {
+    if (m_count == 0) {
+        return false;
+    }
+
+    const size_t mask = m_slots.size() - 1;
+    size_t       hole = findSlot(makeKey(addr, type, sid));
+    if (m_slots[hole].pos == NOT_FOUND) {
+        return false;
+    }
+
+    size_t next = (hole + 1) & mask;
+    while (m_slots[next].pos != NOT_FOUND) {
+        const size_t home = hash(m_slots[next].key, mask);
+        // Move the entry into the hole unless its home lies cyclically in (hole, next].
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            m_slots[hole] = m_slots[next];
+            hole          = next;
+        }
+        next = (next + 1) & mask;
+    }
+
+    m_slots[hole].pos = NOT_FOUND;
+    m_count--;
+    return true;
+} // erase
+
+/**
+ * @brief Shift the stored positions behind a removed results vector entry down by one.
+ * @details Used when an entry is erased from the middle of the results vector to keep its order.
+ * @param [in] pos The position of the removed entry, its advertiser must already be erased.
+ */
+void NimBLEScanIndex::removePosition(uint16_t pos) {
+    for (auto& slot : m_slots) {
+        if (slot.pos != NOT_FOUND && slot.pos > pos) {
+            slot.pos--;
+        }
+    }
+} // removePosition
+
+/**
+ * @brief Size the table for the expected number of advertisers so that scanning does not reallocate.
+ */
+void NimBLEScanIndex::reserve(size_t count) {
+    size_t capacity = MIN_CAPACITY;
+    while (capacity < count * 2) {
+        capacity *= 2;
+    }
+
+    if (capacity > m_slots.size()) {
+        rehash(capacity);
+    }
+} // reserve
+
+/**
+ * @brief Remove all entries, keeping the allocated table.
+ */
+void NimBLEScanIndex::clear() {
+    for (auto& slot : m_slots) {
+        slot.pos = NOT_FOUND;
+    }
+
+    m_count = 0;
+} // clear
+
+/**
+ * @brief Exchange the contents with another index without copying.
+ */
+void NimBLEScanIndex::swap(NimBLEScanIndex& other) {
+    m_slots.swap(other.m_slots);
+    const size_t count = m_count;
+    m_count            = other.m_count;
+    other.m_count      = count;
+} // swap
+
+/**
+ * @brief Get the number of indexed advertisers.
+ */
+size_t NimBLEScanIndex::size() const {
+    return m_count;
+} // size
+
+void NimBLEScanIndex::rehash(size_t capacity) {
+    std::vector<Slot> old(capacity, Slot{0, NOT_FOUND});
+    old.swap(m_slots);
+
+    const size_t mask = capacity - 1;
+    for (const auto& slot : old) {
+        if (slot.pos != NOT_FOUND) {
+            size_t i = hash(slot.key, mask);
+            while (m_slots[i].pos != NOT_FOUND) {
+                i = (i + 1) & mask;
+            }
+            m_slots[i] = slot;
+        }
+    }
+} // rehash
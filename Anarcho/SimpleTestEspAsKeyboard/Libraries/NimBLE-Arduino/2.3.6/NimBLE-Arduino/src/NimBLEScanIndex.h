@@ -0,0 +1,65 @@
+/*
+ * Copyright 2020-2025 Ryan Powell <ryan@nable-embedded.io> and
+ * esp-nimble-cpp, NimBLE-Arduino contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NIMBLE_CPP_SCAN_INDEX_H_
+#define NIMBLE_CPP_SCAN_INDEX_H_
+
+/**
+ * This header has no dependency on the NimBLE stack so that it can also be built on a host
+ * for benchmarking (see Src/Tools/NimBLEBench).
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @brief Open addressing hash index from an advertiser key to a position in the scan results vector.
+ * @details The key is the 6 byte address, the address type and the advertising set ID (0 for legacy
+ * advertising). Linear probing with backward shift deletion is used, so there are no tombstones and
+ * lookups stay short after many erases. The table grows to keep the load factor at or below 1/2.
+ */
+class NimBLEScanIndex {
+  public:
+    static constexpr uint16_t NOT_FOUND = 0xFFFF;
+
+    uint16_t find(const uint8_t* addr, uint8_t type, uint8_t sid) const;
+    bool     insert(const uint8_t* addr, uint8_t type, uint8_t sid, uint16_t pos);
+    bool     update(const uint8_t* addr, uint8_t type, uint8_t sid, uint16_t pos);
+    bool     erase(const uint8_t* addr, uint8_t type, uint8_t sid);
+    void     removePosition(uint16_t pos);
+    void     reserve(size_t count);
+    void     clear();
+    void     swap(NimBLEScanIndex& other);
+    size_t   size() const;
+
+  private:
+    struct Slot {
+        uint64_t key;
+        uint16_t pos;
+    };
+
+    static uint64_t makeKey(const uint8_t* addr, uint8_t type, uint8_t sid);
+    static size_t   hash(uint64_t key, size_t mask);
+    size_t          findSlot(uint64_t key) const;
+    void            rehash(size_t capacity);
+
+    std::vector<Slot> m_slots{};
+    size_t            m_count{0};
+};
+
+#endif // NIMBLE_CPP_SCAN_INDEX_H_
@@ -0,0 +1,217 @@
+/*
+ * Copyright 2020-2025 Ryan Powell <ryan@nable-embedded.io> and
+ * esp-nimble-cpp, NimBLE-Arduino contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NimBLEScanRing.h"
+
+#include <string.h>
+#include <new>
+
+/**
+ * @brief Ring destructor, frees the record storage.
+ */
+NimBLEScanRing::~NimBLEScanRing() {
+    end();
+} // ~NimBLEScanRing
+
+/**
+ * @brief Allocate the record storage.
+ * @param [in] capacity The number of records, rounded up to a power of two.
+ * @return False if the capacity is 0 or the allocation failed.
+ * @note Must not be called while the ring is in use by a producer or consumer.
+ */
+bool NimBLEScanRing::begin(size_t capacity) {
+    end();
+    if (capacity == 0) {
+        return false;
+    }
+
+    uint32_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+
+    m_records = new (std::nothrow) NimBLEScanRecord[size];
+    if (m_records == nullptr) {
+        return false;
+    }
+
+    m_mask = size - 1;
+    m_head.store(0, std::memory_order_relaxed);
+    m_tail.store(0, std::memory_order_relaxed);
+    resetStats();
+    return true;
+} // begin
+
+/**
+ * @brief Free the record storage, the ring has a capacity of 0 afterwards.
+ */
+void NimBLEScanRing::end() {
+    delete[] m_records;
+    m_records = nullptr;
+    m_mask    = 0;
+    m_head.store(0, std::memory_order_relaxed);
+    m_tail.store(0, std::memory_order_relaxed);
+} // end
+
+/**
+ * @brief Write a record, called by the producer only.
+ * @param [in] addr The 6 byte advertiser address.
+ * @param [in] addrType The address type.
+ * @param [in] rssi The RSSI of the report.
+ * @param [in] eventType The event type or extended advertising properties.
+ * @param [in] sid The advertising set ID.
+ * @param [in] dataStatus The extended advertising data status, 0 (complete) for legacy reports.
+ * @param [in] data The advertisement payload.
+ * @param [in] length The payload length, bytes beyond NimBLEScanRecord::DATA_SIZE are dropped.
+ * @return False if the ring is full or not allocated, the record is dropped.
+ */
+bool NimBLEScanRing::push(const uint8_t* addr,
+                          uint8_t        addrType,
+                          int8_t         rssi,
+                          uint8_t        eventType,
+                          uint8_t        sid,
+                          uint8_t        dataStatus,
+                          const uint8_t* data,
+                          size_t         length) {
+    const uint32_t head = m_head.load(std::memory_order_relaxed);
+    const uint32_t used = head - m_tail.load(std::memory_order_acquire);
+    if (m_records == nullptr || used > m_mask) {
+        m_overruns.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    NimBLEScanRecord& record = m_records[head & m_mask];
+    memcpy(record.addr, addr, sizeof(record.addr));
+    record.addrType  = addrType;
+    record.rssi      = rssi;
+    record.eventType = eventType;
+    record.sid       = sid;
+    record.flags     = (dataStatus & 0x03) << NimBLEScanRecord::STATUS_SHIFT;
+    if (length > NimBLEScanRecord::DATA_SIZE) {
+        length        = NimBLEScanRecord::DATA_SIZE;
+        record.flags |= NimBLEScanRecord::FLAG_SLICED;
+        m_sliced.fetch_add(1, std::memory_order_relaxed);
+    }
+    record.length = static_cast<uint8_t>(length);
+    if (length > 0) {
+        memcpy(record.data, data, length);
+    }
+
+    m_head.store(head + 1, std::memory_order_release);
+    m_pushed.fetch_add(1, std::memory_order_relaxed);
+    if (used + 1 > m_highWater.load(std::memory_order_relaxed)) {
+        m_highWater.store(used + 1, std::memory_order_relaxed);
+    }
+
+    return true;
+} // push
+
+/**
+ * @brief Get the records that can be read in place, called by the consumer only.
+ * @param [out] records Receives a pointer to the oldest record.
+ * @return The number of contiguous records available, call consume() when done with them.
+ * @details When the waiting records wrap around the end of the storage only the first part is
+ * returned, the rest is returned by the next call.
+ */
+size_t NimBLEScanRing::peek(const NimBLEScanRecord** records) const {
+    const uint32_t tail  = m_tail.load(std::memory_order_relaxed);
+    const uint32_t count = m_head.load(std::memory_order_acquire) - tail;
+    if (count == 0) {
+        return 0;
+    }
+
+    const uint32_t start = tail & m_mask;
+    *records             = &m_records[start];
+    return count < m_mask + 1 - start ? count : m_mask + 1 - start;
+} // peek
+
+/**
+ * @brief Release records returned by peek(), called by the consumer only.
+ * @param [in] count The number of records to release.
+ */
+void NimBLEScanRing::consume(size_t count) {
+    const uint32_t tail      = m_tail.load(std::memory_order_relaxed);
+    const uint32_t available = m_head.load(std::memory_order_acquire) - tail;
+    if (count > available) {
+        count = available;
+    }
+
+    m_tail.store(tail + count, std::memory_order_release);
+} // consume
+
+/**
+ * @brief Copy out and release up to max records, called by the consumer only.
+ * @param [out] records The destination array.
+ * @param [in] max The size of the destination array.
+ * @return The number of records copied.
+ */
+size_t NimBLEScanRing::pop(NimBLEScanRecord* records, size_t max) {
+    size_t copied = 0;
+    while (copied < max) {
+        const NimBLEScanRecord* first = nullptr;
+        size_t                  count = peek(&first);
+        if (count == 0) {
+            break;
+        }
+
+        if (count > max - copied) {
+            count = max - copied;
+        }
+
+        memcpy(&records[copied], first, count * sizeof(NimBLEScanRecord));
+        consume(count);
+        copied += count;
+    }
+
+    return copied;
+} // pop
+
+/**
+ * @brief Get the number of records waiting to be read.
+ */
+size_t NimBLEScanRing::size() const {
+    // Load the tail first: both positions only grow, so the later head cannot be behind it.
+    const uint32_t tail = m_tail.load(std::memory_order_acquire);
+    return m_head.load(std::memory_order_acquire) - tail;
+} // size
+
+/**
+ * @brief Get the number of records the ring can hold, 0 if not allocated.
+ */
+size_t NimBLEScanRing::capacity() const {
+    return m_records == nullptr ? 0 : m_mask + 1;
+} // capacity
+
+/**
+ * @brief Get the ring usage statistics.
+ */
+NimBLEScanRing::Stats NimBLEScanRing::getStats() const {
+    return Stats{m_pushed.load(std::memory_order_relaxed),
+                 m_overruns.load(std::memory_order_relaxed),
+                 m_sliced.load(std::memory_order_relaxed),
+                 m_highWater.load(std::memory_order_relaxed)};
+} // getStats
+
+/**
+ * @brief Reset the counters, the high water mark restarts at the current fill level.
+ */
+void NimBLEScanRing::resetStats() {
+    m_pushed.store(0, std::memory_order_relaxed);
+    m_overruns.store(0, std::memory_order_relaxed);
+    m_sliced.store(0, std::memory_order_relaxed);
+    m_highWater.store(size(), std::memory_order_relaxed);
+} // resetStats
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2020-2025 Ryan Powell <ryan@nable-embedded.io> and
+ * esp-nimble-cpp, NimBLE-Arduino contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NIMBLE_CPP_SCAN_RING_H_
+#define NIMBLE_CPP_SCAN_RING_H_
+
+/**
+ * This header has no dependency on the NimBLE stack so that it can also be built on a host
+ * for benchmarking (see Src/Tools/NimBLEBench).
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+/**
+ * @brief A compact, fixed size copy of one advertising report.
+ */
+struct NimBLEScanRecord {
+    static constexpr size_t  DATA_SIZE    = 31;   // Payload bytes kept, a full legacy advertisement.
+    static constexpr uint8_t FLAG_SLICED  = 0x01; // The payload was longer than DATA_SIZE and was cut.
+    static constexpr uint8_t STATUS_SHIFT = 1;    // Extended advertising data status in bits 1-2.
+
+    uint8_t addr[6];         // Advertiser address, little endian as in ble_addr_t.
+    uint8_t addrType;        // Advertiser address type.
+    int8_t  rssi;            // RSSI of the report.
+    uint8_t eventType;       // Legacy event type, or the extended advertising properties.
+    uint8_t sid;             // Advertising set ID, 0 for legacy advertising.
+    uint8_t flags;           // FLAG_SLICED and the data status.
+    uint8_t length;          // Number of valid bytes in data.
+    uint8_t data[DATA_SIZE]; // The start of the advertisement payload.
+
+    uint8_t getDataStatus() const { return (flags >> STATUS_SHIFT) & 0x03; }
+};
+
+/**
+ * @brief Single producer, single consumer ring of scan records.
+ * @details The NimBLE host task produces records in the GAP event handler, an application task consumes
+ * them in batches, either by copying with pop() or in place with peek() and consume(). Only atomic
+ * loads and stores of the read and write positions are used, no locks. When the ring is full the new
+ * record is dropped and counted as an overrun, so a slow consumer never blocks the host task.
+ */
+class NimBLEScanRing {
+  public:
+    /**
+     * @brief Ring usage statistics.
+     */
+    struct Stats {
+        uint32_t pushed;    // Records written.
+        uint32_t overruns;  // Records dropped because the ring was full.
+        uint32_t sliced;    // Records whose payload was cut to DATA_SIZE.
+        uint32_t highWater; // Largest number of records waiting since the last resetStats().
+    };
+
+    NimBLEScanRing() = default;
+    ~NimBLEScanRing();
+    NimBLEScanRing(const NimBLEScanRing&)            = delete;
+    NimBLEScanRing& operator=(const NimBLEScanRing&) = delete;
+
+    bool   begin(size_t capacity);
+    void   end();
+    bool   push(const uint8_t* addr,
+                uint8_t        addrType,
+                int8_t         rssi,
+                uint8_t        eventType,
+                uint8_t        sid,
+                uint8_t        dataStatus,
+                const uint8_t* data,
+                size_t         length);
+    size_t peek(const NimBLEScanRecord** records) const;
+    void   consume(size_t count);
+    size_t pop(NimBLEScanRecord* records, size_t max);
+    size_t size() const;
+    size_t capacity() const;
+    Stats  getStats() const;
+    void   resetStats();
+
+  private:
+    NimBLEScanRecord*     m_records{nullptr};
+    uint32_t              m_mask{0};
+    std::atomic<uint32_t> m_head{0}; // Next position to write, only stored by the producer.
+    std::atomic<uint32_t> m_tail{0}; // Next position to read, only stored by the consumer.
+    std::atomic<uint32_t> m_pushed{0};
+    std::atomic<uint32_t> m_overruns{0};
+    std::atomic<uint32_t> m_sliced{0};
+    std::atomic<uint32_t> m_highWater{0};
+};
+
+#endif // NIMBLE_CPP_SCAN_RING_H_
@@ -290,6 +290,23 @@ std::vector<uint16_t> NimBLEServer::getPeerDevices() const {
     return peers;
 } // getPeerDevices
 
+/**
+ * @brief Copy the connected client handles into a caller supplied buffer, without allocating.
+ * @param [out] connHandles The buffer that receives the handles.
+ * @param [in] maxCount The number of handles the buffer can hold.
+ * @return The number of handles copied.
+ */
+uint8_t NimBLEServer::getPeerDevices(uint16_t* connHandles, uint8_t maxCount) const {
+    uint8_t count = 0;
+    for (const auto& peer : m_connectedPeers) {
+        if (peer != BLE_HS_CONN_HANDLE_NONE && count < maxCount) {
+            connHandles[count++] = peer;
+        }
+    }
+
+    return count;
+} // getPeerDevices
+
 /**
  * @brief Get the connection information of a connected peer by vector index.
  * @param [in] index The vector index of the peer.
@@ -434,10 +451,12 @@ int NimBLEServer::handleGapEvent(ble_gap_event* event, void* arg) {
                         event->subscribe.attr_handle,
                         ((event->subscribe.cur_notify || event->subscribe.cur_indicate) ? "true" : "false"));
 
+            bool found = false;
             for (const auto& svc : pServer->m_svcVec) {
                 for (const auto& chr : svc->m_vChars) {
                     if (chr->getHandle() == event->subscribe.attr_handle) {
-                        rc = ble_gap_conn_find(event->subscribe.conn_handle, &peerInfo.m_desc);
+                        found = true;
+                        rc    = ble_gap_conn_find(event->subscribe.conn_handle, &peerInfo.m_desc);
                         if (rc != 0) {
                             break;
                         }
@@ -456,6 +475,14 @@ int NimBLEServer::handleGapEvent(ble_gap_event* event, void* arg) {
                 }
             }
 
+            // Not a NimBLECharacteristic, report it only if it is a characteristic of the static table.
+            if (!found && pServer->isStaticChrHandle(event->subscribe.attr_handle) &&
+                ble_gap_conn_find(event->subscribe.conn_handle, &peerInfo.m_desc) == 0) {
+                pServer->m_pServerCallbacks->onSubscribe(peerInfo,
+                                                         event->subscribe.attr_handle,
+                                                         event->subscribe.cur_notify + (event->subscribe.cur_indicate << 1));
+            }
+
             break;
         } // BLE_GAP_EVENT_SUBSCRIBE
 
@@ -766,12 +793,79 @@ void NimBLEServer::addService(NimBLEService* service) {
     serviceChanged();
 } // addService
 
+/**
+ * @brief Add a GATT table declared with NimBLEStaticGatt.
+ * @param [in] svcs The service table, terminated by NimBLEStaticGatt::endOfServices(). It is not copied
+ * and must remain valid as long as the server exists.
+ * @return True if the table was registered.
+ * @details The table is registered in place, its attributes get their handles when the server starts.
+ * Only one static table is supported, it is registered before the services created with createService.
+ * If the server has already been started the table is registered when the GATT server is reset.
+ */
+bool NimBLEServer::addStaticServices(const ble_gatt_svc_def* svcs) {
+    if (m_pStaticSvcs) {
+        NIMBLE_LOGE(LOG_TAG, "A static GATT table has already been added");
+        return false;
+    }
+
+    m_pStaticSvcs = svcs;
+    if (m_gattsStarted) {
+        serviceChanged();
+        return true;
+    }
+
+    return registerStaticServices();
+} // addStaticServices
+
+/**
+ * @brief Register the static GATT table with the stack.
+ * @return True if successful.
+ */
+bool NimBLEServer::registerStaticServices() {
+    int rc = ble_gatts_count_cfg(m_pStaticSvcs);
+    if (rc != 0) {
+        NIMBLE_LOGE(LOG_TAG, "ble_gatts_count_cfg failed, rc= %d, %s", rc, NimBLEUtils::returnCodeToString(rc));
+        return false;
+    }
+
+    rc = ble_gatts_add_svcs(m_pStaticSvcs);
+    if (rc != 0) {
+        NIMBLE_LOGE(LOG_TAG, "ble_gatts_add_svcs, rc= %d, %s", rc, NimBLEUtils::returnCodeToString(rc));
+        return false;
+    }
+
+    return true;
+} // registerStaticServices
+
+/**
+ * @brief Check if a handle is the value handle of a characteristic in the static GATT table.
+ * @param [in] valHandle The characteristic value handle.
+ * @return True if it is, characteristics declared without a value handle pointer cannot be matched.
+ */
+bool NimBLEServer::isStaticChrHandle(uint16_t valHandle) const {
+    if (!m_pStaticSvcs) {
+        return false;
+    }
+
+    for (const ble_gatt_svc_def* svc = m_pStaticSvcs; svc->type != BLE_GATT_SVC_TYPE_END; svc++) {
+        for (const ble_gatt_chr_def* chr = svc->characteristics; chr && chr->uuid; chr++) {
+            if (chr->val_handle && *chr->val_handle == valHandle) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+} // isStaticChrHandle
+
 /**
  * @brief Resets the GATT server, used when services are added/removed after initialization.
+ * @return False if peers are still connected, nothing is reset then, or if the static GATT table could not
+ * be registered again. In the latter case the other services are still registered.
  */
-void NimBLEServer::resetGATT() {
+bool NimBLEServer::resetGATT() {
     if (getConnectedCount() > 0) {
-        return;
+        return false;
     }
 
 # if CONFIG_BT_NIMBLE_ROLE_BROADCASTER
@@ -781,6 +875,12 @@ void NimBLEServer::resetGATT() {
     ble_svc_gap_init();
     ble_svc_gatt_init();
 
+    bool ret = true;
+    if (m_pStaticSvcs && !registerStaticServices()) {
+        NIMBLE_LOGE(LOG_TAG, "Static GATT table not registered after GATT reset");
+        ret = false;
+    }
+
     for (auto it = m_svcVec.begin(); it != m_svcVec.end();) {
         if ((*it)->getRemoved() > 0) {
             if ((*it)->getRemoved() == NIMBLE_ATT_REMOVE_DELETE) {
@@ -797,6 +897,7 @@ void NimBLEServer::resetGATT() {
     }
 
     m_gattsStarted = false;
+    return ret;
 } // resetGATT
 
 /**
@@ -898,6 +999,17 @@ uint16_t NimBLEServer::getPeerMTU(uint16_t connHandle) const {
     return ble_att_mtu(connHandle);
 } // getPeerMTU
 
+/**
+ * @brief Start collecting notifications that are sent together.
+ * @param [in] connHandle The peer to send to, BLE_HS_CONN_HANDLE_NONE (default) for every connected peer.
+ * @return An empty transaction, add the updated characteristics and call commit() to send them.
+ * @details Updates of several characteristics made together are sent as one ATT Multiple Handle Value\n
+ * Notification where the peer supports it, instead of one PDU and often one connection event each.
+ */
+NimBLENotifyTransaction NimBLEServer::beginNotify(uint16_t connHandle) const {
+    return NimBLENotifyTransaction(connHandle);
+} // beginNotify
+
 /**
  * @brief Request an Update the connection parameters:
  * * Can only be used after a connection has been established.
@@ -1032,4 +1144,8 @@ void NimBLEServerCallbacks::onPhyUpdate(NimBLEConnInfo& connInfo, uint8_t txPhy,
     NIMBLE_LOGD("NimBLEServerCallbacks", "onPhyUpdate: default, txPhy: %d, rxPhy: %d", txPhy, rxPhy);
 } // onPhyUpdate
 
+void NimBLEServerCallbacks::onSubscribe(NimBLEConnInfo& connInfo, uint16_t attrHandle, uint16_t subValue) {
+    NIMBLE_LOGD("NimBLEServerCallbacks", "onSubscribe: default, attrHandle: %d, subValue: %d", attrHandle, subValue);
+} // onSubscribe
+
 #endif // CONFIG_BT_ENABLED && CONFIG_BT_NIMBLE_ROLE_PERIPHERAL
@@ -32,6 +32,7 @@
 # undef max
 /**************************/
 
+# include "NimBLENotifyTransaction.h"
 # include <vector>
 # include <array>
 
@@ -74,8 +75,10 @@ class NimBLEServer {
     NimBLEService*        getServiceByHandle(uint16_t handle) const;
     void                  removeService(NimBLEService* service, bool deleteSvc = false);
     void                  addService(NimBLEService* service);
+    bool                  addStaticServices(const ble_gatt_svc_def* svcs);
     uint16_t              getPeerMTU(uint16_t connHandle) const;
     std::vector<uint16_t> getPeerDevices() const;
+    uint8_t               getPeerDevices(uint16_t* connHandles, uint8_t maxCount) const;
     NimBLEConnInfo        getPeerInfo(uint8_t index) const;
     NimBLEConnInfo        getPeerInfo(const NimBLEAddress& address) const;
     NimBLEConnInfo        getPeerInfoByHandle(uint16_t connHandle) const;
@@ -84,6 +87,8 @@ class NimBLEServer {
     bool                  updatePhy(uint16_t connHandle, uint8_t txPhysMask, uint8_t rxPhysMask, uint16_t phyOptions);
     bool                  getPhy(uint16_t connHandle, uint8_t* txPhy, uint8_t* rxPhy);
 
+    NimBLENotifyTransaction beginNotify(uint16_t connHandle = BLE_HS_CONN_HANDLE_NONE) const;
+
 # if CONFIG_BT_NIMBLE_ROLE_CENTRAL
     NimBLEClient* getClient(uint16_t connHandle);
     NimBLEClient* getClient(const NimBLEConnInfo& connInfo);
@@ -127,6 +132,7 @@ class NimBLEServer {
 # endif
     NimBLEServerCallbacks*                                 m_pServerCallbacks;
     std::vector<NimBLEService*>                            m_svcVec;
+    const ble_gatt_svc_def*                                m_pStaticSvcs{nullptr};
     std::array<uint16_t, CONFIG_BT_NIMBLE_MAX_CONNECTIONS> m_connectedPeers;
 
 # if CONFIG_BT_NIMBLE_ROLE_CENTRAL
@@ -136,7 +142,9 @@ class NimBLEServer {
     static int handleGapEvent(struct ble_gap_event* event, void* arg);
     static int handleGattEvent(uint16_t connHandle, uint16_t attrHandle, ble_gatt_access_ctxt* ctxt, void* arg);
     void       serviceChanged();
-    void       resetGATT();
+    bool       resetGATT();
+    bool       registerStaticServices();
+    bool       isStaticChrHandle(uint16_t valHandle) const;
 
 }; // NimBLEServer
 
@@ -221,6 +229,20 @@ class NimBLEServerCallbacks {
      * * BLE_GAP_LE_PHY_CODED
      */
     virtual void onPhyUpdate(NimBLEConnInfo& connInfo, uint8_t txPhy, uint8_t rxPhy);
+
+    /**
+     * @brief Called when a client subscribes to a characteristic of the static GATT table.
+     * @param [in] connInfo A reference to a NimBLEConnInfo instance with information
+     * about the peer connection parameters.
+     * @param [in] attrHandle The value handle of the characteristic.
+     * @param [in] subValue The subscription status:
+     * * 0 = Un-Subscribed
+     * * 1 = Notifications
+     * * 2 = Indications
+     * * 3 = Notifications and Indications
+     * @note Only characteristics declared with a value handle pointer are reported.
+     */
+    virtual void onSubscribe(NimBLEConnInfo& connInfo, uint16_t attrHandle, uint16_t subValue);
 }; // NimBLEServerCallbacks
 
 #endif // CONFIG_BT_ENABLED && CONFIG_BT_NIMBLE_ROLE_PERIPHERAL
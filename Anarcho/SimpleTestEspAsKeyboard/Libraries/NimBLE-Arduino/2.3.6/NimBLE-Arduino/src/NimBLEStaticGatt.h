@@ -0,0 +1,248 @@
+/*
+ * Copyright 2020-2025 Ryan Powell <ryan@nable-embedded.io> and
+ * esp-nimble-cpp, NimBLE-Arduino contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NIMBLE_CPP_STATIC_GATT_H_
+#define NIMBLE_CPP_STATIC_GATT_H_
+
+#include "nimconfig.h"
+#if CONFIG_BT_ENABLED && CONFIG_BT_NIMBLE_ROLE_PERIPHERAL
+
+# if defined(CONFIG_NIMBLE_CPP_IDF)
+#  include "host/ble_gatt.h"
+#  include "host/ble_hs_mbuf.h"
+# else
+#  include "nimble/nimble/host/include/host/ble_gatt.h"
+#  include "nimble/nimble/host/include/host/ble_hs_mbuf.h"
+# endif
+
+/****  FIX COMPILATION ****/
+# undef min
+# undef max
+/**************************/
+
+# include "NimBLEConstUUID.h"
+
+# include <cstring>
+# include <type_traits>
+
+/**
+ * @brief Helpers to declare a GATT database as constant data.
+ * @details The service and characteristic tables are built by constexpr functions and end up in flash,
+ * the access handlers are bound at compile time through access<Handler>. Register the table with
+ * NimBLEServer::addStaticServices, no heap allocation is needed for it.
+ * @code
+ * static uint8_t protocolMode = 1;
+ * static uint16_t reportHandle;
+ * static constexpr uint8_t hidInfo[] = {0x11, 0x01, 0x00, 0x02};
+ * static constexpr ble_uuid16_t hidSvcUuid = NimBLEStaticGatt::uuid16(0x1812);
+ * ...
+ * static constexpr ble_gatt_chr_def hidChrs[] = {
+ *     NimBLEStaticGatt::characteristic(&hidInfoUuid.u,
+ *                                      NimBLEStaticGatt::access<NimBLEStaticGatt::ConstValue<hidInfo, sizeof(hidInfo)>>,
+ *                                      NIMBLE_PROPERTY::READ),
+ *     NimBLEStaticGatt::characteristic(&protocolModeUuid.u,
+ *                                      NimBLEStaticGatt::access<NimBLEStaticGatt::Value<uint8_t, &protocolMode>>,
+ *                                      NIMBLE_PROPERTY::READ | NIMBLE_PROPERTY::WRITE_NR),
+ *     NimBLEStaticGatt::characteristic(&reportUuid.u, ..., NIMBLE_PROPERTY::READ | NIMBLE_PROPERTY::NOTIFY, &reportHandle),
+ *     NimBLEStaticGatt::endOfCharacteristics()};
+ * static constexpr ble_gatt_svc_def gattTable[] = {NimBLEStaticGatt::primaryService(&hidSvcUuid.u, hidChrs),
+ *                                                  NimBLEStaticGatt::endOfServices()};
+ * pServer->addStaticServices(gattTable);
+ * @endcode
+ * A handler is a type with any of these static functions:
+ * * `int onRead(uint16_t connHandle, os_mbuf* om)`, append the value to om and return 0 or an ATT error.
+ * * `int onWrite(uint16_t connHandle, const uint8_t* data, uint16_t length)` together with
+ *   `static constexpr uint16_t MAX_LENGTH`, the written value is passed as one buffer of at most MAX_LENGTH bytes.
+ * Operations without a function are rejected with BLE_ATT_ERR_UNLIKELY, the host only allows those
+ * permitted by the flags anyway.\n
+ * Descriptor tables have to be mutable (`static ble_gatt_dsc_def dscs[] = {...}`) as the host declares
+ * ble_gatt_chr_def::descriptors non-const, they are still initialized at compile time.
+ * The CCCD of a characteristic with NOTIFY or INDICATE is added by the host.
+ * Subscriptions are reported to NimBLEServerCallbacks::onSubscribe.
+ */
+class NimBLEStaticGatt {
+  public:
+    /**
+     * @brief Create a 16 bit UUID for a static table.
+     * @param [in] uuid The 16 bit UUID.
+     */
+    static constexpr ble_uuid16_t uuid16(uint16_t uuid) {
+        ble_uuid16_t res{};
+        res.u.type = BLE_UUID_TYPE_16;
+        res.value  = uuid;
+        return res;
+    }
+
+    /**
+     * @brief Create a 128 bit UUID for a static table.
+     * @param [in] uuid The UUID, e.g. NimBLEConstUUID("dcbc7255-1e9e-49a0-a360-b0430b6c6905").
+     * 16 and 32 bit UUIDs are expanded with the Bluetooth Base UUID.
+     */
+    static constexpr ble_uuid128_t uuid128(const NimBLEConstUUID& uuid) {
+        ble_uuid128_t res{};
+        res.u.type = BLE_UUID_TYPE_128;
+        if (uuid.bitSize() == BLE_UUID_TYPE_128) {
+            uuid.getBytes(res.value);
+        } else {
+            const uint8_t base[16] = {0xfb, 0x34, 0x9b, 0x5f, 0x80, 0x00, 0x00, 0x80, 0x00, 0x10, 0x00, 0x00, 0, 0, 0, 0};
+            for (uint8_t i = 0; i < 12; i++) {
+                res.value[i] = base[i];
+            }
+            for (uint8_t i = 0; i < 4; i++) {
+                res.value[12 + i] = static_cast<uint8_t>(uuid.getShort() >> (8 * i));
+            }
+        }
+        return res;
+    }
+
+    /**
+     * @brief Create a descriptor entry.
+     * @param [in] uuid The descriptor UUID.
+     * @param [in] attFlags The access flags, BLE_ATT_F_READ and/or BLE_ATT_F_WRITE.
+     * @param [in] accessCb The access handler, e.g. access<ConstValue<...>>.
+     */
+    static constexpr ble_gatt_dsc_def descriptor(const ble_uuid_t* uuid, uint8_t attFlags, ble_gatt_access_fn* accessCb) {
+        ble_gatt_dsc_def res{};
+        res.uuid      = uuid;
+        res.att_flags = attFlags;
+        res.access_cb = accessCb;
+        return res;
+    }
+
+    /**
+     * @brief Create a characteristic entry.
+     * @param [in] uuid The characteristic UUID.
+     * @param [in] accessCb The access handler, e.g. access<Value<...>>.
+     * @param [in] flags The properties, NIMBLE_PROPERTY values.
+     * @param [in] valHandle Receives the value handle when the table is registered, needed to notify.
+     * @param [in] descriptors The descriptor table, terminated by endOfDescriptors().
+     */
+    static constexpr ble_gatt_chr_def characteristic(const ble_uuid_t*   uuid,
+                                                     ble_gatt_access_fn* accessCb,
+                                                     ble_gatt_chr_flags  flags,
+                                                     uint16_t*           valHandle   = nullptr,
+                                                     ble_gatt_dsc_def*   descriptors = nullptr) {
+        ble_gatt_chr_def res{};
+        res.uuid        = uuid;
+        res.access_cb   = accessCb;
+        res.flags       = flags;
+        res.val_handle  = valHandle;
+        res.descriptors = descriptors;
+        return res;
+    }
+
+    /**
+     * @brief Create a primary service entry.
+     * @param [in] uuid The service UUID.
+     * @param [in] characteristics The characteristic table, terminated by endOfCharacteristics().
+     */
+    static constexpr ble_gatt_svc_def primaryService(const ble_uuid_t* uuid, const ble_gatt_chr_def* characteristics) {
+        ble_gatt_svc_def res{};
+        res.type            = BLE_GATT_SVC_TYPE_PRIMARY;
+        res.uuid            = uuid;
+        res.characteristics = characteristics;
+        return res;
+    }
+
+    /** @brief Terminates a descriptor table. */
+    static constexpr ble_gatt_dsc_def endOfDescriptors() { return ble_gatt_dsc_def{}; }
+
+    /** @brief Terminates a characteristic table. */
+    static constexpr ble_gatt_chr_def endOfCharacteristics() { return ble_gatt_chr_def{}; }
+
+    /** @brief Terminates a service table. */
+    static constexpr ble_gatt_svc_def endOfServices() { return ble_gatt_svc_def{}; }
+
+    /**
+     * @brief Read only value in flash, e.g. a report map.
+     */
+    template <const uint8_t* Data, uint16_t Size>
+    struct ConstValue {
+        static int onRead(uint16_t connHandle, os_mbuf* om) { return os_mbuf_append(om, Data, Size); }
+    };
+
+    /**
+     * @brief Readable and writable value of a trivially copyable type, e.g. the protocol mode.
+     * @details A write has to provide exactly sizeof(T) bytes.
+     */
+    template <typename T, T* Var>
+    struct Value {
+        static_assert(std::is_trivially_copyable<T>::value, "Value requires a trivially copyable type");
+        static constexpr uint16_t MAX_LENGTH = sizeof(T);
+
+        static int onRead(uint16_t connHandle, os_mbuf* om) { return os_mbuf_append(om, Var, sizeof(T)); }
+
+        static int onWrite(uint16_t connHandle, const uint8_t* data, uint16_t length) {
+            if (length != sizeof(T)) {
+                return BLE_ATT_ERR_INVALID_ATTR_VALUE_LEN;
+            }
+            memcpy(Var, data, sizeof(T));
+            return 0;
+        }
+    };
+
+    /**
+     * @brief Access callback of a static table entry, dispatches to the handler at compile time.
+     */
+    template <typename Handler>
+    static int access(uint16_t connHandle, uint16_t attrHandle, ble_gatt_access_ctxt* ctxt, void* arg) {
+        switch (ctxt->op) {
+            case BLE_GATT_ACCESS_OP_READ_CHR:
+            case BLE_GATT_ACCESS_OP_READ_DSC:
+                if constexpr (Has_onRead<Handler>::value) {
+                    return Handler::onRead(connHandle, ctxt->om) == 0 ? 0 : BLE_ATT_ERR_INSUFFICIENT_RES;
+                }
+                break;
+
+            case BLE_GATT_ACCESS_OP_WRITE_CHR:
+            case BLE_GATT_ACCESS_OP_WRITE_DSC:
+                if constexpr (Has_onWrite<Handler>::value) {
+                    if (OS_MBUF_PKTLEN(ctxt->om) > Handler::MAX_LENGTH) {
+                        return BLE_ATT_ERR_INVALID_ATTR_VALUE_LEN;
+                    }
+                    uint8_t  buf[Handler::MAX_LENGTH];
+                    uint16_t len = 0;
+                    ble_hs_mbuf_to_flat(ctxt->om, buf, sizeof(buf), &len);
+                    return Handler::onWrite(connHandle, buf, len);
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        return BLE_ATT_ERR_UNLIKELY;
+    }
+
+  private:
+    /* Used to determine if a handler has an onRead method. */
+    template <typename T, typename = void>
+    struct Has_onRead : std::false_type {};
+
+    template <typename T>
+    struct Has_onRead<T, decltype(void(&T::onRead))> : std::true_type {};
+
+    /* Used to determine if a handler has an onWrite method. */
+    template <typename T, typename = void>
+    struct Has_onWrite : std::false_type {};
+
+    template <typename T>
+    struct Has_onWrite<T, decltype(void(&T::onWrite))> : std::true_type {};
+}; // NimBLEStaticGatt
+
+#endif // CONFIG_BT_ENABLED && CONFIG_BT_NIMBLE_ROLE_PERIPHERAL
+#endif // NIMBLE_CPP_STATIC_GATT_H_
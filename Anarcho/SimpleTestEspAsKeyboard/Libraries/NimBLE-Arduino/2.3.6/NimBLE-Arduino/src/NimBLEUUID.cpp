@@ -136,6 +136,27 @@ NimBLEUUID::NimBLEUUID(uint32_t first, uint16_t second, uint16_t third, uint64_t
     memcpy(m_uuid.u128.value, &fourth, 8);
 } // NimBLEUUID(uint32_t first, uint16_t second, uint16_t third, uint64_t fourth)
 
+/**
+ * @brief Create a UUID from a compile time UUID.
+ * @param [in] uuid The compile time UUID, 128 bit UUIDs based on the Bluetooth Base UUID become 16 or 32 bit.
+ */
+NimBLEUUID::NimBLEUUID(const NimBLEConstUUID& uuid) {
+    m_uuid.u.type = uuid.bitSize();
+    switch (uuid.bitSize()) {
+        case BLE_UUID_TYPE_16:
+            m_uuid.u16.value = static_cast<uint16_t>(uuid.getShort());
+            break;
+        case BLE_UUID_TYPE_32:
+            m_uuid.u32.value = uuid.getShort();
+            break;
+        case BLE_UUID_TYPE_128:
+            uuid.getBytes(m_uuid.u128.value);
+            break;
+        default:
+            break;
+    }
+} // NimBLEUUID(const NimBLEConstUUID& uuid)
+
 /**
  * @brief Get the bit size of the UUID, 16, 32 or 128.
  * @return The bit size of the UUID or 0 if not initialized.
@@ -336,4 +357,22 @@ NimBLEUUID::operator std::string() const {
     return ble_uuid_to_str(&m_uuid.u, buf);
 } // operator std::string
 
+/**
+ * @brief Convenience operator to convert this UUID to its canonical compile time form.
+ * @details Comparing NimBLEConstUUIDs is cheaper than comparing NimBLEUUIDs of different sizes,
+ * convert once before comparing in a loop.
+ */
+NimBLEUUID::operator NimBLEConstUUID() const {
+    switch (bitSize()) {
+        case BLE_UUID_TYPE_16:
+            return NimBLEConstUUID(m_uuid.u16.value);
+        case BLE_UUID_TYPE_32:
+            return NimBLEConstUUID(m_uuid.u32.value);
+        case BLE_UUID_TYPE_128:
+            return NimBLEConstUUID::fromBytes(m_uuid.u128.value, 16);
+        default:
+            return NimBLEConstUUID();
+    }
+} // operator NimBLEConstUUID
+
 #endif /* CONFIG_BT_ENABLED */
@@ -32,6 +32,8 @@
 # undef max
 /**************************/
 
+# include "NimBLEConstUUID.h"
+
 # include <string>
 # include <cstring>
 
@@ -51,6 +53,7 @@ class NimBLEUUID {
     NimBLEUUID(const ble_uuid128_t* uuid);
     NimBLEUUID(const uint8_t* pData, size_t size);
     NimBLEUUID(uint32_t first, uint16_t second, uint16_t third, uint64_t fourth);
+    NimBLEUUID(const NimBLEConstUUID& uuid);
 
     uint8_t           bitSize() const;
     const uint8_t*    getValue() const;
@@ -65,6 +68,7 @@ class NimBLEUUID {
     bool operator==(const NimBLEUUID& rhs) const;
     bool operator!=(const NimBLEUUID& rhs) const;
     operator std::string() const;
+    operator NimBLEConstUUID() const;
 
   private:
     ble_uuid_any_t m_uuid{};
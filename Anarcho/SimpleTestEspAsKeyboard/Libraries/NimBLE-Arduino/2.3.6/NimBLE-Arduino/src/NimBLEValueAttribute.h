@@ -42,6 +42,14 @@ class NimBLEValueAttribute {
      */
     NimBLEAttValue getValue() const { return m_value; }
 
+    /**
+     * @brief Get a read only view of the attribute value without copying it.
+     * @return A view of the attribute value.
+     * @note The view is invalidated when the value changes. Use it in callbacks, which run on the NimBLE\n
+     * host task like the value updates, otherwise get a copy with getValue().
+     */
+    NimBLEAttValueView getValueView() const { return NimBLEAttValueView(m_value); }
+
     /**
      * @brief Get the length of the attribute value.
      * @return The length of the attribute value.
@@ -0,0 +1,126 @@
+/*
+ * Copyright 2020-2025 Ryan Powell <ryan@nable-embedded.io> and
+ * esp-nimble-cpp, NimBLE-Arduino contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NimBLEWriteQueue.h"
+
+#include <string.h>
+
+// Length header of each value, 0xFFFF marks the unused end of the buffer.
+static const size_t   HEADER_SIZE = 2;
+static const uint16_t WRAP_MARKER = 0xFFFF;
+
+/**
+ * @brief Construct a queue.
+ * @param [in] capacity The size of the buffer in bytes, each value takes its length plus 2 bytes.
+ */
+NimBLEWriteQueue::NimBLEWriteQueue(size_t capacity) : m_buf(capacity) {} // NimBLEWriteQueue
+
+/**
+ * @brief Add a copy of a value to the end of the queue.
+ * @param [in] data A pointer to the value.
+ * @param [in] length The length of the value.
+ * @return True if the value has been added, false if the queue is full.
+ */
+bool NimBLEWriteQueue::push(const uint8_t* data, size_t length) {
+    const size_t capacity = m_buf.size();
+    const size_t size     = HEADER_SIZE + length;
+    if (length >= WRAP_MARKER || size > capacity) {
+        return false;
+    }
+
+    if (m_count == 0) {
+        // Start at the beginning, so the whole buffer is contiguous.
+        m_head = m_tail = m_used = 0;
+    }
+
+    size_t pos     = m_tail;
+    size_t padding = 0;
+    if (pos + size > capacity) {
+        padding = capacity - pos;
+        pos     = 0;
+    }
+
+    if (m_used + padding + size > capacity) {
+        return false;
+    }
+
+    if (padding >= HEADER_SIZE) {
+        m_buf[m_tail]     = WRAP_MARKER & 0xFF;
+        m_buf[m_tail + 1] = WRAP_MARKER >> 8;
+    }
+
+    m_buf[pos]     = length & 0xFF;
+    m_buf[pos + 1] = length >> 8;
+    if (length > 0) {
+        memcpy(&m_buf[pos + HEADER_SIZE], data, length);
+    }
+
+    m_tail  = (pos + size) % capacity;
+    m_used += padding + size;
+    m_count++;
+    return true;
+} // push
+
+/**
+ * @brief Get the offset of the length header of the first value, skipping the unused end of the buffer.
+ */
+size_t NimBLEWriteQueue::frontOffset() const {
+    const size_t capacity = m_buf.size();
+    if (capacity - m_head < HEADER_SIZE || (m_buf[m_head] | m_buf[m_head + 1] << 8) == WRAP_MARKER) {
+        return 0;
+    }
+    return m_head;
+} // frontOffset
+
+/**
+ * @brief Get the first value of the queue.
+ * @param [out] length The length of the value.
+ * @return A pointer to the value, or nullptr if the queue is empty.
+ */
+const uint8_t* NimBLEWriteQueue::front(size_t* length) const {
+    if (m_count == 0) {
+        return nullptr;
+    }
+
+    const size_t pos = frontOffset();
+    *length          = m_buf[pos] | m_buf[pos + 1] << 8;
+    return &m_buf[pos + HEADER_SIZE];
+} // front
+
+/**
+ * @brief Remove the first value from the queue.
+ */
+void NimBLEWriteQueue::pop() {
+    if (m_count == 0) {
+        return;
+    }
+
+    const size_t pos  = frontOffset();
+    const size_t next = pos + HEADER_SIZE + (m_buf[pos] | m_buf[pos + 1] << 8);
+    m_used -= (pos < m_head ? m_buf.size() - m_head : 0) + next - pos;
+    m_head  = next % m_buf.size();
+    if (--m_count == 0) {
+        m_head = m_tail = m_used = 0;
+    }
+} // pop
+
+/**
+ * @brief Remove all values from the queue.
+ */
+void NimBLEWriteQueue::clear() {
+    m_head = m_tail = m_used = m_count = 0;
+} // clear
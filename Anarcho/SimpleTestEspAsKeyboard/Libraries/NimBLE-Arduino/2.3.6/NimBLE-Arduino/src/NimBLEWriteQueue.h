@@ -0,0 +1,72 @@
+/*
+ * Copyright 2020-2025 Ryan Powell <ryan@nable-embedded.io> and
+ * esp-nimble-cpp, NimBLE-Arduino contributors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NIMBLE_CPP_WRITE_QUEUE_H_
+#define NIMBLE_CPP_WRITE_QUEUE_H_
+
+/**
+ * This header has no dependency on the NimBLE stack so that it can also be built on a host
+ * for benchmarking (see Src/Tools/NimBLEBench).
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @brief A bounded FIFO of values, stored back to back in one buffer.
+ * @details Each value is stored contiguously with a 2 byte length in front of it, so that it can be
+ * handed to the host without copying it first. A value that does not fit before the end of the buffer
+ * starts at the beginning again, the space left at the end is skipped.\n
+ * The queue does no locking, the owner serializes access to it. A value returned by front() stays valid
+ * until it is removed with pop(), values can be added in the meantime.
+ */
+class NimBLEWriteQueue {
+  public:
+    explicit NimBLEWriteQueue(size_t capacity);
+
+    bool           push(const uint8_t* data, size_t length);
+    const uint8_t* front(size_t* length) const;
+    void           pop();
+    void           clear();
+
+    /**
+     * @brief Get the number of values in the queue.
+     */
+    size_t getCount() const { return m_count; }
+
+    /**
+     * @brief Get the number of bytes of the buffer in use, including the length headers.
+     */
+    size_t getUsed() const { return m_used; }
+
+    /**
+     * @brief Get the size of the buffer in bytes.
+     */
+    size_t getCapacity() const { return m_buf.size(); }
+
+  private:
+    size_t frontOffset() const;
+
+    std::vector<uint8_t> m_buf;
+    size_t               m_head{0};
+    size_t               m_tail{0};
+    size_t               m_used{0};
+    size_t               m_count{0};
+};
+
+#endif // NIMBLE_CPP_WRITE_QUEUE_H_
@@ -0,0 +1,87 @@
+/*
+ * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifdef ESP_PLATFORM
+
+#include "nimconfig.h"
+#include "nimble/porting/nimble/include/syscfg/syscfg.h"
+
+#if MYNEWT_VAL(BLE_GATT_CACHING)
+
+#include "nvs.h"
+#include "nimble/porting/nimble/include/nimble/storage_port.h"
+
+/*
+ * Storage backend of the GATT client cache (ble_gattc_cache.c). Every cached peer
+ * gets its own NVS namespace, the list of cached peers is kept in a separate one.
+ */
+
+static int
+nvs_cache_open(const char *namespace_name, open_mode_t open_mode, cache_handle_t *out_handle)
+{
+    nvs_handle_t handle;
+    int rc;
+
+    rc = nvs_open(namespace_name, open_mode == READONLY ? NVS_READONLY : NVS_READWRITE, &handle);
+    if (rc == 0) {
+        *out_handle = handle;
+    }
+    return rc;
+}
+
+static void
+nvs_cache_close(cache_handle_t handle)
+{
+    nvs_close(handle);
+}
+
+static int
+nvs_cache_erase_all(cache_handle_t handle)
+{
+    int rc;
+
+    rc = nvs_erase_all(handle);
+    if (rc == 0) {
+        rc = nvs_commit(handle);
+    }
+    return rc;
+}
+
+static int
+nvs_cache_write(cache_handle_t handle, const char *key, const void *value, size_t length)
+{
+    int rc;
+
+    rc = nvs_set_blob(handle, key, value, length);
+    if (rc == 0) {
+        rc = nvs_commit(handle);
+    }
+    return rc;
+}
+
+static int
+nvs_cache_read(cache_handle_t handle, const char *key, void *out_value, size_t *length)
+{
+    return nvs_get_blob(handle, key, out_value, length);
+}
+
+struct cache_fn_mapping
+link_storage_fn(void *storage_cb)
+{
+    struct cache_fn_mapping cache_fn;
+
+    (void)storage_cb;
+
+    cache_fn.open = nvs_cache_open;
+    cache_fn.close = nvs_cache_close;
+    cache_fn.erase_all = nvs_cache_erase_all;
+    cache_fn.write = nvs_cache_write;
+    cache_fn.read = nvs_cache_read;
+    return cache_fn;
+}
+
+#endif /* MYNEWT_VAL(BLE_GATT_CACHING) */
+#endif /* ESP_PLATFORM */
@@ -3475,39 +3475,46 @@ ble_gattc_read_mult_cb_var(struct ble_gattc_proc *proc, int status,
         attr[i].handle = proc->read_mult.handles[i];
         attr[i].offset = 0;
         if (om == NULL || OS_MBUF_PKTLEN(*om) == 0) {
+            if (status == 0) {
+                /* The response ended before all values, report it as short. */
+                status = BLE_HS_EBADDATA;
+            }
             continue;
         }
 
         *om = os_mbuf_pullup(*om, 2);
-        assert(*om);
+        if (*om == NULL) {
+            status = BLE_HS_EBADDATA;
+            break;
+        }
 
         attr_len = get_le16((*om)->om_data);
 
         os_mbuf_adj(*om, 2);
 
         if (attr_len > BLE_ATT_ATTR_MAX_LEN) {
-            /*TODO Figure out what to do here */
+            status = BLE_HS_EBADDATA;
             break;
         }
 
         attr[i].om = os_msys_get_pkthdr(attr_len, 0);
         if (!attr[i].om) {
-            /*TODO Figure out what to do here */
+            status = BLE_HS_ENOMEM;
             break;
         }
 
+        /* A value cut off by the end of the response, e.g. one that grew
+         * beyond the MTU, is reported as short instead of asserting.
+         */
         rc = os_mbuf_appendfrom(attr[i].om, *om, 0, attr_len);
         if (rc) {
-            /*TODO Figure out what to do here */
+            status = BLE_HS_EBADDATA;
             break;
         }
 
         os_mbuf_adj(*om, attr_len);
     }
 
-    /*FIXME Testing assert */
-    assert(i == proc->read_mult.num_handles);
-
     proc->read_mult.cb_mult(proc->conn_handle,
                     ble_gattc_error(status, att_handle), &attr[0],
                     i,
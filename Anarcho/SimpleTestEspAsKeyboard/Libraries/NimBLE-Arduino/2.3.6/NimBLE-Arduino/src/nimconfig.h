@@ -38,6 +38,14 @@
  */
 // #define CONFIG_NIMBLE_CPP_ATT_VALUE_INIT_LENGTH 20
 
+/** @brief Uncomment to set the size (bytes) up to which attribute values are stored inside\n
+ *  the NimBLEAttValue object instead of on the heap. Larger values are allocated on the heap.\n
+ *  Increasing this avoids heap allocations for longer values but increases the size of every value.\n
+ *  0 stores every value on the heap.\n
+ *  Default value is 20. Range: 0 : 512 (BLE_ATT_ATTR_MAX_LEN)
+ */
+// #define CONFIG_NIMBLE_CPP_ATT_VALUE_INLINE_LENGTH 20
+
 
 /****************************************************
  *         Extended advertising settings            *
@@ -82,6 +90,12 @@
  */
  // #define CONFIG_NIMBLE_CPP_LOG_LEVEL 0
 
+/** @brief Un-comment to record the NimBLE CPP Wrapper log messages in binary form and print them from a low
+ *  priority task instead of formatting them in the calling task (ESP32 only).\n
+ *  Value: size in bytes of the log buffer of each core, 256 to 32768.
+ */
+// #define CONFIG_NIMBLE_CPP_LOG_DEFERRED 2048
+
 /** @brief Un-comment to enable the debug asserts in NimBLE CPP wrapper.*/
 // #define CONFIG_NIMBLE_CPP_DEBUG_ASSERT_ENABLED 1
 
@@ -129,6 +143,48 @@
 /** @brief Un-comment to change the maximum number of CCCD subscriptions to store */
 // #define CONFIG_BT_NIMBLE_MAX_CCCDS 8
 
+/**
+ * @brief Un-comment to store the discovered GATT database of peers in NVS.
+ * @details On reconnect the stored database is validated by reading the peer's Database Hash
+ * characteristic (0x2B2A), bonded peers are trusted without the read. Service, characteristic and
+ * descriptor discovery are then answered from the cache and only fall back to the peer on a mismatch.
+ */
+// #define CONFIG_BT_NIMBLE_GATT_CACHING 1
+
+/** @brief Un-comment to change the number of peers whose GATT database is stored, defaults to the max connections */
+// #define CONFIG_BT_NIMBLE_GATT_CACHING_MAX_CONNS CONFIG_BT_NIMBLE_MAX_CONNECTIONS
+
+/** @brief Un-comment to change the maximum number of cached services per connection */
+// #define CONFIG_BT_NIMBLE_GATT_CACHING_MAX_SVCS 16
+
+/** @brief Un-comment to change the maximum number of cached characteristics per connection */
+// #define CONFIG_BT_NIMBLE_GATT_CACHING_MAX_CHRS 64
+
+/** @brief Un-comment to change the maximum number of cached descriptors per connection */
+// #define CONFIG_BT_NIMBLE_GATT_CACHING_MAX_DSCS 64
+
+/**
+ * @brief Un-comment to change the number of SDUs each L2CAP channel can queue with trySend().
+ * @details Queued SDUs are sent from the NimBLE host task back to back. Every queued SDU holds
+ * buffers of the channel's pool until it has been sent.
+ */
+// #define CONFIG_NIMBLE_CPP_L2CAP_TX_QUEUE_LEN 8
+
+/**
+ * @brief Un-comment to change the size in bytes of the queue of each remote characteristic used with writeValueQueued().
+ * @details Each queued value takes its length plus 2 bytes. The queue is only allocated for characteristics
+ * that use it.
+ */
+// #define CONFIG_NIMBLE_CPP_WRITE_QUEUE_SIZE 1024
+
+/**
+ * @brief Un-comment to enable Enhanced ATT (EATT) with the given number of bearers per connection.
+ * @details EATT bearers are L2CAP channels that each carry their own ATT request, so a client can have
+ * several reads and writes outstanding on one connection. The central opens them once the link is encrypted
+ * and the peer supports EATT, until then all requests use the unenhanced ATT bearer.
+ */
+// #define CONFIG_BT_NIMBLE_EATT_CHAN_NUM 2
+
 /** @brief Un-comment to change the random address refresh time (in seconds) */
 // #define CONFIG_BT_NIMBLE_RPA_TIMEOUT 900
 
@@ -264,6 +320,24 @@
 #define CONFIG_BT_NIMBLE_RPA_TIMEOUT 900
 #endif
 
+#if CONFIG_BT_NIMBLE_GATT_CACHING
+#ifndef CONFIG_BT_NIMBLE_GATT_CACHING_MAX_CONNS
+#define CONFIG_BT_NIMBLE_GATT_CACHING_MAX_CONNS CONFIG_BT_NIMBLE_MAX_CONNECTIONS
+#endif
+
+#ifndef CONFIG_BT_NIMBLE_GATT_CACHING_MAX_SVCS
+#define CONFIG_BT_NIMBLE_GATT_CACHING_MAX_SVCS 16
+#endif
+
+#ifndef CONFIG_BT_NIMBLE_GATT_CACHING_MAX_CHRS
+#define CONFIG_BT_NIMBLE_GATT_CACHING_MAX_CHRS 64
+#endif
+
+#ifndef CONFIG_BT_NIMBLE_GATT_CACHING_MAX_DSCS
+#define CONFIG_BT_NIMBLE_GATT_CACHING_MAX_DSCS 64
+#endif
+#endif
+
 #ifndef CONFIG_BT_NIMBLE_LOG_LEVEL
 #define CONFIG_BT_NIMBLE_LOG_LEVEL 5
 #endif
@@ -307,9 +381,18 @@
 #define CONFIG_BT_NIMBLE_TRANSPORT_EVT_DISCARD_COUNT 8
 
 #define CONFIG_BT_NIMBLE_L2CAP_COC_SDU_BUFF_COUNT 1
-#define CONFIG_BT_NIMBLE_EATT_CHAN_NUM 0
 #define CONFIG_BT_NIMBLE_SVC_GAP_CENT_ADDR_RESOLUTION -1
-#define CONFIG_BT_NIMBLE_GATT_MAX_PROCS 4
+
+/** @brief Number of EATT bearers per connection */
+#ifndef CONFIG_BT_NIMBLE_EATT_CHAN_NUM
+#define CONFIG_BT_NIMBLE_EATT_CHAN_NUM 0
+#endif
+
+/** @brief Number of concurrent GATT client procedures, one more for each EATT bearer */
+#ifndef CONFIG_BT_NIMBLE_GATT_MAX_PROCS
+#define CONFIG_BT_NIMBLE_GATT_MAX_PROCS (4 + CONFIG_BT_NIMBLE_EATT_CHAN_NUM)
+#endif
+
 #define CONFIG_BT_NIMBLE_HS_STOP_TIMEOUT_MS 2000
 
 #ifndef CONFIG_BT_ENABLED
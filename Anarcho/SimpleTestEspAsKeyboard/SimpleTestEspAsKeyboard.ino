@@ -8,14 +8,89 @@
   - HID-Service 0x1812 + Boot-Keyboard (0x2A22/0x2A32)
   - Protocol Mode default = Boot (0) für Android
   - UTF-8 Decoder für seriellen Input
+  - Ctrl-B (0x02) auf der Seriellen startet einen Tipp-Benchmark (Zeichen/s) für
+    das Low-Latency- und das Stromspar-Verbindungsprofil, jeweils Taste für Taste und
+    gepackt (mehrere Tasten pro Report). Die festen Tastenpausen sind dabei aus, das
+    Tempo ergibt sich allein daraus, wie schnell der Stack die Reports annimmt. Übernimmt
+    der Host ein Profil nicht, weist die Ausgabe darauf hin. Boot vs. NKRO: einmal ohne und
+    einmal mit -DHID_KEYBOARD_NKRO=1 bauen und die Ausgaben vergleichen. Der Schalter muss für
+    den ganzen Build gesetzt werden (build_opt.h im Sketch-Ordner oder
+    arduino-cli compile --build-property "compiler.cpp.extra_flags=-DHID_KEYBOARD_NKRO=1"),
+    ein #define hier erreicht die Bibliothek nicht.
 */
 
 #include <NimBLEDevice.h>
-#include "src/HidKeyboard.h"
+#include <HidConsts.h>
+#include <HidKeyboard.h>
+#include <HidLog.h>
 #include "src/Helper/Utf8Decoder.h"
 
 static HidKeyboard gKeyboard;
 
+namespace
+{
+	constexpr uint32_t kBenchTrigger = 0x02; // Ctrl-B
+	constexpr unsigned long kBenchSettleMs = 1500;
+	const char kBenchText[] = "the quick brown fox jumps over the lazy dog 0123456789\n";
+
+	constexpr size_t kInputBufferSize = 64;
+
+	void benchProfile(HidConnProfile profile, const char* name, bool packed)
+	{
+		gKeyboard.requestConnProfile(profile, true);
+		delay(kBenchSettleMs);
+		if (gKeyboard.getConnProfile() != profile)
+		{
+			Serial.printf("[BENCH] %s vom Host nicht übernommen, gemessen wird mit seinen Parametern\n", name);
+		}
+
+		const size_t chars = sizeof(kBenchText) - 1;
+		uint32_t cps[sizeof(kBenchText)];
+		for (size_t i = 0; i < chars; ++i)
+		{
+			cps[i] = static_cast<uint8_t>(kBenchText[i]);
+		}
+
+		gKeyboard.setKeyDelays(false);
+		const uint32_t reports0 = gKeyboard.getReportCount();
+		unsigned long t0 = millis();
+		if (packed)
+		{
+			gKeyboard.typeCodepoints(cps, chars);
+		}
+		else
+		{
+			for (size_t i = 0; i < chars; ++i)
+			{
+				gKeyboard.typeCodepoint(cps[i]);
+			}
+		}
+		unsigned long dt = millis() - t0;
+		gKeyboard.setKeyDelays(true);
+
+		Serial.printf("[BENCH] %s/%s (NKRO=%d): %u Zeichen, %lu Reports in %lu ms = %lu Zeichen/s (Intervall=%u x 1,25 ms, Latency=%u, Timeout=%u x 10 ms)\n",
+			name,
+			packed ? "gepackt" : "einzeln",
+			HID_KEYBOARD_NKRO,
+			(unsigned)chars,
+			(unsigned long)(gKeyboard.getReportCount() - reports0),
+			dt,
+			dt ? (unsigned long)(chars * 1000UL / dt) : 0UL,
+			(unsigned)gKeyboard.getConnInterval(),
+			(unsigned)gKeyboard.getConnLatency(),
+			(unsigned)gKeyboard.getSupervisionTimeout());
+	}
+
+	void runTypingBenchmark()
+	{
+		benchProfile(HidConnProfile::LowLatency, "LowLatency", false);
+		benchProfile(HidConnProfile::LowLatency, "LowLatency", true);
+		benchProfile(HidConnProfile::Idle, "Idle", false);
+		benchProfile(HidConnProfile::Idle, "Idle", true);
+		gKeyboard.requestConnProfile(HidConnProfile::LowLatency, false);
+	}
+}
+
 void setup() {
 	Serial.begin(115200);
 	while (!Serial) {}
@@ -27,23 +102,37 @@ void setup() {
 
 void loop() {
 
-	// 1) Serielle Eingabe -> tippen
-	while (Serial.available()) {
+	// 1) Serielle Eingabe sammeln und gepackt tippen
+	uint32_t input[kInputBufferSize];
+	size_t inputCount = 0;
+
+	while (Serial.available() && inputCount < kInputBufferSize) {
 
 		uint8_t b = (uint8_t)Serial.read();
 		
 		uint32_t cp;
 		if (gUtf.feed(b, cp)) {
 			if (cp == '\r') continue; // nur LF
+			if (cp == kBenchTrigger && gKeyboard.isConnected()) {
+				runTypingBenchmark();
+				continue;
+			}
 			if (!gKeyboard.isConnected()) {
 				if (cp <= 0x7F) Serial.printf("[WARN] Nicht verbunden: '%c' (0x%02X)\n", (char)cp, (unsigned)cp);
 				else            Serial.printf("[WARN] Nicht verbunden: U+%04lX\n", (unsigned long)cp);
 				continue;
 			}
-			gKeyboard.typeCodepoint(cp);
+			input[inputCount++] = cp;
 		}
 	}
 
+	if (inputCount > 0) {
+		gKeyboard.typeCodepoints(input, inputCount);
+	}
+
+	gKeyboard.update();
+	HidLog::flush();
+
 	delay(2);
 }
 
@@ -1,13 +1,162 @@
+/**************************************************************************/
+/*!
+	Esp32NMCI: NFC-Karte auflegen -> Text wird über BLE-HID getippt.
+
+	- PN532 über HSU an Serial2 (RX 26 / TX 25), wie SimpleRead_iso14443a_uid
+	- BLE-HID-Keyboard (DE) aus der gemeinsamen Bibliothek Src/Libraries/HidKeyboard
+	- Karten und Texte bevorzugt aus der Flash-Partition "macros" (partitions.csv),
+	  erzeugt mit Src/Tools/MacroBlob aus einer Makro-Skriptdatei und über
+	  esp_partition_mmap ohne Kopie gelesen
+	- Ohne gültigen Blob: eingebaute Tabelle src/CardMacroTable.h; die Texte werden
+	  zur Compile-Zeit in HID-Reports übersetzt und liegen ebenfalls im Flash
+	- Pro erkannter Karte wird die Lesedauer und die Zeit von der Kartenerkennung
+	  bis zum ersten HID-Notify ausgegeben. Das sind Zeitstempel auf dem Gerät, sie
+	  enthalten nicht die Übertragung zum Host. Gemessene Werte liegen bisher keine vor,
+	  einen reproduzierbaren Messaufbau gibt es nicht.
+*/
+/**************************************************************************/
+
 #include <PN532_HSU.h>
 #include <PN532.h>
 #include <NimBLEDevice.h>
+#include <HidKeyboard.h>
+#include <HidLog.h>
+
+#include <string.h>
+
+#include "src/CardMacroEngine.h"
+#include "src/CardMacroTable.h"
+#include "src/MacroStore.h"
+
+#define PN532_HSU_PORT Serial2
+constexpr auto PN532_HSU_BAUDRATE = 115200;
+constexpr auto PN532_HSU_RX_PIN = 26;
+constexpr auto PN532_HSU_TX_PIN = 25;
+
+static PN532_HSU pn532hsu(PN532_HSU_PORT);
+static PN532 nfc(pn532hsu);
+
+static HidKeyboard gKeyboard;
+static MacroStore gStore;
+static CardMacroEngine gMacros(gKeyboard, CardMacroTable::kCardMacros, CardMacroTable::kCardMacroCount);
+
+namespace
+{
+	constexpr uint8_t kUidBufferSize = 7;
+
+	// Kurzer Timeout, damit loop() (BLE-Pacing, Log) nicht blockiert wird.
+	constexpr uint16_t kReadTimeoutMs = 50;
+
+	bool isSameUid(const uint8_t* lhs, const uint8_t* rhs, uint8_t length)
+	{
+		return lhs && rhs && (memcmp(lhs, rhs, length) == 0);
+	}
+
+	void pollCard()
+	{
+		static uint8_t lastUid[kUidBufferSize];
+		static uint8_t lastUidLength = 0;
+		static bool tagPresent = false;
+
+		uint8_t uid[kUidBufferSize];
+		uint8_t uidLength = 0;
+
+		const uint32_t readStartUs = micros();
+		if (nfc.readPassiveTargetID(PN532_MIFARE_ISO14443A, uid, &uidLength, kReadTimeoutMs))
+		{
+			const uint32_t detectedUs = micros();
+
+			bool newTagDetected = !tagPresent || (uidLength != lastUidLength) ||
+				!isSameUid(uid, lastUid, uidLength);
+
+			if (newTagDetected)
+			{
+				tagPresent = true;
+				lastUidLength = uidLength;
+				memcpy(lastUid, uid, uidLength);
+
+				CardMacro macro;
+				bool started = gStore.find(uid, uidLength, macro)
+					? gMacros.play(macro, detectedUs)
+					: gMacros.trigger(uid, uidLength, detectedUs);
+
+				Serial.print(F("UID:"));
+				nfc.PrintHex(uid, uidLength);
+				Serial.printf("Lesen: %lu us", (unsigned long)(detectedUs - readStartUs));
+				if (started)
+				{
+					// Die Zeit bis zum ersten Notify meldet CardMacroEngine selbst (Tag NFC).
+					Serial.println(F(", Makro gestartet"));
+				}
+				else if (!gKeyboard.isConnected())
+				{
+					Serial.println(F(", nicht verbunden"));
+				}
+				else
+				{
+					Serial.println(F(", unbekannte Karte"));
+				}
+			}
+		}
+		else if (tagPresent)
+		{
+			tagPresent = false;
+			lastUidLength = 0;
+			Serial.println(F("Tag removed"));
+		}
+	}
+}  // namespace
 
 void setup() {
-  // put your setup code here, to run once:
 
+	Serial.begin(115200);
+	while (!Serial)
+	{
+		delay(10);
+	}
+
+	PN532_HSU_PORT.begin(PN532_HSU_BAUDRATE, SERIAL_8N1, PN532_HSU_RX_PIN, PN532_HSU_TX_PIN);
+
+	nfc.begin();
+
+	uint32_t versiondata = nfc.getFirmwareVersion();
+	if (!versiondata)
+	{
+		Serial.println(F("PN532 not found"));
+
+		while (true)
+		{
+			delay(1000);
+		}
+	}
+
+	Serial.print(F("Found chip PN5"));
+	Serial.println((versiondata >> 24) & 0xFF, HEX);
+
+	nfc.SAMConfig();
+	// Nur ein Aktivierungsversuch pro Aufruf: Die Karte wird über wiederholtes Pollen
+	// aus loop() gefunden, nicht über Retries im PN532.
+	nfc.setPassiveActivationRetries(0x01);
+
+	if (!gStore.begin())
+	{
+		Serial.println(F("Kein gültiger Makro-Blob, verwende eingebaute Tabelle"));
+	}
+
+	gKeyboard.begin();
+
+	Serial.println(F("Waiting for an ISO14443A Card ..."));
 }
 
-void loop() {
-  // put your main code here, to run repeatedly:
+void loop()
+{
+	// Während ein Makro läuft, nicht pollen: Ein Lesevorgang würde das Report-Timing verzögern.
+	if (!gMacros.isBusy())
+	{
+		pollCard();
+	}
 
+	gMacros.update();
+	gKeyboard.update();
+	HidLog::flush();
 }
@@ -0,0 +1,137 @@
+/**
+ * @file CardMacro.h
+ * @brief Zur Compile-Zeit in HID-Reports übersetzte Texte, die beim Lesen einer Karte getippt werden.
+ *
+ * compileMacro("...") wandelt einen UTF-8-Text über hidMapDE() in eine flache Folge von
+ * 8-Byte-Boot-Reports (Press/Release) um. Das Ergebnis ist constexpr und liegt damit im Flash;
+ * zur Laufzeit findet keine Zeichenkonvertierung mehr statt. Nicht abbildbare Zeichen führen
+ * zu einem Compile-Fehler.
+ *
+ * Aufeinanderfolgende Zeichen mit gleichen Modifiern und unterschiedlichen Tasten werden wie
+ * bei HidKeyboard::typeCodepoints() in einen Report gepackt (6KRO, Array-Reihenfolge).
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <HidConsts.h>
+#include <HidLayoutDE.h>
+
+/**
+ * @brief Ein Boot-Keyboard-Report: Modifier, Reserved, sechs Keycodes.
+ */
+struct HidReport {
+	uint8_t data[KEYBOARD_BOOT_REPORT_LEN];
+};
+
+/**
+ * @brief Ergebnis von compileMacro(): Reports und deren tatsächliche Anzahl.
+ *
+ * @tparam Capacity Obergrenze, abgeleitet aus der Länge des Quelltextes.
+ */
+template <size_t Capacity>
+struct CompiledMacro {
+	HidReport reports[Capacity];
+	uint16_t count;
+};
+
+/**
+ * @brief Eintrag der Kartentabelle: UID der Karte und die zu tippenden Reports.
+ */
+struct CardMacro {
+	uint8_t uidLength;
+	uint8_t uid[7];
+	const HidReport* reports;
+	uint16_t reportCount;
+};
+
+namespace CardMacroDetail {
+
+	// Absichtlich nicht constexpr und nicht definiert: Wird die Funktion bei der Auswertung
+	// von compileMacro() erreicht, bricht der Compiler mit einem Fehler ab.
+	void unmappedCharacterInMacro();
+
+	constexpr uint32_t decodeUtf8(const char* text, size_t length, size_t& pos) {
+		const uint8_t lead = static_cast<uint8_t>(text[pos++]);
+		if (lead < 0x80) {
+			return lead;
+		}
+		size_t needed = 0;
+		uint32_t cp = 0;
+		if ((lead & 0xE0) == 0xC0) { cp = lead & 0x1F; needed = 1; }
+		else if ((lead & 0xF0) == 0xE0) { cp = lead & 0x0F; needed = 2; }
+		else if ((lead & 0xF8) == 0xF0) { cp = lead & 0x07; needed = 3; }
+		else { unmappedCharacterInMacro(); }
+		while (needed-- > 0) {
+			if (pos >= length || (static_cast<uint8_t>(text[pos]) & 0xC0) != 0x80) {
+				unmappedCharacterInMacro();
+			}
+			cp = (cp << 6) | (static_cast<uint8_t>(text[pos++]) & 0x3F);
+		}
+		return cp;
+	}
+
+	template <size_t Capacity>
+	constexpr void emitChunk(CompiledMacro<Capacity>& macro, uint8_t mods, const uint8_t* keys, size_t count) {
+		HidReport& press = macro.reports[macro.count++];
+		press.data[0] = mods;
+		for (size_t i = 0; i < count; ++i) {
+			press.data[2 + i] = keys[i];
+		}
+		// Release: bereits durch die Wertinitialisierung genullt.
+		macro.count++;
+	}
+}  // namespace CardMacroDetail
+
+/**
+ * @brief Übersetzt einen UTF-8-Text zur Compile-Zeit in eine Press/Release-Reportfolge.
+ *
+ * Verwendung: static constexpr auto kMacro = compileMacro("Der Narr");
+ */
+template <size_t N>
+constexpr CompiledMacro<2 * N> compileMacro(const char (&text)[N]) {
+	CompiledMacro<2 * N> macro{};
+	uint8_t keys[KEYBOARD_BOOT_KEY_SLOTS]{};
+	size_t keyCount = 0;
+	uint8_t chunkMods = 0;
+
+	size_t pos = 0;
+	while (pos < N - 1 && text[pos] != '\0') {
+		const uint32_t cp = CardMacroDetail::decodeUtf8(text, N - 1, pos);
+		uint8_t mods = 0;
+		uint8_t key = 0;
+		if (!hidMapDE(cp, mods, key)) {
+			CardMacroDetail::unmappedCharacterInMacro();
+		}
+
+		bool duplicate = false;
+		for (size_t i = 0; i < keyCount; ++i) {
+			duplicate = duplicate || keys[i] == key;
+		}
+		if (keyCount > 0 && (mods != chunkMods || keyCount >= KEYBOARD_BOOT_KEY_SLOTS || duplicate)) {
+			CardMacroDetail::emitChunk(macro, chunkMods, keys, keyCount);
+			keyCount = 0;
+		}
+		chunkMods = mods;
+		keys[keyCount++] = key;
+	}
+	if (keyCount > 0) {
+		CardMacroDetail::emitChunk(macro, chunkMods, keys, keyCount);
+	}
+	return macro;
+}
+
+/**
+ * @brief Baut einen Tabelleneintrag aus UID und kompiliertem Makro.
+ */
+template <size_t L, size_t C>
+constexpr CardMacro makeCardMacro(const uint8_t (&uid)[L], const CompiledMacro<C>& macro) {
+	static_assert(L <= 7, "ISO14443A-UIDs sind maximal 7 Byte lang");
+	CardMacro entry{ static_cast<uint8_t>(L), {}, macro.reports, macro.count };
+	for (size_t i = 0; i < L; ++i) {
+		entry.uid[i] = uid[i];
+	}
+	return entry;
+}
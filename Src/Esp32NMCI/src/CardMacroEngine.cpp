@@ -0,0 +1,106 @@
+#include "CardMacroEngine.h"
+
+#include <Arduino.h>
+#include <string.h>
+#include <HidKeyboard.h>
+#include <HidLog.h>
+
+#include "MacroBlob.h"
+
+namespace {
+
+    // Haltezeit einer gedrückten Taste bzw. Pause nach dem Release, wie HidKeyboard::pressAndRelease.
+    constexpr uint32_t kPressHoldUs = 8000;
+    constexpr uint32_t kReleaseGapUs = 5000;
+
+    bool isRelease(const HidReport& report) {
+        for (uint8_t b : report.data) {
+            if (b != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+}  // namespace
+
+CardMacroEngine::CardMacroEngine(HidKeyboard& keyboard, const CardMacro* table, size_t count)
+    : mKeyboard(keyboard)
+    , mTable(table)
+    , mCount(count)
+    , mNext(nullptr)
+    , mRemaining(0)
+    , mNextDueUs(0)
+    , mDetectedUs(0)
+    , mLatencyPending(false)
+    , mLastLatencyUs(0) {
+}
+
+const CardMacro* CardMacroEngine::find(const uint8_t* uid, uint8_t uidLength) const {
+    for (size_t i = 0; i < mCount; ++i) {
+        const CardMacro& entry = mTable[i];
+        if (entry.uidLength == uidLength && memcmp(entry.uid, uid, uidLength) == 0) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+bool CardMacroEngine::trigger(const uint8_t* uid, uint8_t uidLength, uint32_t detectedUs) {
+    const CardMacro* macro = find(uid, uidLength);
+    return macro && play(*macro, detectedUs);
+}
+
+bool CardMacroEngine::play(const CardMacro& macro, uint32_t detectedUs) {
+    if (isBusy() || !mKeyboard.isConnected() || macro.reportCount == 0) {
+        return false;
+    }
+
+    mNext = macro.reports;
+    mRemaining = macro.reportCount;
+    mDetectedUs = detectedUs;
+    mLatencyPending = true;
+    HID_LOGD("NFC", "Makro gestartet: %u Records", (unsigned)macro.reportCount);
+    sendNext();
+    return true;
+}
+
+void CardMacroEngine::update() {
+    if (!isBusy()) {
+        return;
+    }
+    if ((int32_t)(micros() - mNextDueUs) >= 0) {
+        sendNext();
+    }
+}
+
+bool CardMacroEngine::isBusy() const {
+    return mRemaining != 0;
+}
+
+uint32_t CardMacroEngine::getLastLatencyUs() const {
+    return mLastLatencyUs;
+}
+
+void CardMacroEngine::sendNext() {
+    if (!mKeyboard.isConnected()) {
+        mRemaining = 0;
+        return;
+    }
+
+    const HidReport& report = *mNext++;
+    --mRemaining;
+
+    if (macroBlobIsDelay(report)) {
+        mNextDueUs = micros() + uint32_t(macroBlobDelayMs(report)) * 1000UL;
+        return;
+    }
+
+    mKeyboard.sendBootReport(report.data);
+    mNextDueUs = micros() + (isRelease(report) ? kReleaseGapUs : kPressHoldUs);
+
+    if (mLatencyPending) {
+        mLatencyPending = false;
+        mLastLatencyUs = micros() - mDetectedUs;
+        HID_LOGI("NFC", "Karte -> erster Notify: %lu us", (unsigned long)mLastLatencyUs);
+    }
+}
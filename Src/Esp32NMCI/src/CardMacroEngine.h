@@ -0,0 +1,78 @@
+/**
+ * @file CardMacroEngine.h
+ * @brief Spielt beim Lesen einer Karte das zugehörige vorkompilierte Makro über HidKeyboard ab.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "CardMacro.h"
+
+class HidKeyboard;
+
+/**
+ * @brief Ordnet Karten-UIDs vorkompilierte Reportfolgen zu und sendet sie nicht-blockierend.
+ *
+ * trigger() sendet den ersten Report sofort aus dem Aufrufkontext, damit das Tippen spätestens
+ * im nächsten Connection Event beginnt. Die restlichen Reports werden in update() getaktet.
+ * Zeitmarker aus einem Makro-Blob (siehe MacroBlob.h) werden als Pause ausgeführt.
+ */
+class CardMacroEngine {
+public:
+	/**
+	 * @brief Konstruktor mit Tastatur und Kartentabelle (typischerweise constexpr im Flash).
+	 */
+	CardMacroEngine(HidKeyboard& keyboard, const CardMacro* table, size_t count);
+
+	/**
+	 * @brief Sucht das Makro zur UID.
+	 *
+	 * @return nullptr, wenn die Karte nicht in der Tabelle steht.
+	 */
+	const CardMacro* find(const uint8_t* uid, uint8_t uidLength) const;
+
+	/**
+	 * @brief Startet das Makro zur UID und sendet den ersten Report.
+	 *
+	 * @param detectedUs micros()-Zeitstempel, zu dem der Kartenleser die UID geliefert hat.
+	 * @return false, wenn die Karte unbekannt ist, gerade ein Makro läuft oder keine Verbindung besteht.
+	 */
+	bool trigger(const uint8_t* uid, uint8_t uidLength, uint32_t detectedUs);
+
+	/**
+	 * @brief Startet ein Makro, das nicht aus der Tabelle stammt (z.B. aus MacroStore).
+	 *
+	 * Die Reports werden nicht kopiert und müssen gültig bleiben, bis isBusy() false liefert.
+	 */
+	bool play(const CardMacro& macro, uint32_t detectedUs);
+
+	/**
+	 * @brief Muss zyklisch aus loop() aufgerufen werden und sendet fällige Reports.
+	 */
+	void update();
+
+	/**
+	 * @brief Gibt zurück, ob gerade ein Makro abgespielt wird.
+	 */
+	bool isBusy() const;
+
+	/**
+	 * @brief Zeit von der Kartenerkennung bis zum ersten HID-Notify des letzten Makros (µs).
+	 */
+	uint32_t getLastLatencyUs() const;
+
+private:
+	void sendNext();
+
+	HidKeyboard& mKeyboard;
+	const CardMacro* mTable;
+	size_t mCount;
+	const HidReport* mNext;
+	uint16_t mRemaining;
+	uint32_t mNextDueUs;
+	uint32_t mDetectedUs;
+	bool mLatencyPending;
+	uint32_t mLastLatencyUs;
+};
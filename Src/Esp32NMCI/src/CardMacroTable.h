@@ -0,0 +1,30 @@
+/**
+ * @file CardMacroTable.h
+ * @brief Zuordnung Karten-UID -> zu tippender Text. Wird vollständig zur Compile-Zeit aufgelöst.
+ *
+ * Die UIDs sind Platzhalter und müssen durch die der eigenen Karten ersetzt werden
+ * (Ausgabe "UID:" im seriellen Monitor beim Auflegen einer Karte).
+ */
+
+#pragma once
+
+#include "CardMacro.h"
+
+namespace CardMacroTable {
+
+	static constexpr uint8_t kUidNarr[] = { 0x04, 0x11, 0x22, 0x33, 0x44, 0x55, 0x80 };
+	static constexpr uint8_t kUidMagier[] = { 0x04, 0x11, 0x22, 0x33, 0x44, 0x55, 0x81 };
+	static constexpr uint8_t kUidHohepriesterin[] = { 0x04, 0x11, 0x22, 0x33, 0x44, 0x55, 0x82 };
+
+	static constexpr auto kMacroNarr = compileMacro("Der Narr\n");
+	static constexpr auto kMacroMagier = compileMacro("Der Magier\n");
+	static constexpr auto kMacroHohepriesterin = compileMacro("Die Hohepriesterin\n");
+
+	static constexpr CardMacro kCardMacros[] = {
+		makeCardMacro(kUidNarr, kMacroNarr),
+		makeCardMacro(kUidMagier, kMacroMagier),
+		makeCardMacro(kUidHohepriesterin, kMacroHohepriesterin),
+	};
+
+	static constexpr size_t kCardMacroCount = sizeof(kCardMacros) / sizeof(kCardMacros[0]);
+}  // namespace CardMacroTable
@@ -0,0 +1,120 @@
+#include "MacroBlob.h"
+
+#include <string.h>
+
+MacroBlobReader::MacroBlobReader()
+    : mData(nullptr)
+    , mHeader(nullptr)
+    , mEntries(nullptr)
+    , mRecords(nullptr)
+    , mRecordCount(0) {
+}
+
+MacroBlobReader::Status MacroBlobReader::open(const void* data, size_t size) {
+    mData = nullptr;
+    mHeader = nullptr;
+    mEntries = nullptr;
+    mRecords = nullptr;
+    mRecordCount = 0;
+
+    if (!data || size < sizeof(MacroBlobHeader)) {
+        return Status::TooSmall;
+    }
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    const MacroBlobHeader* header = reinterpret_cast<const MacroBlobHeader*>(bytes);
+    if (header->magic != MACRO_BLOB_MAGIC) {
+        return Status::BadMagic;
+    }
+    if (header->version != MACRO_BLOB_VERSION) {
+        return Status::BadVersion;
+    }
+
+    const size_t tableEnd = sizeof(MacroBlobHeader) + size_t(header->entryCount) * sizeof(MacroBlobEntry);
+    if (header->totalSize > size || header->totalSize < tableEnd ||
+        (header->totalSize - tableEnd) % sizeof(HidReport) != 0) {
+        return Status::BadSize;
+    }
+    if (crc32(bytes + sizeof(MacroBlobHeader), header->totalSize - sizeof(MacroBlobHeader)) != header->crc32) {
+        return Status::BadCrc;
+    }
+
+    const MacroBlobEntry* entries = reinterpret_cast<const MacroBlobEntry*>(bytes + sizeof(MacroBlobHeader));
+    const uint32_t recordCount = (header->totalSize - tableEnd) / sizeof(HidReport);
+    for (size_t i = 0; i < header->entryCount; ++i) {
+        const MacroBlobEntry& entry = entries[i];
+        if (entry.uidLength == 0 || entry.uidLength > sizeof(entry.uid) ||
+            entry.firstRecord > recordCount || entry.recordCount > recordCount - entry.firstRecord) {
+            return Status::BadEntry;
+        }
+    }
+
+    mData = bytes;
+    mHeader = header;
+    mEntries = entries;
+    mRecords = reinterpret_cast<const HidReport*>(bytes + tableEnd);
+    mRecordCount = recordCount;
+    return Status::Ok;
+}
+
+bool MacroBlobReader::isOpen() const {
+    return mHeader != nullptr;
+}
+
+const MacroBlobHeader* MacroBlobReader::header() const {
+    return mHeader;
+}
+
+const MacroBlobEntry* MacroBlobReader::begin() const {
+    return mEntries;
+}
+
+const MacroBlobEntry* MacroBlobReader::end() const {
+    return mEntries + size();
+}
+
+size_t MacroBlobReader::size() const {
+    return mHeader ? mHeader->entryCount : 0;
+}
+
+const HidReport* MacroBlobReader::records(const MacroBlobEntry& entry) const {
+    return mRecords + entry.firstRecord;
+}
+
+bool MacroBlobReader::find(const uint8_t* uid, uint8_t uidLength, CardMacro& macro) const {
+    for (const MacroBlobEntry& entry : *this) {
+        if (entry.uidLength == uidLength && memcmp(entry.uid, uid, uidLength) == 0) {
+            macro.uidLength = entry.uidLength;
+            memcpy(macro.uid, entry.uid, sizeof(macro.uid));
+            macro.reports = records(entry);
+            macro.reportCount = entry.recordCount;
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t MacroBlobReader::crc32(const uint8_t* data, size_t length) {
+    // Bitweise statt Tabelle: läuft nur einmal beim Öffnen und spart 1 KB Flash/RAM.
+    uint32_t crc = 0xFFFFFFFFUL;
+    for (size_t i = 0; i < length; ++i) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ (0xEDB88320UL & (0UL - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+const char* MacroBlobReader::statusName(Status status) {
+    switch (status) {
+    case Status::Ok:         return "Ok";
+    case Status::TooSmall:   return "zu klein";
+    case Status::BadMagic:   return "falsche Kennung";
+    case Status::BadVersion: return "falsche Formatversion";
+    case Status::BadSize:    return "ungültige Größe";
+    case Status::BadCrc:     return "CRC-Fehler";
+    case Status::BadEntry:   return "ungültiger Eintrag";
+    }
+    return "?";
+}
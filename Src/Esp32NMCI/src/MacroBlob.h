@@ -0,0 +1,145 @@
+/**
+ * @file MacroBlob.h
+ * @brief Binärformat der Makro-Partition und ein Leser, der direkt auf dem gemappten Flash arbeitet.
+ *
+ * Der Blob wird auf dem PC von Src/Tools/MacroBlob aus einer Makro-Skriptdatei erzeugt und in
+ * die Daten-Partition "macros" geschrieben. Die Firmware mappt die Partition in den Adressraum
+ * (esp_partition_mmap) und liest Einträge und Reports ohne Kopie aus dem Flash-Cache.
+ *
+ * Aufbau (little endian, alle Teile 4-Byte-ausgerichtet):
+ *
+ *   MacroBlobHeader                    16 Byte
+ *   MacroBlobEntry[entryCount]         je 16 Byte
+ *   HidReport[recordCount]             je 8 Byte, Records aller Einträge hintereinander
+ *
+ * Ein Record ist entweder ein Boot-Keyboard-Report (Byte 1 = 0, wie vom HID-Standard
+ * vorgegeben) oder ein Zeitmarker (Byte 1 = MACRO_BLOB_OP_DELAY, Bytes 2..3 = Pause in ms).
+ *
+ * Die CRC32 (IEEE, wie zlib) läuft über alle Bytes nach dem Header.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "CardMacro.h"
+
+// "NMCM" als little-endian-Wort.
+#define MACRO_BLOB_MAGIC 0x4D434D4EUL
+
+// Bei inkompatiblen Änderungen am Format erhöhen; der Leser akzeptiert nur genau diese Version.
+#define MACRO_BLOB_VERSION 1
+
+// Byte 1 eines Records: 0 = HID-Report, MACRO_BLOB_OP_DELAY = Zeitmarker.
+#define MACRO_BLOB_OP_DELAY 0x01
+
+// Name der Daten-Partition in partitions.csv.
+#define MACRO_BLOB_PARTITION_LABEL "macros"
+
+/**
+ * @brief Kopf des Blobs.
+ */
+struct MacroBlobHeader {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t entryCount;
+	uint32_t totalSize;     // Header + Einträge + Records in Byte
+	uint32_t crc32;         // über die totalSize - sizeof(MacroBlobHeader) Bytes nach dem Header
+};
+
+/**
+ * @brief Eintrag pro Karte: UID und Bereich in der Record-Tabelle.
+ */
+struct MacroBlobEntry {
+	uint8_t uidLength;
+	uint8_t uid[7];
+	uint32_t firstRecord;   // Index in die Record-Tabelle
+	uint16_t recordCount;
+	uint16_t reserved;
+};
+
+static_assert(sizeof(MacroBlobHeader) == 16, "MacroBlobHeader muss 16 Byte groß sein");
+static_assert(sizeof(MacroBlobEntry) == 16, "MacroBlobEntry muss 16 Byte groß sein");
+static_assert(sizeof(HidReport) == 8, "HidReport muss 8 Byte groß sein");
+
+/**
+ * @brief Gibt zurück, ob ein Record ein Zeitmarker ist.
+ */
+inline bool macroBlobIsDelay(const HidReport& record) {
+	return record.data[1] == MACRO_BLOB_OP_DELAY;
+}
+
+/**
+ * @brief Pause eines Zeitmarkers in Millisekunden.
+ */
+inline uint16_t macroBlobDelayMs(const HidReport& record) {
+	return static_cast<uint16_t>(record.data[2] | (record.data[3] << 8));
+}
+
+/**
+ * @brief Prüft einen Blob und bietet Zugriff auf Einträge und Records ohne Kopie.
+ *
+ * Wird in der Firmware auf dem gemappten Partitionsinhalt und im PC-Tool auf dem
+ * geladenen Dateiinhalt verwendet, damit beide Seiten dieselbe Prüfung durchführen.
+ */
+class MacroBlobReader {
+public:
+	enum class Status {
+		Ok,
+		TooSmall,
+		BadMagic,
+		BadVersion,
+		BadSize,
+		BadCrc,
+		BadEntry,
+	};
+
+	MacroBlobReader();
+
+	/**
+	 * @brief Prüft Header, Größen, CRC und alle Einträge.
+	 *
+	 * @param [in] data Anfang des Blobs, muss 4-Byte-ausgerichtet sein und gültig bleiben.
+	 * @param [in] size Verfügbare Bytes (Partitions- bzw. Dateigröße).
+	 */
+	Status open(const void* data, size_t size);
+
+	/**
+	 * @brief Gibt zurück, ob open() erfolgreich war.
+	 */
+	bool isOpen() const;
+
+	const MacroBlobHeader* header() const;
+
+	/**
+	 * @brief Einträge als Bereich, z.B. für range-based for.
+	 */
+	const MacroBlobEntry* begin() const;
+	const MacroBlobEntry* end() const;
+	size_t size() const;
+
+	/**
+	 * @brief Erster Record eines Eintrags.
+	 */
+	const HidReport* records(const MacroBlobEntry& entry) const;
+
+	/**
+	 * @brief Sucht die UID und liefert einen CardMacro, dessen Reports in den Blob zeigen.
+	 */
+	bool find(const uint8_t* uid, uint8_t uidLength, CardMacro& macro) const;
+
+	/**
+	 * @brief CRC32 (IEEE 802.3, wie zlib crc32()).
+	 */
+	static uint32_t crc32(const uint8_t* data, size_t length);
+
+	static const char* statusName(Status status);
+
+private:
+	const uint8_t* mData;
+	const MacroBlobHeader* mHeader;
+	const MacroBlobEntry* mEntries;
+	const HidReport* mRecords;
+	uint32_t mRecordCount;
+};
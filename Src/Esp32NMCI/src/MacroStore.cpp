@@ -0,0 +1,68 @@
+#include "MacroStore.h"
+
+#include <esp_err.h>
+
+#include <HidLog.h>
+
+MacroStore::MacroStore()
+    : mStatus(MacroBlobReader::Status::TooSmall)
+    , mHandle(0)
+    , mMapped(false) {
+}
+
+MacroStore::~MacroStore() {
+    end();
+}
+
+bool MacroStore::begin(const char* partitionLabel) {
+    end();
+
+    const esp_partition_t* partition =
+        esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, partitionLabel);
+    if (!partition) {
+        HID_LOGW("MACRO", "Partition '%s' nicht gefunden", partitionLabel);
+        return false;
+    }
+
+    const void* data = nullptr;
+    esp_err_t err = esp_partition_mmap(partition, 0, partition->size, ESP_PARTITION_MMAP_DATA, &data, &mHandle);
+    if (err != ESP_OK) {
+        HID_LOGE("MACRO", "esp_partition_mmap fehlgeschlagen: %s", esp_err_to_name(err));
+        return false;
+    }
+    mMapped = true;
+
+    mStatus = mReader.open(data, partition->size);
+    if (mStatus != MacroBlobReader::Status::Ok) {
+        HID_LOGW("MACRO", "Blob in '%s' ungültig: %s", partitionLabel, MacroBlobReader::statusName(mStatus));
+        end();
+        return false;
+    }
+
+    HID_LOGI("MACRO", "%u Makros, %lu Byte aus Partition '%s'",
+        (unsigned)mReader.size(),
+        (unsigned long)mReader.header()->totalSize,
+        partitionLabel);
+    return true;
+}
+
+void MacroStore::end() {
+    if (mMapped) {
+        // Reader zuerst schließen, damit keine Zeiger auf den freigegebenen Bereich übrig bleiben.
+        mReader.open(nullptr, 0);
+        esp_partition_munmap(mHandle);
+        mMapped = false;
+    }
+}
+
+MacroBlobReader::Status MacroStore::getStatus() const {
+    return mStatus;
+}
+
+const MacroBlobReader& MacroStore::reader() const {
+    return mReader;
+}
+
+bool MacroStore::find(const uint8_t* uid, uint8_t uidLength, CardMacro& macro) const {
+    return mReader.isOpen() && mReader.find(uid, uidLength, macro);
+}
@@ -0,0 +1,54 @@
+/**
+ * @file MacroStore.h
+ * @brief Mappt die Makro-Partition in den Adressraum und stellt ihren Inhalt über MacroBlobReader bereit.
+ */
+
+#pragma once
+
+#include <esp_partition.h>
+
+#include "MacroBlob.h"
+
+/**
+ * @brief Zugriff auf den Makro-Blob im Flash über den Flash-Cache (esp_partition_mmap).
+ *
+ * Die Reports werden nicht ins RAM kopiert; CardMacro::reports zeigt direkt in den gemappten Bereich.
+ */
+class MacroStore {
+public:
+	MacroStore();
+	~MacroStore();
+
+	MacroStore(const MacroStore&) = delete;
+	MacroStore& operator=(const MacroStore&) = delete;
+
+	/**
+	 * @brief Sucht die Partition, mappt sie und prüft den Blob.
+	 *
+	 * @return false, wenn die Partition fehlt, nicht gemappt werden kann oder der Blob ungültig ist.
+	 */
+	bool begin(const char* partitionLabel = MACRO_BLOB_PARTITION_LABEL);
+
+	/**
+	 * @brief Gibt das Mapping wieder frei.
+	 */
+	void end();
+
+	/**
+	 * @brief Ergebnis der letzten Prüfung in begin().
+	 */
+	MacroBlobReader::Status getStatus() const;
+
+	const MacroBlobReader& reader() const;
+
+	/**
+	 * @brief Sucht die UID im Blob.
+	 */
+	bool find(const uint8_t* uid, uint8_t uidLength, CardMacro& macro) const;
+
+private:
+	MacroBlobReader mReader;
+	MacroBlobReader::Status mStatus;
+	esp_partition_mmap_handle_t mHandle;
+	bool mMapped;
+};
@@ -105,6 +105,32 @@ static const uint16_t UUID_BOOT_KB_OUTPUT = 0x2A32;
 // Descriptor, der zu einem Report die Report-ID und den Report-Typ referenziert.
 static const uint16_t UUID_RPT_REF_DESC = 0x2908;
 
+// ---------- Report-Format ----------
+
+// 0 = Report-Charakteristik liefert den Boot-kompatiblen 6KRO-Report,
+// 1 = Report-Charakteristik liefert einen NKRO-Bitmap-Report (KEYBOARD_REPORTMAP_NKRO).
+// Muss für den ganzen Build gelten (build_opt.h im Sketch-Ordner mit -DHID_KEYBOARD_NKRO=1 oder
+// das Compiler-Flag). Ein #define im Sketch erreicht HidKeyboard.cpp nicht, Sketch und Bibliothek
+// würden dann unterschiedliche Report-Formate annehmen.
+#ifndef HID_KEYBOARD_NKRO
+#define HID_KEYBOARD_NKRO 0
+#endif
+
+// Länge des Boot-Keyboard-Reports: Modifier, Reserved, sechs Keycodes.
+static const uint8_t KEYBOARD_BOOT_REPORT_LEN = 8;
+
+// Anzahl der Keycode-Slots im Boot-Report (6-Key-Rollover).
+static const uint8_t KEYBOARD_BOOT_KEY_SLOTS = 6;
+
+// Höchste im Bitmap abgebildete Usage (0x00..0x65, ein Bit pro Usage).
+static const uint8_t KEYBOARD_NKRO_MAX_USAGE = 0x65;
+
+// Bytes für das Bitmap: 102 Bits + 2 Padding-Bits.
+static const uint8_t KEYBOARD_NKRO_BITMAP_LEN = 13;
+
+// Länge des NKRO-Reports: Modifier + Bitmap.
+static const uint8_t KEYBOARD_NKRO_REPORT_LEN = 1 + KEYBOARD_NKRO_BITMAP_LEN;
+
 // ---------- Report-Map ----------
 
 /*
@@ -143,3 +169,37 @@ static const uint8_t KEYBOARD_REPORTMAP[] = {
 	0x81, 0x00,                   // Input (Data,Arr,Abs)
   0xC0
 };
+
+/*
+ * KEYBOARD_REPORTMAP_NKRO beschreibt einen N-Key-Rollover-Report mit derselben Report-ID 1:
+ *  - Acht Modifier-Bits E0..E7 (ohne reserviertes Byte, der Report ist nicht Boot-kompatibel;
+ *    Boot-Hosts lesen weiterhin die Boot-Input-Charakteristik).
+ *  - LED-Output-Report wie bei KEYBOARD_REPORTMAP.
+ *  - Ein Bit pro Usage 0x00..0x65 (102 Bits) als Variable-Feld, aufgefüllt auf 13 Byte.
+ *    Damit können beliebig viele unterschiedliche Tasten gleichzeitig gemeldet werden.
+ */
+static const uint8_t KEYBOARD_REPORTMAP_NKRO[] = {
+  0x05, 0x01, 0x09, 0x06, 0xA1, 0x01,
+	0x85, 0x01,                   // Report ID = 1 (Input)
+	0x05, 0x07,
+	0x19, 0xE0, 0x29, 0xE7,       // Modifiers
+	0x15, 0x00, 0x25, 0x01,
+	0x75, 0x01, 0x95, 0x08,
+	0x81, 0x02,                   // Input (Data,Var,Abs)
+
+	0x05, 0x08,
+	0x19, 0x01, 0x29, 0x05,       // LEDs
+	0x75, 0x01, 0x95, 0x05,
+	0x91, 0x02,                   // Output (Data,Var,Abs)
+	0x75, 0x03, 0x95, 0x01,
+	0x91, 0x01,                   // Output (Const,Arr,Abs) padding
+
+	0x05, 0x07,
+	0x19, 0x00, 0x29, 0x65,       // Keys 0..101
+	0x15, 0x00, 0x25, 0x01,
+	0x75, 0x01, 0x95, 0x66,
+	0x81, 0x02,                   // Input (Data,Var,Abs) – ein Bit pro Taste
+	0x75, 0x02, 0x95, 0x01,
+	0x81, 0x01,                   // Input (Const) padding auf 13 Byte
+  0xC0
+};
@@ -0,0 +1,602 @@
+#include "HidKeyboard.h"
+
+#include <Arduino.h>
+
+#include "HidConsts.h"
+#include "HidLayoutDE.h"
+#include "HidLog.h"
+
+#if !defined(NIMBLE_CPP_CONNINFO_H_)
+#    if defined(__has_include)
+#        if __has_include(<NimBLEConnInfo.h>)
+#            include <NimBLEConnInfo.h>
+#        endif
+#    endif
+#endif
+
+#if defined(NIMBLE_CPP_CONNINFO_H_)
+#    define HID_KEYBOARD_HAS_CONN_INFO 1
+#else
+#    define HID_KEYBOARD_HAS_CONN_INFO 0
+#endif
+
+class HidKeyboardProtocolModeCallbacks : public NimBLECharacteristicCallbacks {
+public:
+    explicit HidKeyboardProtocolModeCallbacks(HidKeyboard& keyboard) : mKeyboard(keyboard) {}
+
+#if HID_KEYBOARD_HAS_CONN_INFO
+    void onWrite(NimBLECharacteristic* characteristic, NimBLEConnInfo&) override {
+        mKeyboard.handleProtocolModeWrite(characteristic);
+    }
+#else
+    void onWrite(NimBLECharacteristic* characteristic) override {
+        mKeyboard.handleProtocolModeWrite(characteristic);
+    }
+#endif
+
+private:
+    HidKeyboard& mKeyboard;
+};
+
+class HidKeyboardInputSubscribeCallbacks : public NimBLECharacteristicCallbacks {
+public:
+    explicit HidKeyboardInputSubscribeCallbacks(HidKeyboard& keyboard) : mKeyboard(keyboard) {}
+
+#if HID_KEYBOARD_HAS_CONN_INFO
+    void onSubscribe(
+        NimBLECharacteristic* characteristic,
+        NimBLEConnInfo&,
+        uint16_t subValue) override {
+        mKeyboard.handleSubscription(characteristic, subValue);
+    }
+#else
+    void onSubscribe(
+        NimBLECharacteristic* characteristic,
+        ble_gap_conn_desc*,
+        uint16_t subValue) override {
+        mKeyboard.handleSubscription(characteristic, subValue);
+    }
+#endif
+
+private:
+    HidKeyboard& mKeyboard;
+};
+
+class HidKeyboardServerCallbacks : public NimBLEServerCallbacks {
+public:
+    explicit HidKeyboardServerCallbacks(HidKeyboard& keyboard) : mKeyboard(keyboard) {}
+
+#if HID_KEYBOARD_HAS_CONN_INFO
+    void onConnect(NimBLEServer*, NimBLEConnInfo& connInfo) override {
+        mKeyboard.handleConnParamsUpdate(
+            connInfo.getConnInterval(),
+            connInfo.getConnLatency(),
+            connInfo.getConnTimeout());
+        mKeyboard.afterConnect(connInfo.getConnHandle());
+    }
+
+    void onDisconnect(NimBLEServer*, NimBLEConnInfo&, int) override {
+        mKeyboard.afterDisconnect();
+    }
+
+    void onAuthenticationComplete(NimBLEConnInfo& connInfo) override {
+        if (connInfo.isEncrypted()) {
+            mKeyboard.afterAuthentication();
+        }
+    }
+
+    void onConnParamsUpdate(NimBLEConnInfo& connInfo) override {
+        mKeyboard.handleConnParamsUpdate(
+            connInfo.getConnInterval(),
+            connInfo.getConnLatency(),
+            connInfo.getConnTimeout());
+    }
+#else
+    void onConnect(NimBLEServer*) override {
+        mKeyboard.afterConnect(BLE_HS_CONN_HANDLE_NONE);
+        mKeyboard.afterAuthentication();
+    }
+
+    void onDisconnect(NimBLEServer*) override {
+        mKeyboard.afterDisconnect();
+    }
+#endif
+
+private:
+    HidKeyboard& mKeyboard;
+};
+
+namespace {
+
+    // Low-Latency-Profil für Tipp-Bursts: 7,5 .. 11,25 ms, keine Latency, 2 s Timeout.
+    constexpr HidConnParams kConnParamsLowLatency = { 6, 9, 0, 200 };
+
+    // Stromsparprofil bei Inaktivität: 30 .. 50 ms, 4 Intervalle Latency, 4 s Timeout.
+    constexpr HidConnParams kConnParamsIdle = { 24, 40, 4, 400 };
+
+    // Nach dieser Tipp-Pause wird ins Stromsparprofil gewechselt.
+    constexpr unsigned long kIdleTimeoutMs = 2000;
+
+    // Antwortet der Host nicht auf eine Anforderung, gilt sie nach dieser Zeit als abgelehnt.
+    constexpr unsigned long kConnProfilePendingMs = 5000;
+
+    // Ein abgelehntes Profil wird frühestens nach dieser Zeit erneut angefordert.
+    constexpr unsigned long kConnProfileRetryMs = 10000;
+
+    // So lange wird ein Report wiederholt, den der Stack mangels Puffern nicht annimmt.
+    constexpr unsigned long kNotifyRetryMs = 200;
+
+    const HidConnParams& connParams(HidConnProfile profile) {
+        return (profile == HidConnProfile::LowLatency) ? kConnParamsLowLatency : kConnParamsIdle;
+    }
+
+    [[maybe_unused]] const char* connProfileName(HidConnProfile profile) {
+        switch (profile) {
+        case HidConnProfile::LowLatency: return "LowLatency";
+        case HidConnProfile::Idle:       return "Idle";
+        default:                         return "None";
+        }
+    }
+}  // namespace
+
+HidKeyboard::HidKeyboard()
+    : mInputReport(nullptr)
+    , mBootIn(nullptr)
+    , mAdv(nullptr)
+    , mConnected(false)
+    , mProtocolMode(0x00)
+    , mSubBootIn(false)
+    , mSubReport(false)
+    , mReportCount(0)
+    , mConnHandle(BLE_HS_CONN_HANDLE_NONE)
+    , mConnProfile(HidConnProfile::None)
+    , mPendingProfile(HidConnProfile::None)
+    , mRejectedProfile(HidConnProfile::None)
+    , mConnProfileRequestMs(0)
+    , mConnProfileLocked(false)
+    , mKeyDelays(true)
+    , mLastActivityMs(0)
+    , mConnInterval(0)
+    , mConnLatency(0)
+    , mConnTimeout(0)
+    , mProtoCb(std::make_unique<HidKeyboardProtocolModeCallbacks>(*this))
+    , mSubCb(std::make_unique<HidKeyboardInputSubscribeCallbacks>(*this))
+    , mServerCb(std::make_unique<HidKeyboardServerCallbacks>(*this)) {
+}
+
+HidKeyboard::~HidKeyboard() = default;
+
+void HidKeyboard::begin() {
+    NimBLEDevice::init("ESP32 DE Keyboard");
+    NimBLEDevice::setSecurityIOCap(BLE_HS_IO_NO_INPUT_OUTPUT);
+    NimBLEDevice::setSecurityAuth(true, false, true);
+    NimBLEDevice::setPower(ESP_PWR_LVL_P9);
+
+    NimBLEServer* server = NimBLEDevice::createServer();
+    server->setCallbacks(mServerCb.get());
+
+    NimBLEService* hid = server->createService((uint16_t)UUID_HID_SERVICE);
+
+    NimBLECharacteristic* chProtocol = hid->createCharacteristic(
+        (uint16_t)UUID_PROTOCOL_MODE,
+        NIMBLE_PROPERTY::READ | NIMBLE_PROPERTY::WRITE_NR
+    );
+    chProtocol->setCallbacks(mProtoCb.get());
+    chProtocol->setValue(&mProtocolMode, 1);
+
+    NimBLECharacteristic* chHidInfo = hid->createCharacteristic(
+        (uint16_t)UUID_HID_INFORMATION,
+        NIMBLE_PROPERTY::READ
+    );
+    uint8_t hidInfo[4] = { 0x11, 0x01, 0x00, 0x02 };
+    chHidInfo->setValue(hidInfo, sizeof(hidInfo));
+
+    NimBLECharacteristic* chCtrlPt = hid->createCharacteristic(
+        (uint16_t)UUID_HID_CONTROL_POINT,
+        NIMBLE_PROPERTY::WRITE_NR
+    );
+    uint8_t ctl = 0x00;
+    chCtrlPt->setValue(&ctl, 1);
+
+    NimBLECharacteristic* chReportMap = hid->createCharacteristic(
+        (uint16_t)UUID_REPORT_MAP,
+        NIMBLE_PROPERTY::READ
+    );
+#if HID_KEYBOARD_NKRO
+    chReportMap->setValue((uint8_t*)KEYBOARD_REPORTMAP_NKRO, sizeof(KEYBOARD_REPORTMAP_NKRO));
+#else
+    chReportMap->setValue((uint8_t*)KEYBOARD_REPORTMAP, sizeof(KEYBOARD_REPORTMAP));
+#endif
+
+    mInputReport = hid->createCharacteristic(
+        (uint16_t)UUID_REPORT,
+        NIMBLE_PROPERTY::READ | NIMBLE_PROPERTY::NOTIFY
+    );
+    {
+        NimBLEDescriptor* repRef = mInputReport->createDescriptor(
+            (uint16_t)UUID_RPT_REF_DESC, NIMBLE_PROPERTY::READ, 2
+        );
+        uint8_t repRefVal[2] = { 0x01, 0x01 };
+        repRef->setValue(repRefVal, sizeof(repRefVal));
+    }
+    mInputReport->setCallbacks(mSubCb.get());
+
+    mBootIn = hid->createCharacteristic(
+        (uint16_t)UUID_BOOT_KB_INPUT,
+        NIMBLE_PROPERTY::READ | NIMBLE_PROPERTY::NOTIFY
+    );
+    mBootIn->setCallbacks(mSubCb.get());
+
+    hid->createCharacteristic(
+        (uint16_t)UUID_BOOT_KB_OUTPUT,
+        NIMBLE_PROPERTY::READ | NIMBLE_PROPERTY::WRITE | NIMBLE_PROPERTY::WRITE_NR
+    );
+
+    hid->start();
+
+    NimBLEService* dis = server->createService((uint16_t)0x180A);
+    NimBLECharacteristic* cMan = dis->createCharacteristic((uint16_t)0x2A29, NIMBLE_PROPERTY::READ);
+    cMan->setValue("TestCo");
+    dis->start();
+
+    mAdv = NimBLEDevice::getAdvertising();
+    mAdv->addServiceUUID((uint16_t)UUID_HID_SERVICE);
+    mAdv->setAppearance(961);
+    mAdv->start();
+
+    HID_LOGI("BLE", "Advertising als HID Keyboard. Bei Service-Änderungen Bond löschen & neu koppeln.");
+    HID_LOGI("BLE", "Im seriellen Monitor tippen; Enter = Zeilenumbruch. (UTF-8)");
+}
+
+bool HidKeyboard::isConnected() const {
+    return mConnected;
+}
+
+void HidKeyboard::typeCodepoint(uint32_t cp) {
+    uint8_t mods;
+    uint8_t key;
+    if (!cpToHid_DE(cp, mods, key)) {
+        if (cp <= 0x7F) {
+            HID_LOGW("HID", "Unmapped ASCII: 0x%02X '%c'", (unsigned)cp, (char)cp);
+        } else {
+            HID_LOGW("HID", "Unmapped U+%04lX", (unsigned long)cp);
+        }
+        return;
+    }
+    noteActivity();
+    pressAndRelease(mods, key);
+}
+
+size_t HidKeyboard::typeCodepoints(const uint32_t* cps, size_t count) {
+    uint8_t keys[KEYBOARD_NKRO_MAX_USAGE + 1];
+    size_t keyCount = 0;
+    uint8_t chunkMods = 0;
+    size_t reports = 0;
+    const size_t maxKeys = maxKeysPerReport();
+
+    noteActivity();
+    for (size_t i = 0; i < count; ++i) {
+        uint8_t mods;
+        uint8_t key;
+        if (!cpToHid_DE(cps[i], mods, key)) {
+            HID_LOGW("HID", "Unmapped U+%04lX", (unsigned long)cps[i]);
+            continue;
+        }
+        if (keyCount > 0 && (mods != chunkMods || keyCount >= maxKeys || !canPackKey(keys, keyCount, key))) {
+            pressAndRelease(chunkMods, keys, keyCount);
+            ++reports;
+            keyCount = 0;
+        }
+        chunkMods = mods;
+        keys[keyCount++] = key;
+    }
+    if (keyCount > 0) {
+        pressAndRelease(chunkMods, keys, keyCount);
+        ++reports;
+    }
+    return reports;
+}
+
+void HidKeyboard::sendBootReport(const uint8_t* report) {
+    size_t count = 0;
+    while (count < KEYBOARD_BOOT_KEY_SLOTS && report[2 + count] != 0) {
+        ++count;
+    }
+    noteActivity();
+
+    // Wie typeCodepoints: im NKRO-Bitmap liest der Host die Tasten in Usage-Reihenfolge, daher
+    // wird der Report in Läufe zerlegt, die canPackKey erfüllen. Der letzte Lauf bleibt gedrückt.
+    const uint8_t* keys = report + 2;
+    size_t start = 0;
+    for (size_t i = 1; i < count; ++i) {
+        if (!canPackKey(keys + start, i - start, keys[i])) {
+            sendKeys(report[0], keys + start, i - start);
+            start = i;
+        }
+    }
+    sendKeys(report[0], keys + start, count - start);
+}
+
+uint32_t HidKeyboard::getReportCount() const {
+    return mReportCount;
+}
+
+void HidKeyboard::update() {
+    if (!mConnected) {
+        return;
+    }
+    if (mPendingProfile != HidConnProfile::None && millis() - mConnProfileRequestMs >= kConnProfilePendingMs) {
+        HID_LOGW("BLE", "Verbindungsprofil %s unbeantwortet", connProfileName(mPendingProfile));
+        mRejectedProfile = mPendingProfile;
+        mPendingProfile = HidConnProfile::None;
+    }
+    if (mConnProfileLocked || mConnProfile != HidConnProfile::LowLatency) {
+        return;
+    }
+    if (millis() - mLastActivityMs >= kIdleTimeoutMs) {
+        requestConnProfile(HidConnProfile::Idle);
+    }
+}
+
+void HidKeyboard::requestConnProfile(HidConnProfile profile, bool locked) {
+    mConnProfileLocked = locked;
+    if (profile == HidConnProfile::None || profile == mConnProfile || profile == mPendingProfile) {
+        return;
+    }
+    if (!mConnected || mConnHandle == BLE_HS_CONN_HANDLE_NONE) {
+        return;
+    }
+    if (!locked && profile == mRejectedProfile && millis() - mConnProfileRequestMs < kConnProfileRetryMs) {
+        return;
+    }
+
+    const HidConnParams& params = connParams(profile);
+    ble_gap_upd_params upd = {};
+    upd.itvl_min = params.minInterval;
+    upd.itvl_max = params.maxInterval;
+    upd.latency = params.latency;
+    upd.supervision_timeout = params.timeout;
+    upd.min_ce_len = BLE_GAP_INITIAL_CONN_MIN_CE_LEN;
+    upd.max_ce_len = BLE_GAP_INITIAL_CONN_MAX_CE_LEN;
+
+    mConnProfileRequestMs = millis();
+    const int rc = ble_gap_update_params(mConnHandle, &upd);
+    if (rc != 0) {
+        mRejectedProfile = profile;
+        HID_LOGW("BLE", "Verbindungsprofil %s nicht angefordert, rc=%d", connProfileName(profile), rc);
+        return;
+    }
+    mPendingProfile = profile;
+    HID_LOGI("BLE", "Verbindungsprofil %s angefordert", connProfileName(profile));
+}
+
+HidConnProfile HidKeyboard::getConnProfile() const {
+    return mConnProfile;
+}
+
+void HidKeyboard::setKeyDelays(bool enabled) {
+    mKeyDelays = enabled;
+}
+
+uint16_t HidKeyboard::getConnInterval() const {
+    return mConnInterval;
+}
+
+uint16_t HidKeyboard::getConnLatency() const {
+    return mConnLatency;
+}
+
+uint16_t HidKeyboard::getSupervisionTimeout() const {
+    return mConnTimeout;
+}
+
+void HidKeyboard::handleProtocolModeWrite(NimBLECharacteristic* characteristic) {
+    std::string value = characteristic->getValue();
+    if (value.size() == 1 && (value[0] == 0x00 || value[0] == 0x01)) {
+        mProtocolMode = static_cast<uint8_t>(value[0]);
+        HID_LOGI("HID", "Host set ProtocolMode = %s", mProtocolMode ? "Report(1)" : "Boot(0)");
+    }
+}
+
+void HidKeyboard::handleSubscription(NimBLECharacteristic* characteristic, uint16_t subValue) {
+    const bool notifyEnabled = (subValue & 0x0001);
+    if (characteristic == mBootIn) {
+        mSubBootIn = notifyEnabled;
+        HID_LOGI("HID", "BootInput subscribe = %d", static_cast<int>(mSubBootIn));
+    } else if (characteristic == mInputReport) {
+        mSubReport = notifyEnabled;
+        HID_LOGI("HID", "ReportInput subscribe = %d", static_cast<int>(mSubReport));
+    }
+}
+
+void HidKeyboard::afterConnect(uint16_t connHandle) {
+    if (connHandle == BLE_HS_CONN_HANDLE_NONE) {
+        std::vector<uint16_t> peers = NimBLEDevice::getServer()->getPeerDevices();
+        if (!peers.empty()) {
+            connHandle = peers.front();
+        }
+    }
+    mConnHandle = connHandle;
+    mConnProfile = HidConnProfile::None;
+    mPendingProfile = HidConnProfile::None;
+    mRejectedProfile = HidConnProfile::None;
+    mLastActivityMs = millis();
+    mConnected = true;
+    HID_LOGI("BLE", "Verbunden");
+    unsigned long t0 = millis();
+    while (millis() - t0 < 800) {
+        delay(1);
+    }
+
+    pressAndRelease(KEYBOARD_MODIFIER_LEFTSHIFT, HID_KEY_A);
+    pressAndRelease(0, HID_KEY_ENTER);
+
+    HID_LOGI("HID", "ProtocolMode on connect (may change) = %s", mProtocolMode ? "Report(1)" : "Boot(0)");
+}
+
+void HidKeyboard::afterAuthentication() {
+    mLastActivityMs = millis();
+    requestConnProfile(HidConnProfile::LowLatency, mConnProfileLocked);
+}
+
+void HidKeyboard::handleConnParamsUpdate(uint16_t interval, uint16_t latency, uint16_t timeout) {
+    mConnInterval = interval;
+    mConnLatency = latency;
+    mConnTimeout = timeout;
+    HID_LOGI("BLE", "Verbindungsparameter: Intervall=%u.%02u ms Latency=%u Timeout=%u ms",
+        (unsigned)(interval * 125 / 100),
+        (unsigned)(interval * 125 % 100),
+        (unsigned)latency,
+        (unsigned)timeout * 10);
+
+    const HidConnProfile pending = mPendingProfile;
+    if (pending == HidConnProfile::None) {
+        return;
+    }
+    mPendingProfile = HidConnProfile::None;
+    const HidConnParams& params = connParams(pending);
+    if (interval >= params.minInterval && interval <= params.maxInterval && latency == params.latency) {
+        mConnProfile = pending;
+        HID_LOGI("BLE", "Verbindungsprofil %s aktiv", connProfileName(pending));
+    } else {
+        mRejectedProfile = pending;
+        mConnProfileRequestMs = millis();
+        HID_LOGW("BLE", "Verbindungsprofil %s vom Host nicht übernommen", connProfileName(pending));
+    }
+}
+
+void HidKeyboard::noteActivity() {
+    mLastActivityMs = millis();
+    if (!mConnProfileLocked && mConnProfile != HidConnProfile::LowLatency) {
+        requestConnProfile(HidConnProfile::LowLatency);
+    }
+}
+
+void HidKeyboard::afterDisconnect() {
+    mConnected = false;
+    mSubBootIn = false;
+    mSubReport = false;
+    mConnHandle = BLE_HS_CONN_HANDLE_NONE;
+    mConnProfile = HidConnProfile::None;
+    mPendingProfile = HidConnProfile::None;
+    mConnInterval = 0;
+    mConnLatency = 0;
+    mConnTimeout = 0;
+    HID_LOGI("BLE", "Getrennt. Advertising neu...");
+    NimBLEDevice::startAdvertising();
+}
+
+NimBLECharacteristic* HidKeyboard::selectInputCharacteristic() const {
+    const bool reportMode = (mProtocolMode == 0x01);
+    if (reportMode ? mSubReport : mSubBootIn) {
+        return reportMode ? mInputReport : mBootIn;
+    }
+    if (mSubReport) {
+        return mInputReport;
+    }
+    if (mSubBootIn) {
+        return mBootIn;
+    }
+    return reportMode ? mInputReport : mBootIn;
+}
+
+void HidKeyboard::sendReportRaw(
+    NimBLECharacteristic* characteristic,
+    const char* tag,
+    const uint8_t* report,
+    size_t length) {
+    if (!characteristic) {
+        return;
+    }
+    characteristic->setValue(report, length);
+    if (mConnHandle == BLE_HS_CONN_HANDLE_NONE) {
+        characteristic->notify();
+        ++mReportCount;
+        return;
+    }
+
+    // An die Verbindung adressiert, damit ein Fehler des Stacks zurückkommt. Fehlen ihm Puffer,
+    // wird gewartet, bis die Verbindung Reports abgegeben hat und er den Report annimmt.
+    bool ok = characteristic->notify(report, length, mConnHandle);
+    const unsigned long t0 = millis();
+    while (!ok && mConnected && millis() - t0 < kNotifyRetryMs) {
+        delay(1);
+        ok = characteristic->notify(report, length, mConnHandle);
+    }
+    ++mReportCount;
+    HID_LOGT(tag, "send notify=%u len=%u mods=%02X keys=%08X",
+        static_cast<uint32_t>(ok),
+        static_cast<uint32_t>(length),
+        report[0],
+        (uint32_t)report[2] << 24 | (uint32_t)report[3] << 16 | (uint32_t)report[4] << 8 | report[5]);
+    (void)ok;
+}
+
+void HidKeyboard::sendKeys(uint8_t mods, const uint8_t* keys, size_t count) {
+    if (!mConnected) {
+        return;
+    }
+
+    NimBLECharacteristic* characteristic = selectInputCharacteristic();
+#if HID_KEYBOARD_NKRO
+    if (characteristic == mInputReport) {
+        uint8_t rpt[KEYBOARD_NKRO_REPORT_LEN] = { mods };
+        for (size_t i = 0; i < count; ++i) {
+            if (keys[i] <= KEYBOARD_NKRO_MAX_USAGE) {
+                rpt[1 + (keys[i] >> 3)] |= static_cast<uint8_t>(1u << (keys[i] & 0x07));
+            }
+        }
+        sendReportRaw(characteristic, "Report", rpt, sizeof(rpt));
+        return;
+    }
+#endif
+
+    uint8_t rpt[KEYBOARD_BOOT_REPORT_LEN] = { mods, 0x00 };
+    for (size_t i = 0; i < count && i < KEYBOARD_BOOT_KEY_SLOTS; ++i) {
+        rpt[2 + i] = keys[i];
+    }
+    sendReportRaw(characteristic, characteristic == mBootIn ? "Boot" : "Report", rpt, sizeof(rpt));
+}
+
+size_t HidKeyboard::maxKeysPerReport() const {
+#if HID_KEYBOARD_NKRO
+    if (selectInputCharacteristic() == mInputReport) {
+        return KEYBOARD_NKRO_MAX_USAGE + 1;
+    }
+#endif
+    return KEYBOARD_BOOT_KEY_SLOTS;
+}
+
+bool HidKeyboard::canPackKey(const uint8_t* keys, size_t count, uint8_t key) const {
+#if HID_KEYBOARD_NKRO
+    if (selectInputCharacteristic() == mInputReport) {
+        return key > keys[count - 1];
+    }
+#endif
+    for (size_t i = 0; i < count; ++i) {
+        if (keys[i] == key) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void HidKeyboard::pressAndRelease(uint8_t mods, uint8_t key) {
+    pressAndRelease(mods, &key, 1);
+}
+
+void HidKeyboard::pressAndRelease(uint8_t mods, const uint8_t* keys, size_t count) {
+    sendKeys(mods, keys, count);
+    if (mKeyDelays) {
+        delay(8);
+    }
+    sendKeys(0, nullptr, 0);
+    if (mKeyDelays) {
+        delay(5);
+    }
+}
+
+bool HidKeyboard::cpToHid_DE(uint32_t cp, uint8_t& mods, uint8_t& key) {
+    return hidMapDE(cp, mods, key);
+}
+
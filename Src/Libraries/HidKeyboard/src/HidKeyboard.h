@@ -0,0 +1,245 @@
+#pragma once
+
+#include <NimBLEDevice.h>
+#include <stdint.h>
+#include <memory>
+
+class HidKeyboardProtocolModeCallbacks;
+class HidKeyboardInputSubscribeCallbacks;
+class HidKeyboardServerCallbacks;
+
+/**
+ * @brief Verbindungsparameter einer BLE-Verbindung in den Einheiten des Link Layers.
+ */
+struct HidConnParams {
+	uint16_t minInterval; ///< Minimales Verbindungsintervall (1,25 ms Einheiten).
+	uint16_t maxInterval; ///< Maximales Verbindungsintervall (1,25 ms Einheiten).
+	uint16_t latency;     ///< Slave Latency (Anzahl übersprungener Intervalle).
+	uint16_t timeout;     ///< Supervision Timeout (10 ms Einheiten).
+};
+
+/**
+ * @brief Vom Gerät angeforderte Verbindungsprofile.
+ */
+enum class HidConnProfile : uint8_t {
+	None,       ///< Noch kein Profil angefordert (Parameter des Hosts).
+	LowLatency, ///< 7,5 ms Intervall für Tipp-Bursts.
+	Idle        ///< Entspanntes, stromsparendes Profil bei Inaktivität.
+};
+
+/**
+ * @brief Verwaltet alle BLE-HID-Funktionen für das virtuelle Keyboard.
+ */
+class HidKeyboard {
+public:
+	/**
+	 * @brief Konstruktor initialisiert alle Pointer und Statusvariablen.
+	 */
+	HidKeyboard();
+
+	/**
+	 * @brief Destruktor sorgt für die Freigabe der Callback-Objekte.
+	 */
+	~HidKeyboard();
+
+	/**
+	 * @brief Initialisiert NimBLE, richtet den HID-Service ein und startet Advertising.
+	 */
+	void begin();
+
+	/**
+	 * @brief Gibt zurück, ob aktuell ein zentraler BLE-Client verbunden ist.
+	 */
+	bool isConnected() const;
+
+	/**
+	 * @brief Konvertiert einen Unicode-Codepoint und sendet ihn als Tastendruck.
+	 *
+	 * Für nicht unterstützte Zeichen werden Diagnosemeldungen im Seriellen Monitor ausgegeben.
+	 */
+	void typeCodepoint(uint32_t cp);
+
+	/**
+	 * @brief Tippt mehrere Codepoints und packt dabei möglichst viele Tasten in einen Report.
+	 *
+	 * Aufeinanderfolgende Zeichen mit gleichen Modifiern und unterschiedlichen Tasten werden
+	 * gemeinsam gedrückt (6KRO: bis zu sechs, NKRO: ganze Wörter mit aufsteigenden Usages).
+	 *
+	 * @return Anzahl der gesendeten Tastendruck-Reports (ohne Releases).
+	 */
+	size_t typeCodepoints(const uint32_t* cps, size_t count);
+
+	/**
+	 * @brief Sendet einen vorkompilierten 8-Byte-Boot-Report (Modifier, Reserved, sechs Keycodes).
+	 *
+	 * Keine Zeichenkonvertierung, der Report geht direkt auf die aktive Input-Charakteristik.
+	 * Im NKRO-Modus werden die Keycodes in aufsteigende Läufe zerlegt und nacheinander gesendet,
+	 * damit der Host sie in Slot-Reihenfolge tippt.
+	 */
+	void sendBootReport(const uint8_t* report);
+
+	/**
+	 * @brief Anzahl der seit dem Start gesendeten Input-Reports (inkl. Releases).
+	 */
+	uint32_t getReportCount() const;
+
+	/**
+	 * @brief Muss zyklisch aus loop() aufgerufen werden.
+	 *
+	 * Wechselt nach einer Tipp-Pause ins stromsparende Verbindungsprofil.
+	 */
+	void update();
+
+	/**
+	 * @brief Fordert ein Verbindungsprofil beim Host an.
+	 *
+	 * Das Profil gilt erst als aktiv, wenn der Host Parameter im angeforderten Bereich meldet.
+	 * Ist @p locked gesetzt, wird das Profil nicht mehr automatisch gewechselt
+	 * (z. B. für Messungen). Mit locked = false kehrt die Automatik zurück.
+	 */
+	void requestConnProfile(HidConnProfile profile, bool locked = false);
+
+	/**
+	 * @brief Liefert das aktive, vom Host bestätigte Verbindungsprofil.
+	 */
+	HidConnProfile getConnProfile() const;
+
+	/**
+	 * @brief Schaltet die festen Pausen zwischen Tastendruck und Release ein oder aus.
+	 *
+	 * Standardmäßig an, da manche Hosts Reports verlieren, die im selben Verbindungsereignis
+	 * eintreffen. Ohne Pausen bestimmt allein die Verbindung das Tipptempo: Ein Report, den der
+	 * Stack mangels Puffern nicht annimmt, wird wiederholt, bis er angenommen wird.
+	 */
+	void setKeyDelays(bool enabled);
+
+	/**
+	 * @brief Liefert das tatsächlich ausgehandelte Verbindungsintervall (1,25 ms Einheiten).
+	 */
+	uint16_t getConnInterval() const;
+
+	/**
+	 * @brief Liefert die tatsächlich ausgehandelte Slave Latency.
+	 */
+	uint16_t getConnLatency() const;
+
+	/**
+	 * @brief Liefert den tatsächlich ausgehandelten Supervision Timeout (10 ms Einheiten).
+	 */
+	uint16_t getSupervisionTimeout() const;
+
+private:
+	friend class HidKeyboardProtocolModeCallbacks;
+	friend class HidKeyboardInputSubscribeCallbacks;
+	friend class HidKeyboardServerCallbacks;
+
+	/**
+	 * @brief Verarbeitet Schreibzugriffe auf die Protocol-Mode-Charakteristik.
+	 */
+	void handleProtocolModeWrite(NimBLECharacteristic* characteristic);
+
+	/**
+	 * @brief Aktualisiert den Subskriptionsstatus für Boot- und Report-Input.
+	 */
+	void handleSubscription(NimBLECharacteristic* characteristic, uint16_t subValue);
+
+	/**
+	 * @brief Bereitet das Gerät nach erfolgreichem Verbindungsaufbau vor.
+	 */
+	void afterConnect(uint16_t connHandle);
+
+	/**
+	 * @brief Fordert nach abgeschlossenem Pairing das Low-Latency-Profil an.
+	 */
+	void afterAuthentication();
+
+	/**
+	 * @brief Übernimmt die vom Host ausgehandelten Verbindungsparameter.
+	 *
+	 * Ein angefordertes Profil wird nur aktiv, wenn Intervall und Latency dazu passen.
+	 */
+	void handleConnParamsUpdate(uint16_t interval, uint16_t latency, uint16_t timeout);
+
+	/**
+	 * @brief Merkt Tipp-Aktivität und schaltet bei Bedarf auf das Low-Latency-Profil.
+	 */
+	void noteActivity();
+
+	/**
+	 * @brief Setzt den Status nach einem Verbindungsabbruch zurück und startet Advertising.
+	 */
+	void afterDisconnect();
+
+	/**
+	 * @brief Liefert die Input-Charakteristik, auf der Reports gesendet werden.
+	 *
+	 * Es wird immer genau eine Charakteristik gewählt: die zum Protocol Mode passende,
+	 * falls sie abonniert ist, sonst die abonnierte, sonst die zum Protocol Mode passende.
+	 */
+	NimBLECharacteristic* selectInputCharacteristic() const;
+
+	/**
+	 * @brief Sendet einen Rohreport an die angegebene Charakteristik.
+	 */
+	void sendReportRaw(NimBLECharacteristic* characteristic, const char* tag, const uint8_t* report, size_t length);
+
+	/**
+	 * @brief Sendet einen Report mit bis zu maxKeysPerReport() gleichzeitig gedrückten Tasten.
+	 *
+	 * Für die Boot-Charakteristik wird ein 8-Byte-Boot-Report gebaut, für die Report-Charakteristik
+	 * abhängig von HID_KEYBOARD_NKRO ein Boot-kompatibler oder ein NKRO-Bitmap-Report.
+	 */
+	void sendKeys(uint8_t mods, const uint8_t* keys, size_t count);
+
+	/**
+	 * @brief Maximale Anzahl Tasten pro Report auf der aktuell gewählten Charakteristik.
+	 */
+	size_t maxKeysPerReport() const;
+
+	/**
+	 * @brief Prüft, ob @p key an die bisher gesammelten Tasten eines Reports angehängt werden darf.
+	 *
+	 * Der Host wertet Array-Reports in Array-Reihenfolge und Bitmap-Reports in Usage-Reihenfolge
+	 * aus. Damit die Tipp-Reihenfolge erhalten bleibt, müssen Tasten im Bitmap aufsteigen.
+	 */
+	bool canPackKey(const uint8_t* keys, size_t count, uint8_t key) const;
+
+	/**
+	 * @brief Sendet einen Tastendruck mit anschließendem Release.
+	 */
+	void pressAndRelease(uint8_t mods, uint8_t key);
+
+	/**
+	 * @brief Sendet mehrere Tasten in einem Report mit anschließendem Release.
+	 */
+	void pressAndRelease(uint8_t mods, const uint8_t* keys, size_t count);
+
+	/**
+	 * @brief Wandelt einen Codepoint ins deutsche HID-Layout um.
+	 */
+	bool cpToHid_DE(uint32_t cp, uint8_t& mods, uint8_t& key);
+
+	NimBLECharacteristic* mInputReport;
+	NimBLECharacteristic* mBootIn;
+	NimBLEAdvertising* mAdv;
+	volatile bool mConnected;
+	uint8_t mProtocolMode;
+	volatile bool mSubBootIn;
+	volatile bool mSubReport;
+	uint32_t mReportCount;
+	uint16_t mConnHandle;
+	volatile HidConnProfile mConnProfile;
+	volatile HidConnProfile mPendingProfile;
+	HidConnProfile mRejectedProfile;
+	volatile unsigned long mConnProfileRequestMs;
+	bool mConnProfileLocked;
+	bool mKeyDelays;
+	unsigned long mLastActivityMs;
+	volatile uint16_t mConnInterval;
+	volatile uint16_t mConnLatency;
+	volatile uint16_t mConnTimeout;
+	std::unique_ptr<HidKeyboardProtocolModeCallbacks> mProtoCb;
+	std::unique_ptr<HidKeyboardInputSubscribeCallbacks> mSubCb;
+	std::unique_ptr<HidKeyboardServerCallbacks> mServerCb;
+};
+
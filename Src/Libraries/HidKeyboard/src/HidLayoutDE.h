@@ -0,0 +1,84 @@
+/**
+ * @file HidLayoutDE.h
+ * @brief Zuordnung von Unicode-Codepoints zum deutschen Tastaturlayout (HID-Usages + Modifier).
+ *
+ * Die Funktion ist constexpr, damit Makrotexte bereits zur Compile-Zeit in HID-Reports
+ * übersetzt werden können (siehe CardMacro.h). Zur Laufzeit nutzt HidKeyboard dieselbe Tabelle.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "HidConsts.h"
+
+/**
+ * @brief Wandelt einen Codepoint ins deutsche HID-Layout um.
+ *
+ * @return false, wenn das Zeichen im Layout nicht abgebildet ist.
+ */
+constexpr bool hidMapDE(uint32_t cp, uint8_t& mods, uint8_t& key) {
+	mods = 0;
+	if (cp == '\n' || cp == '\r') { key = HID_KEY_ENTER; return true; }
+	if (cp == '\t') { key = HID_KEY_TAB; return true; }
+	if (cp == ' ') { key = HID_KEY_SPACEBAR; return true; }
+
+	if (cp >= '1' && cp <= '9') { key = static_cast<uint8_t>(HID_KEY_1 + (cp - '1')); return true; }
+	if (cp == '0') { key = HID_KEY_0; return true; }
+
+	if (cp >= 'a' && cp <= 'z') {
+		if (cp == 'z') { key = HID_KEY_Y; return true; }
+		if (cp == 'y') { key = HID_KEY_Z; return true; }
+		key = static_cast<uint8_t>(HID_KEY_A + (cp - 'a'));
+		return true;
+	}
+	if (cp >= 'A' && cp <= 'Z') {
+		if (cp == 'Z') { key = HID_KEY_Y; mods = KEYBOARD_MODIFIER_LEFTSHIFT; return true; }
+		if (cp == 'Y') { key = HID_KEY_Z; mods = KEYBOARD_MODIFIER_LEFTSHIFT; return true; }
+		key = static_cast<uint8_t>(HID_KEY_A + (cp - 'A'));
+		mods = KEYBOARD_MODIFIER_LEFTSHIFT;
+		return true;
+	}
+
+	switch (cp) {
+	case 0x00E4: key = HID_KEY_APOSTROPHE; return true;
+	case 0x00C4: key = HID_KEY_APOSTROPHE; mods = KEYBOARD_MODIFIER_LEFTSHIFT; return true;
+	case 0x00F6: key = HID_KEY_SEMICOLON;  return true;
+	case 0x00D6: key = HID_KEY_SEMICOLON;  mods = KEYBOARD_MODIFIER_LEFTSHIFT; return true;
+	case 0x00FC: key = HID_KEY_LEFT_BRACKET; return true;
+	case 0x00DC: key = HID_KEY_LEFT_BRACKET; mods = KEYBOARD_MODIFIER_LEFTSHIFT; return true;
+	case 0x00DF: key = HID_KEY_MINUS; return true;
+	case 0x20AC: mods = KEYBOARD_MODIFIER_RIGHTALT; key = HID_KEY_E; return true;
+	}
+
+	switch (cp) {
+	case '.': key = HID_KEY_PERIOD; return true;
+	case ',': key = HID_KEY_COMMA; return true;
+	case '-': key = HID_KEY_SLASH; return true;
+	case '_': key = HID_KEY_SLASH; mods = KEYBOARD_MODIFIER_LEFTSHIFT; return true;
+	case '+': key = HID_KEY_RIGHT_BRACKET; return true;
+	case '*': key = HID_KEY_RIGHT_BRACKET; mods = KEYBOARD_MODIFIER_LEFTSHIFT; return true;
+	case ':': key = HID_KEY_PERIOD; mods = KEYBOARD_MODIFIER_LEFTSHIFT; return true;
+	case ';': key = HID_KEY_COMMA;  mods = KEYBOARD_MODIFIER_LEFTSHIFT; return true;
+	case '!': key = HID_KEY_1; mods = KEYBOARD_MODIFIER_LEFTSHIFT; return true;
+	case '?': key = HID_KEY_MINUS; mods = KEYBOARD_MODIFIER_LEFTSHIFT; return true;
+	case '=': key = HID_KEY_EQUAL; return true;
+
+	case '/':  key = HID_KEY_7;  mods = KEYBOARD_MODIFIER_RIGHTALT; return true;
+	case '\\': key = HID_KEY_MINUS; mods = KEYBOARD_MODIFIER_RIGHTALT; return true;
+	case '#':  key = HID_KEY_BACKSLASH; return true;
+	case '"':  key = HID_KEY_2; mods = KEYBOARD_MODIFIER_LEFTSHIFT; return true;
+	case '\'': key = HID_KEY_BACKSLASH; mods = KEYBOARD_MODIFIER_RIGHTALT; return true;
+
+	case '(': key = HID_KEY_8; mods = KEYBOARD_MODIFIER_LEFTSHIFT; return true;
+	case ')': key = HID_KEY_9; mods = KEYBOARD_MODIFIER_LEFTSHIFT; return true;
+	case '[': key = HID_KEY_8; mods = KEYBOARD_MODIFIER_RIGHTALT; return true;
+	case ']': key = HID_KEY_9; mods = KEYBOARD_MODIFIER_RIGHTALT; return true;
+	case '{': key = HID_KEY_7; mods = KEYBOARD_MODIFIER_RIGHTALT; return true;
+	case '}': key = HID_KEY_0; mods = KEYBOARD_MODIFIER_RIGHTALT; return true;
+	case '<': key = HID_KEY_NON_US_BACKSLASH; return true;
+	case '>': key = HID_KEY_NON_US_BACKSLASH; mods = KEYBOARD_MODIFIER_LEFTSHIFT; return true;
+	case '|': key = HID_KEY_NON_US_BACKSLASH; mods = KEYBOARD_MODIFIER_RIGHTALT; return true;
+	}
+	return false;
+}
@@ -0,0 +1,84 @@
+#include "HidLog.h"
+
+#include <Arduino.h>
+#include <stdarg.h>
+
+static_assert((HID_LOG_RING_SIZE & (HID_LOG_RING_SIZE - 1)) == 0, "HID_LOG_RING_SIZE muss eine Zweierpotenz sein");
+
+namespace {
+
+    struct HidLogEntry {
+        uint32_t timeUs;
+        const char* tag;
+        const char* format;
+        uint32_t args[4];
+    };
+
+    HidLogEntry sRing[HID_LOG_RING_SIZE];
+    volatile uint32_t sHead = 0;
+    volatile uint32_t sTail = 0;
+    volatile uint32_t sDropped = 0;
+    uint32_t sDroppedReported = 0;
+    portMUX_TYPE sRingMux = portMUX_INITIALIZER_UNLOCKED;
+
+    constexpr size_t kLineBufferSize = 160;
+}  // namespace
+
+void HidLog::print(char level, const char* tag, const char* format, ...) {
+    char line[kLineBufferSize];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    Serial.printf("%c [%s] %s\n", level, tag, line);
+}
+
+void HidLog::record(const char* tag, const char* format, uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3) {
+    const uint32_t now = micros();
+
+    portENTER_CRITICAL(&sRingMux);
+    const uint32_t head = sHead;
+    if (head - sTail >= HID_LOG_RING_SIZE) {
+        sDropped = sDropped + 1;
+        portEXIT_CRITICAL(&sRingMux);
+        return;
+    }
+    HidLogEntry& entry = sRing[head & (HID_LOG_RING_SIZE - 1)];
+    entry.timeUs = now;
+    entry.tag = tag;
+    entry.format = format;
+    entry.args[0] = a0;
+    entry.args[1] = a1;
+    entry.args[2] = a2;
+    entry.args[3] = a3;
+    sHead = head + 1;
+    portEXIT_CRITICAL(&sRingMux);
+}
+
+size_t HidLog::flush() {
+    size_t count = 0;
+    while (sTail != sHead) {
+        // Kopie ziehen, damit der Producer den Slot sofort wiederverwenden kann.
+        HidLogEntry entry;
+        portENTER_CRITICAL(&sRingMux);
+        entry = sRing[sTail & (HID_LOG_RING_SIZE - 1)];
+        sTail = sTail + 1;
+        portEXIT_CRITICAL(&sRingMux);
+
+        char line[kLineBufferSize];
+        snprintf(line, sizeof(line), entry.format, entry.args[0], entry.args[1], entry.args[2], entry.args[3]);
+        Serial.printf("T (%lu us) [%s] %s\n", (unsigned long)entry.timeUs, entry.tag, line);
+        ++count;
+    }
+
+    const uint32_t dropped = sDropped;
+    if (dropped != sDroppedReported) {
+        Serial.printf("W [LOG] %lu Einträge verworfen (Ringpuffer voll)\n", (unsigned long)(dropped - sDroppedReported));
+        sDroppedReported = dropped;
+    }
+    return count;
+}
+
+uint32_t HidLog::getDropped() {
+    return sDropped;
+}
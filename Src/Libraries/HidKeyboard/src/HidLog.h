@@ -0,0 +1,84 @@
+/**
+ * @file HidLog.h
+ * @brief Logging für das HID-Keyboard mit Compile-Time-Levels und verzögertem Binär-Log.
+ *
+ * Die Makros folgen dem Muster der NIMBLE_LOGx-Makros aus NimBLELog.h: Was unterhalb von
+ * HID_LOG_LEVEL liegt, wird vollständig wegkompiliert (keine Formatierung, keine Argumente).
+ *
+ * Für den Hot Path (Report-Versand) gibt es zusätzlich HID_LOGT: Statt zu formatieren wird
+ * nur Zeitstempel, Format-Pointer und bis zu vier 32-Bit-Argumente in einen Ringpuffer
+ * geschrieben. Formatiert und ausgegeben wird erst in HidLog::flush() aus loop().
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Level: 0 = NONE, 1 = ERROR, 2 = WARNING, 3 = INFO, 4+ = DEBUG (wie CONFIG_NIMBLE_CPP_LOG_LEVEL).
+#ifndef HID_LOG_LEVEL
+#define HID_LOG_LEVEL 3
+#endif
+
+// Anzahl Einträge im Binär-Log (Zweierpotenz).
+#ifndef HID_LOG_RING_SIZE
+#define HID_LOG_RING_SIZE 64
+#endif
+
+/**
+ * @brief Ausgabe und verzögerter Binär-Log für das HID-Keyboard.
+ */
+class HidLog {
+public:
+	/**
+	 * @brief Formatiert eine Logzeile sofort auf die serielle Schnittstelle.
+	 */
+	static void print(char level, const char* tag, const char* format, ...) __attribute__((format(printf, 3, 4)));
+
+	/**
+	 * @brief Legt einen unformatierten Eintrag im Ringpuffer ab.
+	 *
+	 * Die Argumente werden erst in flush() mit @p format ausgegeben, @p format und @p tag
+	 * müssen daher statische Strings sein. Ist der Puffer voll, wird der Eintrag verworfen.
+	 */
+	static void record(const char* tag, const char* format,
+		uint32_t a0 = 0, uint32_t a1 = 0, uint32_t a2 = 0, uint32_t a3 = 0);
+
+	/**
+	 * @brief Formatiert alle gepufferten Einträge. Muss außerhalb des Hot Paths aufgerufen werden.
+	 *
+	 * @return Anzahl der ausgegebenen Einträge.
+	 */
+	static size_t flush();
+
+	/**
+	 * @brief Anzahl der seit dem Start wegen vollem Puffer verworfenen Einträge.
+	 */
+	static uint32_t getDropped();
+};
+
+#if HID_LOG_LEVEL >= 4
+#define HID_LOGD(tag, format, ...) HidLog::print('D', tag, format, ##__VA_ARGS__)
+#define HID_LOGT(tag, format, ...) HidLog::record(tag, format, ##__VA_ARGS__)
+#else
+#define HID_LOGD(tag, format, ...) (void)tag
+#define HID_LOGT(tag, format, ...) (void)tag
+#endif
+
+#if HID_LOG_LEVEL >= 3
+#define HID_LOGI(tag, format, ...) HidLog::print('I', tag, format, ##__VA_ARGS__)
+#else
+#define HID_LOGI(tag, format, ...) (void)tag
+#endif
+
+#if HID_LOG_LEVEL >= 2
+#define HID_LOGW(tag, format, ...) HidLog::print('W', tag, format, ##__VA_ARGS__)
+#else
+#define HID_LOGW(tag, format, ...) (void)tag
+#endif
+
+#if HID_LOG_LEVEL >= 1
+#define HID_LOGE(tag, format, ...) HidLog::print('E', tag, format, ##__VA_ARGS__)
+#else
+#define HID_LOGE(tag, format, ...) (void)tag
+#endif
@@ -0,0 +1,416 @@
+/*
+	macroblob: Erzeugt und prüft den Makro-Blob für die Partition "macros" von Esp32NMCI.
+
+	Bauen (Linux):
+		g++ -std=c++17 -O2 -Wall -I../../Esp32NMCI/src -I../../Libraries/HidKeyboard/src -o macroblob macroblob.cpp ../../Esp32NMCI/src/MacroBlob.cpp
+
+	Verwenden:
+		./macroblob build example.macros macros.bin
+		./macroblob check macros.bin
+		parttool.py --port /dev/ttyUSB0 write_partition --partition-name macros --input macros.bin
+
+	Skriptformat (UTF-8, eine Anweisung pro Zeile, '#' leitet Kommentare ein):
+		card 04:11:22:33:44:55:80   neue Karte, UID als Hex (Trennzeichen ':' oder ' ' optional)
+		type <Text>                 tippt den Rest der Zeile; \n = Enter, \t = Tab, \\ = Backslash
+		line <Text>                 wie type, danach Enter
+		delay <ms>                  Pause 1..65535 ms (Zeitmarker im Blob)
+
+	Format und Prüfung stehen in Esp32NMCI/src/MacroBlob.h und werden mit der Firmware geteilt.
+	Die Zeichen werden wie in compileMacro() (CardMacro.h) über hidMapDE() abgebildet und gepackt.
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "HidLayoutDE.h"
+#include "MacroBlob.h"
+
+namespace
+{
+	constexpr size_t kDefaultPartitionSize = 0x20000;
+
+	struct ScriptEntry
+	{
+		MacroBlobEntry entry{};
+		std::vector<HidReport> records;
+	};
+
+	struct Packer
+	{
+		std::vector<HidReport>& records;
+		uint8_t keys[KEYBOARD_BOOT_KEY_SLOTS]{};
+		size_t keyCount = 0;
+		uint8_t chunkMods = 0;
+
+		void flush()
+		{
+			if (keyCount == 0)
+			{
+				return;
+			}
+			HidReport press{};
+			press.data[0] = chunkMods;
+			for (size_t i = 0; i < keyCount; ++i)
+			{
+				press.data[2 + i] = keys[i];
+			}
+			records.push_back(press);
+			records.push_back(HidReport{});
+			keyCount = 0;
+		}
+
+		void add(uint8_t mods, uint8_t key)
+		{
+			bool duplicate = false;
+			for (size_t i = 0; i < keyCount; ++i)
+			{
+				duplicate = duplicate || keys[i] == key;
+			}
+			if (keyCount > 0 && (mods != chunkMods || keyCount >= KEYBOARD_BOOT_KEY_SLOTS || duplicate))
+			{
+				flush();
+			}
+			chunkMods = mods;
+			keys[keyCount++] = key;
+		}
+	};
+
+	bool fail(const char* file, size_t line, const char* message)
+	{
+		fprintf(stderr, "%s:%zu: %s\n", file, line, message);
+		return false;
+	}
+
+	bool decodeUtf8(const std::string& text, size_t& pos, uint32_t& cp)
+	{
+		const uint8_t lead = static_cast<uint8_t>(text[pos++]);
+		size_t needed = 0;
+		if (lead < 0x80) { cp = lead; return true; }
+		else if ((lead & 0xE0) == 0xC0) { cp = lead & 0x1F; needed = 1; }
+		else if ((lead & 0xF0) == 0xE0) { cp = lead & 0x0F; needed = 2; }
+		else if ((lead & 0xF8) == 0xF0) { cp = lead & 0x07; needed = 3; }
+		else { return false; }
+		while (needed-- > 0)
+		{
+			if (pos >= text.size() || (static_cast<uint8_t>(text[pos]) & 0xC0) != 0x80)
+			{
+				return false;
+			}
+			cp = (cp << 6) | (static_cast<uint8_t>(text[pos++]) & 0x3F);
+		}
+		return true;
+	}
+
+	bool typeText(const char* file, size_t line, const std::string& text, std::vector<HidReport>& records)
+	{
+		Packer packer{ records };
+		size_t pos = 0;
+		while (pos < text.size())
+		{
+			uint32_t cp = 0;
+			if (text[pos] == '\\' && pos + 1 < text.size())
+			{
+				const char escaped = text[pos + 1];
+				pos += 2;
+				if (escaped == 'n') cp = '\n';
+				else if (escaped == 't') cp = '\t';
+				else if (escaped == '\\') cp = '\\';
+				else return fail(file, line, "unbekannte Escape-Sequenz");
+			}
+			else if (!decodeUtf8(text, pos, cp))
+			{
+				return fail(file, line, "ungültiges UTF-8");
+			}
+
+			uint8_t mods = 0;
+			uint8_t key = 0;
+			if (!hidMapDE(cp, mods, key))
+			{
+				char message[64];
+				snprintf(message, sizeof(message), "Zeichen U+%04X ist im DE-Layout nicht abbildbar", (unsigned)cp);
+				return fail(file, line, message);
+			}
+			packer.add(mods, key);
+		}
+		packer.flush();
+		return true;
+	}
+
+	bool parseUid(const std::string& text, MacroBlobEntry& entry)
+	{
+		std::string digits;
+		for (char c : text)
+		{
+			if (c == ':' || c == ' ' || c == '-')
+			{
+				continue;
+			}
+			if (!isxdigit(static_cast<unsigned char>(c)))
+			{
+				return false;
+			}
+			digits += c;
+		}
+		if (digits.empty() || digits.size() % 2 != 0 || digits.size() / 2 > sizeof(entry.uid))
+		{
+			return false;
+		}
+		entry.uidLength = static_cast<uint8_t>(digits.size() / 2);
+		for (size_t i = 0; i < entry.uidLength; ++i)
+		{
+			entry.uid[i] = static_cast<uint8_t>(strtoul(digits.substr(i * 2, 2).c_str(), nullptr, 16));
+		}
+		return true;
+	}
+
+	bool parseScript(const char* file, std::vector<ScriptEntry>& entries)
+	{
+		std::ifstream in(file);
+		if (!in)
+		{
+			fprintf(stderr, "%s: kann nicht gelesen werden\n", file);
+			return false;
+		}
+
+		std::string text;
+		size_t lineNo = 0;
+		while (std::getline(in, text))
+		{
+			++lineNo;
+			if (!text.empty() && text.back() == '\r')
+			{
+				text.pop_back();
+			}
+			const size_t start = text.find_first_not_of(" \t");
+			if (start == std::string::npos || text[start] == '#')
+			{
+				continue;
+			}
+
+			const size_t split = text.find(' ', start);
+			const std::string command = text.substr(start, split == std::string::npos ? std::string::npos : split - start);
+			const std::string argument = split == std::string::npos ? std::string() : text.substr(split + 1);
+
+			if (command == "card")
+			{
+				ScriptEntry entry;
+				if (!parseUid(argument, entry.entry))
+				{
+					return fail(file, lineNo, "ungültige UID (1..7 Byte als Hex)");
+				}
+				for (const ScriptEntry& other : entries)
+				{
+					if (other.entry.uidLength == entry.entry.uidLength &&
+						memcmp(other.entry.uid, entry.entry.uid, entry.entry.uidLength) == 0)
+					{
+						return fail(file, lineNo, "UID ist doppelt");
+					}
+				}
+				entries.push_back(entry);
+				continue;
+			}
+
+			if (entries.empty())
+			{
+				return fail(file, lineNo, "Anweisung vor der ersten 'card'-Zeile");
+			}
+			std::vector<HidReport>& records = entries.back().records;
+
+			if (command == "type" || command == "line")
+			{
+				if (!typeText(file, lineNo, command == "line" ? argument + "\\n" : argument, records))
+				{
+					return false;
+				}
+			}
+			else if (command == "delay")
+			{
+				char* end = nullptr;
+				const unsigned long ms = strtoul(argument.c_str(), &end, 10);
+				if (argument.empty() || *end != '\0' || ms == 0 || ms > 0xFFFF)
+				{
+					return fail(file, lineNo, "delay erwartet 1..65535 ms");
+				}
+				HidReport marker{};
+				marker.data[1] = MACRO_BLOB_OP_DELAY;
+				marker.data[2] = static_cast<uint8_t>(ms & 0xFF);
+				marker.data[3] = static_cast<uint8_t>(ms >> 8);
+				records.push_back(marker);
+			}
+			else
+			{
+				return fail(file, lineNo, "unbekannte Anweisung");
+			}
+
+			if (records.size() > 0xFFFF)
+			{
+				return fail(file, lineNo, "zu viele Records für eine Karte");
+			}
+		}
+		return true;
+	}
+
+	bool readFile(const char* file, std::vector<uint8_t>& data)
+	{
+		std::ifstream in(file, std::ios::binary);
+		if (!in)
+		{
+			fprintf(stderr, "%s: kann nicht gelesen werden\n", file);
+			return false;
+		}
+		std::ostringstream buffer;
+		buffer << in.rdbuf();
+		const std::string content = buffer.str();
+		data.assign(content.begin(), content.end());
+		return true;
+	}
+
+	void printUid(const MacroBlobEntry& entry)
+	{
+		for (size_t i = 0; i < entry.uidLength; ++i)
+		{
+			printf("%s%02X", i ? ":" : "", entry.uid[i]);
+		}
+	}
+
+	int build(const char* scriptFile, const char* blobFile, size_t partitionSize)
+	{
+		std::vector<ScriptEntry> entries;
+		if (!parseScript(scriptFile, entries))
+		{
+			return 1;
+		}
+		if (entries.size() > 0xFFFF)
+		{
+			fprintf(stderr, "%s: zu viele Karten\n", scriptFile);
+			return 1;
+		}
+
+		std::vector<MacroBlobEntry> table;
+		std::vector<HidReport> records;
+		for (ScriptEntry& entry : entries)
+		{
+			entry.entry.firstRecord = static_cast<uint32_t>(records.size());
+			entry.entry.recordCount = static_cast<uint16_t>(entry.records.size());
+			table.push_back(entry.entry);
+			records.insert(records.end(), entry.records.begin(), entry.records.end());
+		}
+
+		MacroBlobHeader header{};
+		header.magic = MACRO_BLOB_MAGIC;
+		header.version = MACRO_BLOB_VERSION;
+		header.entryCount = static_cast<uint16_t>(table.size());
+		header.totalSize = static_cast<uint32_t>(sizeof(header) +
+			table.size() * sizeof(MacroBlobEntry) + records.size() * sizeof(HidReport));
+		if (header.totalSize > partitionSize)
+		{
+			fprintf(stderr, "%s: Blob (%lu Byte) passt nicht in die Partition (%lu Byte)\n",
+				scriptFile, (unsigned long)header.totalSize, (unsigned long)partitionSize);
+			return 1;
+		}
+
+		std::vector<uint8_t> blob(header.totalSize);
+		uint8_t* out = blob.data() + sizeof(header);
+		memcpy(out, table.data(), table.size() * sizeof(MacroBlobEntry));
+		out += table.size() * sizeof(MacroBlobEntry);
+		memcpy(out, records.data(), records.size() * sizeof(HidReport));
+		header.crc32 = MacroBlobReader::crc32(blob.data() + sizeof(header), blob.size() - sizeof(header));
+		memcpy(blob.data(), &header, sizeof(header));
+
+		// Gegenprobe mit demselben Leser, den die Firmware verwendet.
+		MacroBlobReader reader;
+		const MacroBlobReader::Status status = reader.open(blob.data(), blob.size());
+		if (status != MacroBlobReader::Status::Ok)
+		{
+			fprintf(stderr, "%s: interner Fehler, erzeugter Blob ungültig: %s\n", blobFile, MacroBlobReader::statusName(status));
+			return 1;
+		}
+
+		std::ofstream outFile(blobFile, std::ios::binary);
+		if (!outFile.write(reinterpret_cast<const char*>(blob.data()), blob.size()))
+		{
+			fprintf(stderr, "%s: kann nicht geschrieben werden\n", blobFile);
+			return 1;
+		}
+		printf("%s: %u Karten, %lu Records, %lu Byte (Format v%u)\n",
+			blobFile, (unsigned)table.size(), (unsigned long)records.size(),
+			(unsigned long)blob.size(), (unsigned)MACRO_BLOB_VERSION);
+		return 0;
+	}
+
+	int check(const char* blobFile)
+	{
+		std::vector<uint8_t> data;
+		if (!readFile(blobFile, data))
+		{
+			return 1;
+		}
+
+		// Eine geflashte Partition ist hinter dem Blob mit 0xFF aufgefüllt; das ist zulässig.
+		std::vector<uint32_t> aligned((data.size() + 3) / 4);
+		memcpy(aligned.data(), data.data(), data.size());
+
+		MacroBlobReader reader;
+		const MacroBlobReader::Status status = reader.open(aligned.data(), data.size());
+		if (status != MacroBlobReader::Status::Ok)
+		{
+			fprintf(stderr, "%s: ungültig: %s\n", blobFile, MacroBlobReader::statusName(status));
+			return 1;
+		}
+
+		printf("%s: Format v%u, %u Karten, %lu Byte, CRC %08lX\n",
+			blobFile, (unsigned)reader.header()->version, (unsigned)reader.size(),
+			(unsigned long)reader.header()->totalSize, (unsigned long)reader.header()->crc32);
+		for (const MacroBlobEntry& entry : reader)
+		{
+			unsigned reports = 0;
+			unsigned long delayMs = 0;
+			const HidReport* record = reader.records(entry);
+			for (size_t i = 0; i < entry.recordCount; ++i)
+			{
+				if (macroBlobIsDelay(record[i]))
+				{
+					delayMs += macroBlobDelayMs(record[i]);
+				}
+				else
+				{
+					++reports;
+				}
+			}
+			printf("  ");
+			printUid(entry);
+			printf(": %u Reports, %lu ms Pausen\n", reports, delayMs);
+		}
+		return 0;
+	}
+
+	int usage()
+	{
+		fprintf(stderr,
+			"Verwendung:\n"
+			"  macroblob build <skript> <blob> [partitionsgröße]\n"
+			"  macroblob check <blob>\n");
+		return 2;
+	}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+	if (argc >= 4 && strcmp(argv[1], "build") == 0)
+	{
+		const size_t partitionSize = argc >= 5 ? strtoul(argv[4], nullptr, 0) : kDefaultPartitionSize;
+		return build(argv[2], argv[3], partitionSize);
+	}
+	if (argc == 3 && strcmp(argv[1], "check") == 0)
+	{
+		return check(argv[2]);
+	}
+	return usage();
+}
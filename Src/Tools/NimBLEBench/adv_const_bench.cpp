@@ -0,0 +1,190 @@
+/*
+	adv_const_bench: Host-Mikrobenchmark für das Aktualisieren der Advertising-Daten mit wechselndem Kartenstatus.
+
+	Verglichen wird der Neuaufbau mit NimBLEAdvertisementData (Kopie der Logik: Felder einzeln an einen
+	std::vector anhängen, setAdvertisementData ruft getPayload() zweimal auf und kopiert die Daten in das
+	Mitglied von NimBLEAdvertising) mit NimBLEConstAdvData, dessen Nutzdaten zur Übersetzungszeit entstehen
+	und bei dem nur das Statusbyte überschrieben und die Nutzdaten in den vorhandenen Puffer kopiert werden.
+	Beide Verfahren müssen byte-genau dieselben Nutzdaten liefern; der Aufruf von ble_gap_adv_set_data
+	(ein HCI-Kommando) ist in beiden Fällen gleich und wird nicht gemessen.
+
+	Bauen und starten (Linux):
+		g++ -std=c++17 -O2 -Wall -I$NIMBLE_SRC -o adv_const_bench adv_const_bench.cpp
+		./adv_const_bench
+
+	mit NIMBLE_SRC=../../../Anarcho/SimpleTestEspAsKeyboard/Libraries/NimBLE-Arduino/2.3.6/NimBLE-Arduino/src
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "NimBLEConstAdvData.h"
+
+namespace
+{
+	constexpr size_t kUpdates = 2000000;
+
+	// AD-Typen und Flags wie in ble_hs_adv.h.
+	constexpr uint8_t kTypeFlags = 0x01;
+	constexpr uint8_t kTypeCompUuids16 = 0x03;
+	constexpr uint8_t kTypeCompName = 0x09;
+	constexpr uint8_t kTypeAppearance = 0x19;
+	constexpr uint8_t kTypeMfgData = 0xFF;
+	constexpr uint8_t kFlagDiscGen = 0x02;
+	constexpr uint8_t kFlagBredrUnsup = 0x04;
+
+	constexpr uint16_t kCompanyId = 0xFFFF;
+	constexpr uint16_t kAppearanceKeyboard = 961;
+
+	// Übersetzungszeit: Aufbau, Größe und Lage des Statusbytes.
+	constexpr auto kAdv = NimBLEConstAdvData<>()
+							  .flags(kFlagDiscGen)
+							  .completeServices16(0x1812)
+							  .appearance(kAppearanceKeyboard)
+							  .name("Reader")
+							  .manufacturerData(kCompanyId, { 0x00 });
+	constexpr auto kCardState = kAdv.slot(kTypeMfgData, 2);
+	static_assert(kAdv.size() == 3 + 4 + 4 + 8 + 5, "Größe");
+	static_assert(kCardState.offset == kAdv.size() - 1 && kCardState.length == 1, "Statusbyte");
+	static_assert(kAdv.data()[0] == 2 && kAdv.data()[1] == kTypeFlags && kAdv.data()[2] == (kFlagDiscGen | kFlagBredrUnsup), "Flags");
+	static_assert(NimBLEConstAdvData<>().completeService128(NimBLEConstUUID("1812")).data()[14] == 0x12, "Basis-UUID");
+
+	// Bisheriges Verhalten: Kopie der Logik von NimBLEAdvertisementData.
+	class OldAdvData
+	{
+	public:
+		bool addData(const uint8_t* data, size_t length)
+		{
+			if (m_payload.size() + length > 31)
+			{
+				return false;
+			}
+			m_payload.insert(m_payload.end(), data, data + length);
+			return true;
+		}
+
+		bool setFlags(uint8_t flag)
+		{
+			const uint8_t data[3] = { 2, kTypeFlags, static_cast<uint8_t>(flag | kFlagBredrUnsup) };
+			return addData(data, 3);
+		}
+
+		bool addServiceUUID16(uint16_t uuid)
+		{
+			const uint8_t data[4] = { 3, kTypeCompUuids16, static_cast<uint8_t>(uuid), static_cast<uint8_t>(uuid >> 8) };
+			return addData(data, 4);
+		}
+
+		bool setAppearance(uint16_t appearance)
+		{
+			const uint8_t data[4] = { 3, kTypeAppearance, static_cast<uint8_t>(appearance), static_cast<uint8_t>(appearance >> 8) };
+			return addData(data, 4);
+		}
+
+		bool setName(const std::string& name)
+		{
+			uint8_t data[31];
+			data[0] = static_cast<uint8_t>(name.length() + 1);
+			data[1] = kTypeCompName;
+			memcpy(&data[2], name.c_str(), name.length());
+			return addData(data, name.length() + 2);
+		}
+
+		bool setManufacturerData(const std::vector<uint8_t>& mfg)
+		{
+			uint8_t data[31];
+			data[0] = static_cast<uint8_t>(mfg.size() + 1);
+			data[1] = kTypeMfgData;
+			memcpy(&data[2], mfg.data(), mfg.size());
+			return addData(data, mfg.size() + 2);
+		}
+
+		void clearData()
+		{
+			std::vector<uint8_t>().swap(m_payload);
+		}
+
+		std::vector<uint8_t> getPayload() const
+		{
+			return m_payload;
+		}
+
+	private:
+		std::vector<uint8_t> m_payload;
+	};
+
+	// Stellvertreter für ble_gap_adv_set_data.
+	uint32_t gSink = 0;
+	void setData(const uint8_t* data, size_t length)
+	{
+		gSink += data[length - 1] + static_cast<uint32_t>(length);
+	}
+
+	// Wie NimBLEAdvertising::setAdvertisementData(const NimBLEAdvertisementData&).
+	void updateOld(OldAdvData& advData, OldAdvData& member, uint8_t state)
+	{
+		advData.clearData();
+		advData.setFlags(kFlagDiscGen);
+		advData.addServiceUUID16(0x1812);
+		advData.setAppearance(kAppearanceKeyboard);
+		advData.setName("Reader");
+		advData.setManufacturerData({ static_cast<uint8_t>(kCompanyId), static_cast<uint8_t>(kCompanyId >> 8), state });
+		setData(&advData.getPayload()[0], advData.getPayload().size());
+		member = advData;
+	}
+
+	// Wie NimBLEAdvertising::setAdvertisementData(const uint8_t*, size_t).
+	void updateConst(NimBLEConstAdvData<kAdv.size()>& adv, std::vector<uint8_t>& member, uint8_t state)
+	{
+		adv.patch(kCardState, state);
+		setData(adv.data(), adv.size());
+		member.assign(adv.data(), adv.data() + adv.size());
+	}
+}  // namespace
+
+int main()
+{
+	OldAdvData advData;
+	OldAdvData oldMember;
+	auto adv = kAdv;
+	std::vector<uint8_t> constMember;
+
+	// Beide Verfahren müssen für jeden Status dieselben Nutzdaten liefern.
+	for (unsigned state = 0; state < 256; ++state)
+	{
+		updateOld(advData, oldMember, static_cast<uint8_t>(state));
+		updateConst(adv, constMember, static_cast<uint8_t>(state));
+		if (oldMember.getPayload() != constMember)
+		{
+			fprintf(stderr, "Fehler: Nutzdaten unterschiedlich für Status %u\n", state);
+			return 1;
+		}
+	}
+
+	auto t0 = std::chrono::steady_clock::now();
+	for (size_t n = 0; n < kUpdates; ++n)
+	{
+		updateOld(advData, oldMember, static_cast<uint8_t>(n));
+	}
+	auto t1 = std::chrono::steady_clock::now();
+	const double oldNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / kUpdates;
+
+	t0 = std::chrono::steady_clock::now();
+	for (size_t n = 0; n < kUpdates; ++n)
+	{
+		updateConst(adv, constMember, static_cast<uint8_t>(n));
+	}
+	t1 = std::chrono::steady_clock::now();
+	const double constNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / kUpdates;
+
+	printf("Aktualisierung des Kartenstatus, %zu Byte Nutzdaten, %zu Aktualisierungen:\n", kAdv.size(), kUpdates);
+	printf("  NimBLEAdvertisementData: %8.1f ns/Aktualisierung\n", oldNs);
+	printf("  NimBLEConstAdvData:      %8.1f ns/Aktualisierung  (Faktor %.1f)\n", constNs, oldNs / constNs);
+	printf("(Prüfsumme %u)\n", gSink);
+	return 0;
+}
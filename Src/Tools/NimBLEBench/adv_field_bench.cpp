@@ -0,0 +1,306 @@
+/*
+	adv_field_bench: Host-Mikrobenchmark für die Filterkosten pro Advertising-Report.
+
+	Typischer Filter in onResult(): "wirbt das Gerät mit Service X?", "hat es Herstellerdaten?" und der Name.
+	Verglichen wird das bisherige Verfahren von NimBLEAdvertisedDevice (jeder Zugriff läuft mit findAdvField
+	erneut über die Nutzdaten, isAdvertisingService ruft getServiceUUID(i) für jeden Index auf) mit dem
+	einmaligen Aufbau von NimBLEAdvFieldIndex und einem einzigen Durchlauf über die Tabelle.
+
+	Bauen und starten (Linux):
+		g++ -std=c++17 -O2 -Wall -I$NIMBLE_SRC -o adv_field_bench adv_field_bench.cpp $NIMBLE_SRC/NimBLEAdvFieldIndex.cpp
+		./adv_field_bench
+
+	mit NIMBLE_SRC=../../../Anarcho/SimpleTestEspAsKeyboard/Libraries/NimBLE-Arduino/2.3.6/NimBLE-Arduino/src
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "NimBLEAdvFieldIndex.h"
+
+namespace
+{
+	constexpr size_t kPayloads = 256;
+	constexpr size_t kReports = 500000;
+
+	// AD-Typen wie in ble_hs_adv.h.
+	constexpr uint8_t kTypeFlags = 0x01;
+	constexpr uint8_t kTypeIncompUuids16 = 0x02;
+	constexpr uint8_t kTypeCompUuids16 = 0x03;
+	constexpr uint8_t kTypeIncompUuids32 = 0x04;
+	constexpr uint8_t kTypeCompUuids128 = 0x07;
+	constexpr uint8_t kTypeIncompName = 0x08;
+	constexpr uint8_t kTypeCompName = 0x09;
+	constexpr uint8_t kTypeTxPower = 0x0A;
+	constexpr uint8_t kTypeMfgData = 0xFF;
+
+	// Gesuchter Service: HID 0x1812.
+	constexpr uint8_t kWanted[2] = { 0x12, 0x18 };
+
+	struct Result
+	{
+		bool service;
+		bool mfg;
+		size_t nameLength;
+
+		bool operator==(const Result& other) const
+		{
+			return service == other.service && mfg == other.mfg && nameLength == other.nameLength;
+		}
+	};
+
+	uint8_t uuidBytes(uint8_t type)
+	{
+		if (type < kTypeIncompUuids16 || type > kTypeCompUuids128)
+		{
+			return 0;
+		}
+		return type < kTypeIncompUuids32 ? 2 : (type < 0x06 ? 4 : 16);
+	}
+
+	// Bisheriges Verhalten: Kopie der Logik von findAdvField/getServiceUUID vor dem Feldindex.
+	struct Walk
+	{
+		const std::vector<uint8_t>& payload;
+
+		uint8_t findAdvField(uint8_t type, uint8_t index = 0, size_t* dataLoc = nullptr) const
+		{
+			size_t length = payload.size();
+			size_t data = 0;
+			uint8_t count = 0;
+			while (length > 2)
+			{
+				const uint8_t fieldLength = payload[data];
+				const uint8_t fieldType = payload[data + 1];
+				if (fieldLength >= length)
+				{
+					return count;
+				}
+				if (fieldType == type || (type == kTypeCompName && fieldType == kTypeIncompName))
+				{
+					const uint8_t bytes = uuidBytes(type);
+					if (bytes)
+					{
+						count += fieldLength / bytes;
+					}
+					else
+					{
+						if (type == kTypeCompName && dataLoc && fieldType == kTypeIncompName)
+						{
+							*dataLoc = data;
+							index++;
+						}
+						count++;
+					}
+					if (dataLoc && count > index)
+					{
+						break;
+					}
+				}
+				length -= 1 + fieldLength;
+				data += 1 + fieldLength;
+			}
+			if (dataLoc && count > index)
+			{
+				*dataLoc = data;
+			}
+			return count;
+		}
+
+		uint8_t serviceUuidCount() const
+		{
+			uint8_t count = 0;
+			for (uint8_t type = kTypeIncompUuids16; type <= kTypeCompUuids128; ++type)
+			{
+				count += findAdvField(type);
+			}
+			return count;
+		}
+
+		// Liefert einen Zeiger auf die UUID mit dem Index, nullptr wenn nicht vorhanden.
+		const uint8_t* serviceUuid(uint8_t index, uint8_t& bytes) const
+		{
+			size_t dataLoc = 0;
+			uint8_t count = 0;
+			uint8_t type = kTypeIncompUuids16;
+			bytes = 0;
+			do
+			{
+				count = findAdvField(type, index, &dataLoc);
+				if (count > index)
+				{
+					bytes = uuidBytes(type);
+					break;
+				}
+				index -= count;
+			} while (++type <= kTypeCompUuids128);
+
+			if (bytes == 0)
+			{
+				return nullptr;
+			}
+			index++;
+			const uint8_t fieldLength = payload[dataLoc];
+			if (fieldLength < index * bytes)
+			{
+				index -= count - fieldLength / bytes;
+			}
+			return fieldLength > bytes * index ? &payload[dataLoc + 2 + bytes * (index - 1)] : nullptr;
+		}
+
+		Result filter() const
+		{
+			Result result{};
+			const uint8_t count = serviceUuidCount();
+			for (uint8_t i = 0; i < count && !result.service; ++i)
+			{
+				uint8_t bytes = 0;
+				const uint8_t* uuid = serviceUuid(i, bytes);
+				result.service = uuid && bytes == 2 && memcmp(uuid, kWanted, 2) == 0;
+			}
+			result.mfg = findAdvField(kTypeMfgData) > 0;
+			size_t dataLoc = 0;
+			if (findAdvField(kTypeCompName, 0, &dataLoc) > 0 && payload[dataLoc] > 1)
+			{
+				result.nameLength = std::string(reinterpret_cast<const char*>(&payload[dataLoc + 2]), payload[dataLoc] - 1).size();
+			}
+			return result;
+		}
+	};
+
+	// Neues Verhalten: Feldindex einmal pro Report aufbauen, dann nur noch die Tabelle lesen.
+	Result filterIndexed(const std::vector<uint8_t>& payload, NimBLEAdvFieldIndex& index)
+	{
+		index.build(payload.data(), payload.size());
+
+		Result result{};
+		for (const auto& field : index)
+		{
+			const uint8_t bytes = uuidBytes(field.type);
+			if (bytes != 2)
+			{
+				continue;
+			}
+			for (uint8_t i = 0; i < (field.length - 1) / bytes && !result.service; ++i)
+			{
+				result.service = memcmp(&payload[field.offset + 2 + i * bytes], kWanted, 2) == 0;
+			}
+		}
+		result.mfg = index.count(kTypeMfgData) > 0;
+		const NimBLEAdvFieldIndex::Field* name = index.find(kTypeCompName);
+		if (!name)
+		{
+			name = index.find(kTypeIncompName);
+		}
+		if (name && name->length > 1)
+		{
+			result.nameLength = std::string(reinterpret_cast<const char*>(&payload[name->offset + 2]), name->length - 1).size();
+		}
+		return result;
+	}
+
+	void addField(std::vector<uint8_t>& payload, uint8_t type, const std::vector<uint8_t>& value)
+	{
+		payload.push_back(static_cast<uint8_t>(value.size() + 1));
+		payload.push_back(type);
+		payload.insert(payload.end(), value.begin(), value.end());
+	}
+
+	// Advertisement + Scan Response wie im Foyer: Flags, mehrere 16-Bit-UUIDs, teils 128-Bit-UUID,
+	// TX-Leistung, Herstellerdaten und Name im Scan Response.
+	std::vector<uint8_t> makePayload(std::mt19937& rng)
+	{
+		std::vector<uint8_t> payload;
+		addField(payload, kTypeFlags, { 0x06 });
+		std::vector<uint8_t> uuids;
+		const size_t count = 1 + rng() % 5;
+		for (size_t i = 0; i < count; ++i)
+		{
+			const bool hid = rng() % 8 == 0;
+			uuids.push_back(hid ? kWanted[0] : static_cast<uint8_t>(rng()));
+			uuids.push_back(hid ? kWanted[1] : 0x18);
+		}
+		addField(payload, rng() % 2 ? kTypeCompUuids16 : kTypeIncompUuids16, uuids);
+		if (rng() % 2)
+		{
+			addField(payload, kTypeTxPower, { 0x04 });
+		}
+		if (payload.size() <= 10 && rng() % 2)
+		{
+			std::vector<uint8_t> uuid128(16);
+			for (uint8_t& b : uuid128)
+			{
+				b = static_cast<uint8_t>(rng());
+			}
+			addField(payload, kTypeCompUuids128, uuid128);
+		}
+		// Scan Response.
+		if (rng() % 3)
+		{
+			addField(payload, kTypeMfgData, { 0x4C, 0x00, 0x10, 0x05, 0x01, 0x18, 0x2A, 0x33, 0x7E });
+		}
+		addField(payload, rng() % 4 ? kTypeCompName : kTypeIncompName, { 'K', 'e', 'y', 'b', 'o', 'a', 'r', 'd' });
+		return payload;
+	}
+}  // namespace
+
+int main()
+{
+	std::mt19937 rng(42);
+	std::vector<std::vector<uint8_t>> payloads;
+	for (size_t i = 0; i < kPayloads; ++i)
+	{
+		payloads.push_back(makePayload(rng));
+	}
+
+	std::vector<uint16_t> reports(kReports);
+	std::uniform_int_distribution<uint16_t> pick(0, kPayloads - 1);
+	for (uint16_t& report : reports)
+	{
+		report = pick(rng);
+	}
+
+	// Ergebnisse beider Verfahren müssen übereinstimmen.
+	NimBLEAdvFieldIndex index;
+	index.reserve(16);
+	for (const auto& payload : payloads)
+	{
+		if (!(Walk{ payload }.filter() == filterIndexed(payload, index)))
+		{
+			fprintf(stderr, "Fehler: Ergebnisse unterschiedlich\n");
+			return 1;
+		}
+	}
+
+	size_t hitsWalk = 0;
+	auto t0 = std::chrono::steady_clock::now();
+	for (uint16_t report : reports)
+	{
+		hitsWalk += Walk{ payloads[report] }.filter().service;
+	}
+	auto t1 = std::chrono::steady_clock::now();
+	size_t hitsIndexed = 0;
+	for (uint16_t report : reports)
+	{
+		hitsIndexed += filterIndexed(payloads[report], index).service;
+	}
+	auto t2 = std::chrono::steady_clock::now();
+
+	const double walk = std::chrono::duration<double, std::nano>(t1 - t0).count() / kReports;
+	const double indexed = std::chrono::duration<double, std::nano>(t2 - t1).count() / kReports;
+	printf("%zu Reports, %zu Treffer für Service 0x1812:\n", kReports, hitsWalk);
+	printf("  Byte-Durchlauf je Zugriff: %8.1f ns/Report\n", walk);
+	printf("  Feldindex (inkl. Aufbau):  %8.1f ns/Report  (Faktor %.1f)\n", indexed, walk / indexed);
+	if (hitsWalk != hitsIndexed)
+	{
+		fprintf(stderr, "Fehler: Treffer unterschiedlich (%zu != %zu)\n", hitsWalk, hitsIndexed);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,201 @@
+/*
+	conn_index_bench: Host-Mikrobenchmark für die Prüfung "bereits verbunden?" je Advertising-Report.
+
+	NimBLEScan::handleGapEvent prüft bei aktivierter Central-Rolle für jeden Report, ob ein Client mit der
+	Adresse des Absenders verbunden ist. Verglichen wird das bisherige Verfahren (Kopie der Logik von
+	NimBLEDevice::getClientByPeerAddress: Lauf über alle NIMBLE_MAX_CONNECTIONS Einträge, getPeerAddress()
+	liefert eine Kopie, operator== und isConnected() liegen in anderen Übersetzungseinheiten) mit
+	NimBLEConnIndex, das nur verbundene Clients enthält und die meisten Adressen über eine Maske abweist.
+	Beide Verfahren müssen für jeden Report dasselbe Ergebnis liefern.
+
+	Bauen und starten (Linux):
+		g++ -std=c++17 -O2 -Wall -I$NIMBLE_SRC -o conn_index_bench conn_index_bench.cpp
+		./conn_index_bench
+
+	mit NIMBLE_SRC=../../../Anarcho/SimpleTestEspAsKeyboard/Libraries/NimBLE-Arduino/2.3.6/NimBLE-Arduino/src
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <array>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "NimBLEConnIndex.h"
+
+namespace
+{
+	// Höchstwert von CONFIG_BT_NIMBLE_MAX_CONNECTIONS auf dem ESP32.
+	constexpr size_t kMaxConnections = 9;
+	// Entspricht knapp 3 Stunden Scannen in dichter Umgebung mit 1000 Reports/s.
+	constexpr size_t kReports = 10000000;
+	constexpr uint16_t kConnHandleNone = 0xFFFF;
+
+	// Stellvertreter für NimBLEAddress.
+	struct Address
+	{
+		uint8_t type;
+		uint8_t val[6];
+	};
+
+	__attribute__((noinline)) bool equal(const Address& a, const Address& b)
+	{
+		return a.type == b.type && memcmp(a.val, b.val, sizeof(a.val)) == 0;
+	}
+
+	// Stellvertreter für NimBLEClient.
+	struct Client
+	{
+		Address peer{};
+		uint16_t connHandle = kConnHandleNone;
+
+		__attribute__((noinline)) Address getPeerAddress() const
+		{
+			return peer;
+		}
+
+		__attribute__((noinline)) bool isConnected() const
+		{
+			return connHandle != kConnHandleNone;
+		}
+	};
+
+	Address randomAddress(std::mt19937& rng)
+	{
+		Address addr{};
+		addr.type = static_cast<uint8_t>(rng() % 2);
+		for (uint8_t& b : addr.val)
+		{
+			b = static_cast<uint8_t>(rng());
+		}
+		return addr;
+	}
+
+	struct Scenario
+	{
+		const char* name;
+		size_t clients;
+		size_t connected;
+	};
+}  // namespace
+
+int main()
+{
+	const Scenario scenarios[] = {
+		{ "9 Clients, alle verbunden", 9, 9 },
+		{ "9 Clients, 3 verbunden", 9, 3 },
+		{ "3 Clients, 1 verbunden", 3, 1 },
+		{ "kein Client", 0, 0 },
+	};
+
+	std::mt19937 rng(3);
+	printf("%-28s %14s %14s %8s\n", "Szenario", "linear ns/Rep", "Index ns/Rep", "Faktor");
+	for (const auto& scenario : scenarios)
+	{
+		std::vector<Client> clients(scenario.clients);
+		std::array<Client*, kMaxConnections> list{};
+		NimBLEConnIndex<Client, kMaxConnections> index;
+		for (size_t i = 0; i < scenario.clients; ++i)
+		{
+			clients[i].peer = randomAddress(rng);
+			list[i] = &clients[i];
+			if (i < scenario.connected)
+			{
+				clients[i].connHandle = static_cast<uint16_t>(i + 1);
+				index.add(&clients[i], clients[i].connHandle, clients[i].peer.type, clients[i].peer.val);
+			}
+		}
+
+		// 4096 Absender, etwa 1 % der Reports kommen von verbundenen oder bekannten Geräten.
+		std::vector<Address> senders(4096);
+		for (size_t i = 0; i < senders.size(); ++i)
+		{
+			senders[i] = (scenario.clients && rng() % 100 == 0) ? clients[rng() % scenario.clients].peer : randomAddress(rng);
+		}
+
+		size_t hitsLinear = 0;
+		auto t0 = std::chrono::steady_clock::now();
+		for (size_t n = 0; n < kReports; ++n)
+		{
+			const Address& addr = senders[n % senders.size()];
+			// Wie getClientByPeerAddress und die Prüfung in handleGapEvent.
+			Client* found = nullptr;
+			for (const auto clt : list)
+			{
+				if (clt != nullptr && equal(clt->getPeerAddress(), addr))
+				{
+					found = clt;
+					break;
+				}
+			}
+			if (found != nullptr && found->isConnected())
+			{
+				hitsLinear++;
+			}
+		}
+		auto t1 = std::chrono::steady_clock::now();
+		const double linearNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / kReports;
+
+		size_t hitsIndex = 0;
+		t0 = std::chrono::steady_clock::now();
+		for (size_t n = 0; n < kReports; ++n)
+		{
+			const Address& addr = senders[n % senders.size()];
+			if (index.findByAddress(addr.type, addr.val) != nullptr)
+			{
+				hitsIndex++;
+			}
+		}
+		t1 = std::chrono::steady_clock::now();
+		const double indexNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / kReports;
+
+		if (hitsLinear != hitsIndex)
+		{
+			fprintf(stderr, "Fehler: Treffer unterschiedlich für '%s' (%zu != %zu)\n", scenario.name, hitsLinear,
+				hitsIndex);
+			return 1;
+		}
+		printf("%-28s %14.2f %14.2f %8.1f\n", scenario.name, linearNs, indexNs, linearNs / indexNs);
+	}
+
+	// Verbinden und Trennen in zufälliger Reihenfolge: Suche nach Handle und Adresse bleibt konsistent.
+	std::vector<Client> clients(kMaxConnections);
+	NimBLEConnIndex<Client, kMaxConnections> index;
+	for (size_t i = 0; i < clients.size(); ++i)
+	{
+		clients[i].peer = randomAddress(rng);
+	}
+	for (size_t n = 0; n < 100000; ++n)
+	{
+		Client& clt = clients[rng() % clients.size()];
+		if (clt.isConnected())
+		{
+			index.remove(&clt);
+			clt.connHandle = kConnHandleNone;
+		}
+		else
+		{
+			clt.connHandle = static_cast<uint16_t>(rng() % 0x0EFF);
+			while (index.findByHandle(clt.connHandle) != nullptr)
+			{
+				clt.connHandle++;
+			}
+			index.add(&clt, clt.connHandle, clt.peer.type, clt.peer.val);
+		}
+		for (auto& c : clients)
+		{
+			Client* const expected = c.isConnected() ? &c : nullptr;
+			if (index.findByAddress(c.peer.type, c.peer.val) != expected ||
+				(c.isConnected() && index.findByHandle(c.connHandle) != &c))
+			{
+				fprintf(stderr, "Fehler: Index inkonsistent nach %zu Änderungen\n", n);
+				return 1;
+			}
+		}
+	}
+	printf("100000 Verbindungswechsel: Index konsistent\n");
+	return 0;
+}
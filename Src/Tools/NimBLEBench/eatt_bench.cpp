@@ -0,0 +1,209 @@
+/*
+	eatt_bench: Host-Simulation des GATT-Durchsatzes mit Enhanced ATT (EATT) gegenüber dem einfachen ATT-Bearer.
+
+	Ein Client liest viele Werte gleichzeitig (wie readValueAsync/readValues). Die Anfragen werden wie in
+	NimBLEGattFuture gestartet: je Verbindung so viele in Flug wie Bearer vorhanden sind. Den Bearer wählt
+	wie im Host (ble_eatt_get_available_chan_cid) der erste freie EATT-Bearer, sonst der ATT-Bearer.
+	Das Modell der Verbindung: je Verbindungsereignis gehen höchstens kPacketsPerEvent PDUs in jede Richtung,
+	der Server beantwortet eine Anfrage im folgenden Ereignis. Ein Bearer trägt nur eine Anfrage zur Zeit,
+	mit einem Bearer ergibt das eine Antwort je zwei Ereignisse. EATT-PDUs tragen zusätzlich die SDU-Länge
+	(2 Byte) im L2CAP-Rahmen.
+	Die Zahlen sind Ergebnisse dieses Modells, keine Messungen. Funkstörungen, Wiederholungen und die
+	Bearbeitungszeit im Server fehlen. Gemessen wird mit dem Beispiel NimBLE_EATT_Benchmark auf dem Gerät.
+	Geprüft wird: kein Bearer hat mehr als eine Anfrage in Flug, jede Anfrage wird genau einmal beantwortet
+	und die Statistik zählt jede Anfrage.
+
+	Bauen und starten (Linux):
+		g++ -std=c++17 -O2 -Wall -I$NIMBLE_SRC -o eatt_bench eatt_bench.cpp
+		./eatt_bench
+
+	mit NIMBLE_SRC=../../../Anarcho/SimpleTestEspAsKeyboard/Libraries/NimBLE-Arduino/2.3.6/NimBLE-Arduino/src
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "NimBLEAttBearers.h"
+
+namespace
+{
+	constexpr size_t kMaxBearers = 6;
+	constexpr size_t kReads = 2000;
+	constexpr uint32_t kIntervalMs = 30;
+	constexpr size_t kPacketsPerEvent = 4;
+	constexpr size_t kValueSize = 20;
+	constexpr uint16_t kFirstEattCid = 0x0040;
+
+	using Bearers = NimBLEAttBearers<kMaxBearers>;
+
+	struct Request
+	{
+		size_t bearer;
+		uint32_t startMs;
+		uint32_t id;
+	};
+
+	struct Result
+	{
+		uint32_t elapsedMs;
+		size_t linkBytes;
+		NimBLEGattRequestStats stats;
+	};
+
+	// L2CAP-Rahmen einer ATT-PDU: Kopf (4 Byte), bei EATT zusätzlich die SDU-Länge (2 Byte).
+	size_t frameSize(size_t bearer, size_t attPdu)
+	{
+		return 4 + (bearer == 0 ? 0 : 2) + attPdu;
+	}
+
+	// Liefert false bei einem Fehler.
+	bool run(size_t eattBearers, size_t concurrency, Result& res)
+	{
+		Bearers bearers;
+		for (size_t i = 0; i < eattBearers; ++i)
+		{
+			bearers.add(static_cast<uint16_t>(kFirstEattCid + i));
+		}
+
+		std::deque<uint32_t> waiting;
+		std::deque<Request> toSend;
+		std::vector<Request> toAnswer;
+		std::vector<uint8_t> answered(kReads, 0);
+		std::vector<uint8_t> busy(bearers.size(), 0);
+		uint32_t submitted = 0;
+		size_t inFlight = 0;
+		size_t done = 0;
+		uint32_t now = 0;
+		res.linkBytes = 0;
+
+		// Wie ble_eatt_get_available_chan_cid ohne gesetzten Standard-Bearer.
+		const auto hostPick = [&]()
+		{
+			for (size_t i = 1; i < bearers.size(); ++i)
+			{
+				if (busy[i] == 0)
+				{
+					return i;
+				}
+			}
+			return static_cast<size_t>(0);
+		};
+
+		// Wie NimBLEGattFuture::submit/complete: höchstens so viele in Flug wie Bearer vorhanden sind.
+		const auto startWaiting = [&]()
+		{
+			while (!waiting.empty() && inFlight < bearers.size())
+			{
+				const size_t bearer = hostPick();
+				busy[bearer]++;
+				bearers.start();
+				toSend.push_back({ bearer, now, waiting.front() });
+				waiting.pop_front();
+				inFlight++;
+			}
+		};
+
+		while (done < kReads)
+		{
+			// Die Anwendung hält bis zu concurrency Lesevorgänge offen.
+			while (submitted < kReads && waiting.size() + inFlight < concurrency)
+			{
+				waiting.push_back(submitted++);
+			}
+			startWaiting();
+
+			for (size_t i = 0; i < bearers.size(); ++i)
+			{
+				if (busy[i] > 1)
+				{
+					fprintf(stderr, "Fehler: Bearer 0x%04x mit %u Anfragen\n", bearers[i], busy[i]);
+					return false;
+				}
+			}
+
+			// Server -> Client: Antworten auf die Anfragen des vorigen Ereignisses.
+			size_t packets = 0;
+			std::vector<Request> late;
+			for (const Request& req : toAnswer)
+			{
+				if (packets == kPacketsPerEvent)
+				{
+					late.push_back(req);
+					continue;
+				}
+				packets++;
+				res.linkBytes += frameSize(req.bearer, 1 + kValueSize);
+				if (answered[req.id]++ != 0)
+				{
+					fprintf(stderr, "Fehler: Anfrage %u doppelt beantwortet\n", req.id);
+					return false;
+				}
+				busy[req.bearer]--;
+				bearers.finish(false, kValueSize, now - req.startMs);
+				inFlight--;
+				done++;
+			}
+			toAnswer = late;
+
+			// Client -> Server: Anfragen, die vor dem Ereignis gestellt wurden. Frei gewordene Bearer werden erst
+			// nach dem Ereignis wieder belegt.
+			packets = 0;
+			while (!toSend.empty() && packets < kPacketsPerEvent)
+			{
+				res.linkBytes += frameSize(toSend.front().bearer, 3);
+				toAnswer.push_back(toSend.front());
+				toSend.pop_front();
+				packets++;
+			}
+
+			now += kIntervalMs;
+			if (now > 3600u * 1000u)
+			{
+				fprintf(stderr, "Fehler: keine Fortschritte\n");
+				return false;
+			}
+		}
+
+		res.elapsedMs = now;
+		res.stats = bearers.stats();
+		if (res.stats.inFlight != 0)
+		{
+			fprintf(stderr, "Fehler: %u Anfragen nicht abgeschlossen\n", res.stats.inFlight);
+			return false;
+		}
+		if (res.stats.requests != kReads)
+		{
+			fprintf(stderr, "Fehler: %u Anfragen gezählt, %zu gestellt\n", res.stats.requests, kReads);
+			return false;
+		}
+		return true;
+	}
+}  // namespace
+
+int main()
+{
+	printf("Modellrechnung, keine Messung: %zu Lesevorgänge je %zu Byte, Verbindungsintervall %u ms, %zu PDUs je Ereignis\n",
+		kReads, kValueSize, kIntervalMs, kPacketsPerEvent);
+	printf("%-10s %-12s %8s %10s %12s %10s\n", "Bearer", "gleichzeitig", "ms", "Werte/s", "Link-Byte/Wert",
+		"max. offen");
+
+	for (size_t eatt : { 0, 1, 2, 3, 5 })
+	{
+		for (size_t concurrency : { 1, 8 })
+		{
+			Result res{};
+			if (!run(eatt, concurrency, res))
+			{
+				return 1;
+			}
+			printf("%-10s %-12zu %8u %10.1f %12.1f %10u\n",
+				eatt == 0 ? "ATT" : ("ATT+" + std::to_string(eatt) + " EATT").c_str(), concurrency, res.elapsedMs,
+				kReads * 1000.0 / res.elapsedMs, static_cast<double>(res.linkBytes) / kReads, res.stats.maxInFlight);
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,177 @@
+/*
+	log_record_bench: Host-Mikrobenchmark für das verzögerte Logging mit NimBLELogRecord.
+
+	Der Aufrufer von NIMBLE_LOGI zahlt bisher für das Formatieren der Zeile und, bei Adressen, für
+	NimBLEAddress::toString() (std::string mit 17 Zeichen, liegt nicht im SSO-Puffer und belegt Heap).
+	Mit CONFIG_NIMBLE_CPP_LOG_DEFERRED kopiert der Aufrufer nur Formatzeiger und Argumente in den Ring seines
+	Kerns, formatiert wird später im Log-Task. Gemessen wird die Zeile "Duplicate; updated: %s" aus
+	NimBLEScan::handleGapEvent, die bei einem Scan für jeden Report geschrieben wird.
+	Geprüft wird außerdem, dass format() für die Formate der Bibliothek denselben Text wie snprintf liefert.
+
+	Bauen und starten (Linux):
+		g++ -std=c++17 -O2 -Wall -I$NIMBLE_SRC -o log_record_bench log_record_bench.cpp $NIMBLE_SRC/NimBLELogRecord.cpp
+		./log_record_bench
+
+	mit NIMBLE_SRC=../../../Anarcho/SimpleTestEspAsKeyboard/Libraries/NimBLE-Arduino/2.3.6/NimBLE-Arduino/src
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "NimBLELogRecord.h"
+
+namespace
+{
+	constexpr size_t kReports = 2000000;
+	constexpr size_t kRingSize = 2048;
+
+	// Stellvertreter für NimBLEAddress.
+	struct Address
+	{
+		uint8_t type;
+		uint8_t val[6];
+
+		uint8_t getType() const
+		{
+			return type;
+		}
+
+		const uint8_t* getVal() const
+		{
+			return val;
+		}
+
+		// Wie NimBLEAddress::toString().
+		std::string toString() const
+		{
+			char buffer[18];
+			snprintf(buffer, sizeof(buffer), "%02x%s%02x%s%02x%s%02x%s%02x%s%02x", val[5], ":", val[4], ":", val[3], ":",
+				val[2], ":", val[1], ":", val[0]);
+			return std::string(buffer);
+		}
+	};
+
+	// Stellvertreter für den Ring eines Kerns.
+	struct Ring
+	{
+		uint8_t buf[kRingSize];
+		uint32_t head = 0;
+		uint32_t tail = 0;
+
+		void push(const uint8_t* rec)
+		{
+			const uint32_t len = rec[0];
+			if (kRingSize - (head - tail) < len)
+			{
+				tail = head;  // Der Log-Task hat geleert.
+			}
+			const uint32_t offset = head % kRingSize;
+			const uint32_t first = len < kRingSize - offset ? len : kRingSize - offset;
+			memcpy(buf + offset, rec, first);
+			memcpy(buf, rec + first, len - first);
+			head += len;
+		}
+	};
+
+	int gFailures = 0;
+
+	template <typename... Args>
+	void check(const char* format, const Args&... args)
+	{
+		uint8_t rec[NimBLELogRecord::MAX_SIZE];
+		char text[192];
+		char expected[192];
+		NimBLELogRecord::encode(rec, 'I', "Tag", format, args...);
+		NimBLELogRecord::format(rec, text, sizeof(text));
+		snprintf(expected, sizeof(expected), format, args...);
+		if (strcmp(text, expected) != 0)
+		{
+			fprintf(stderr, "Fehler: '%s' statt '%s'\n", text, expected);
+			gFailures++;
+		}
+	}
+}  // namespace
+
+int main()
+{
+	// Formate und Argumenttypen, wie sie in der Bibliothek vorkommen.
+	check("Scan stopped, ignoring event");
+	check("disconnect; reason=%d, %s", 531, "Remote User Terminated Connection");
+	check("ble_gap_adv_set_data: %d %s", -1, "BLE_HS_EINVAL");
+	check("Unable to create client; already at max: %d", 3);
+	check("handle=%u, len=%u", static_cast<uint16_t>(42), 517u);
+	check("conn_handle=0x%04x mtu=%d", static_cast<uint16_t>(1), 247);
+	check("flags %x %X %o %lu", -1, 0xABCDu, 8u, 4000000000ul);
+	check("size %zu ptr %p", static_cast<size_t>(12), static_cast<void*>(&gFailures));
+	check("%-8s|%8s|%.3s", "ab", "cd", "truncated");
+	check("%lld %llu %c %%", -5000000000ll, 18000000000000000000ull, 'x');
+	check("rssi %d dBm, %.2f s", static_cast<int8_t>(-67), 1.25);
+
+	// Adressen werden wie mit toString() formatiert.
+	const Address addr{ 0, { 0x06, 0x05, 0x04, 0x03, 0x02, 0xa1 } };
+	{
+		uint8_t rec[NimBLELogRecord::MAX_SIZE];
+		char text[64];
+		NimBLELogRecord::encode(rec, 'I', "NimBLEScan", "Duplicate; updated: %s", addr);
+		NimBLELogRecord::format(rec, text, sizeof(text));
+		if (std::string(text) != "Duplicate; updated: " + addr.toString())
+		{
+			fprintf(stderr, "Fehler: Adresse '%s'\n", text);
+			gFailures++;
+		}
+	}
+	if (gFailures != 0)
+	{
+		return 1;
+	}
+	printf("format(): 12 Formate identisch mit snprintf\n");
+
+	// Zufällige Absender wie bei einem Scan in dichter Umgebung.
+	std::mt19937 rng(7);
+	std::vector<Address> senders(256);
+	for (auto& sender : senders)
+	{
+		sender.type = static_cast<uint8_t>(rng() % 2);
+		for (uint8_t& b : sender.val)
+		{
+			b = static_cast<uint8_t>(rng());
+		}
+	}
+
+	// Bisher: toString() und Formatieren der Zeile im Host-Task (ohne die Ausgabe selbst).
+	size_t sink = 0;
+	char line[128];
+	auto t0 = std::chrono::steady_clock::now();
+	for (size_t n = 0; n < kReports; ++n)
+	{
+		const Address& sender = senders[n % senders.size()];
+		sink += static_cast<size_t>(snprintf(line, sizeof(line), "I %s: Duplicate; updated: %s\n", "NimBLEScan",
+			sender.toString().c_str()));
+	}
+	auto t1 = std::chrono::steady_clock::now();
+	const double syncNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / kReports;
+
+	// Verzögert: Datensatz kodieren und in den Ring kopieren.
+	Ring ring;
+	t0 = std::chrono::steady_clock::now();
+	for (size_t n = 0; n < kReports; ++n)
+	{
+		uint8_t rec[NimBLELogRecord::MAX_SIZE];
+		sink += NimBLELogRecord::encode(rec, 'I', "NimBLEScan", "Duplicate; updated: %s", senders[n % senders.size()]);
+		ring.push(rec);
+	}
+	t1 = std::chrono::steady_clock::now();
+	const double deferredNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / kReports;
+
+	printf("\"Duplicate; updated: %%s\" je Report, %zu Reports:\n", kReports);
+	printf("  toString() + snprintf: %8.1f ns/Report\n", syncNs);
+	printf("  NimBLELogRecord:       %8.1f ns/Report  (Faktor %.1f)\n", deferredNs, syncNs / deferredNs);
+	printf("(Prüfsumme %zu, Ring %u)\n", sink, ring.head);
+	return 0;
+}
@@ -0,0 +1,223 @@
+/*
+	notify_multi_bench: Host-Prüfung der PDU-Anzahl von NimBLENotifyTransaction.
+
+	Ein Stellvertreter für den Host baut aus dem Plan von NimBLENotifyPlan die ATT-PDUs (Handle Value
+	Notification 0x1B, Multiple Handle Value Notification 0x23) byte-genau auf, ein Stellvertreter für den
+	Client zerlegt sie wieder. Geprüft wird: jede PDU passt in die MTU, jeder Wert kommt genau einmal und in
+	der Reihenfolge des Hinzufügens an, und ble_gatts_notify_multiple_custom würde eine Gruppe nicht weiter
+	aufteilen. Gezählt werden die PDUs gegenüber einem notify() je Charakteristik.
+
+	Bauen und starten (Linux):
+		g++ -std=c++17 -O2 -Wall -I$NIMBLE_SRC -o notify_multi_bench notify_multi_bench.cpp $NIMBLE_SRC/NimBLENotifyPlan.cpp
+		./notify_multi_bench
+
+	mit NIMBLE_SRC=../../../Anarcho/SimpleTestEspAsKeyboard/Libraries/NimBLE-Arduino/2.3.6/NimBLE-Arduino/src
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "NimBLENotifyPlan.h"
+
+namespace
+{
+	constexpr uint8_t kOpNotify = 0x1B;
+	constexpr uint8_t kOpNotifyMultiple = 0x23;
+	constexpr size_t kRandomSets = 20000;
+
+	struct Notification
+	{
+		uint16_t handle;
+		std::vector<uint8_t> value;
+	};
+
+	struct Scenario
+	{
+		const char* name;
+		uint16_t mtu;
+		bool multiple;
+		std::vector<uint16_t> lengths;
+	};
+
+	void put16(std::vector<uint8_t>& pdu, uint16_t v)
+	{
+		pdu.push_back(static_cast<uint8_t>(v));
+		pdu.push_back(static_cast<uint8_t>(v >> 8));
+	}
+
+	uint16_t get16(const std::vector<uint8_t>& pdu, size_t pos)
+	{
+		return static_cast<uint16_t>(pdu[pos] | (pdu[pos + 1] << 8));
+	}
+
+	// Stellvertreter für den Host: eine Gruppe wird zu einer PDU, wie in ble_att_clt_tx_notify(_mult).
+	// Liefert false, wenn ble_gatts_notify_multiple_custom die Gruppe aufteilen würde.
+	bool encode(const std::vector<Notification>& notes, const NimBLENotifyPlan::Pdu& group, uint16_t mtu,
+		std::vector<uint8_t>& pdu)
+	{
+		pdu.clear();
+		if (group.count == 1)
+		{
+			const Notification& note = notes[group.first];
+			pdu.push_back(kOpNotify);
+			put16(pdu, note.handle);
+			// Der Host kürzt einen einzelnen Wert auf MTU - 3.
+			const size_t length = std::min<size_t>(note.value.size(), mtu - 3U);
+			pdu.insert(pdu.end(), note.value.begin(), note.value.begin() + length);
+			return true;
+		}
+
+		pdu.push_back(kOpNotifyMultiple);
+		size_t packed = 0;
+		for (uint16_t i = group.first; i < group.first + group.count; ++i)
+		{
+			const Notification& note = notes[i];
+			// Prüfung aus ble_gatts_notify_multiple_custom: bisherige Länge + Wert gegen MTU - 1.
+			if (packed + note.value.size() > mtu - 1U)
+			{
+				return false;
+			}
+			put16(pdu, note.handle);
+			put16(pdu, static_cast<uint16_t>(note.value.size()));
+			pdu.insert(pdu.end(), note.value.begin(), note.value.end());
+			packed += 4 + note.value.size();
+		}
+		return true;
+	}
+
+	// Stellvertreter für den Client: zerlegt eine PDU in Handle/Wert-Paare.
+	bool decode(const std::vector<uint8_t>& pdu, std::vector<Notification>& received)
+	{
+		if (pdu.size() < 3)
+		{
+			return false;
+		}
+		if (pdu[0] == kOpNotify)
+		{
+			received.push_back({ get16(pdu, 1), std::vector<uint8_t>(pdu.begin() + 3, pdu.end()) });
+			return true;
+		}
+		size_t pos = 1;
+		while (pos < pdu.size())
+		{
+			if (pos + 4 > pdu.size())
+			{
+				return false;
+			}
+			const uint16_t handle = get16(pdu, pos);
+			const uint16_t length = get16(pdu, pos + 2);
+			pos += 4;
+			if (pos + length > pdu.size())
+			{
+				return false;
+			}
+			received.push_back({ handle, std::vector<uint8_t>(pdu.begin() + pos, pdu.begin() + pos + length) });
+			pos += length;
+		}
+		return pdu[0] == kOpNotifyMultiple;
+	}
+
+	// Gibt die Anzahl der PDUs zurück, 0 bei einem Fehler.
+	size_t check(const std::vector<uint16_t>& lengths, uint16_t mtu, bool multiple, NimBLENotifyPlan& plan,
+		std::mt19937& rng)
+	{
+		std::vector<Notification> notes;
+		for (size_t i = 0; i < lengths.size(); ++i)
+		{
+			Notification note{ static_cast<uint16_t>(0x20 + 3 * i), std::vector<uint8_t>(lengths[i]) };
+			for (uint8_t& b : note.value)
+			{
+				b = static_cast<uint8_t>(rng());
+			}
+			notes.push_back(note);
+		}
+
+		plan.build(lengths.data(), lengths.size(), mtu, multiple);
+
+		std::vector<uint8_t> pdu;
+		std::vector<Notification> received;
+		size_t next = 0;
+		for (const auto& group : plan.getPdus())
+		{
+			if (group.count == 0 || group.first != next || (!multiple && group.count > 1))
+			{
+				return 0;
+			}
+			next += group.count;
+			if (!encode(notes, group, mtu, pdu) || pdu.size() > mtu || !decode(pdu, received))
+			{
+				return 0;
+			}
+		}
+		if (next != notes.size() || received.size() != notes.size())
+		{
+			return 0;
+		}
+		for (size_t i = 0; i < notes.size(); ++i)
+		{
+			const size_t length = std::min<size_t>(notes[i].value.size(), mtu - 3U);
+			if (received[i].handle != notes[i].handle || received[i].value.size() < length ||
+				!std::equal(received[i].value.begin(), received[i].value.begin() + length, notes[i].value.begin()))
+			{
+				return 0;
+			}
+		}
+		return plan.getPdus().size();
+	}
+}  // namespace
+
+int main()
+{
+	// Requisite: Karten-ID (4 oder 7 Byte UID), Zeitstempel (4 Byte) und Zustand (1 Byte).
+	const std::vector<Scenario> scenarios = {
+		{ "Requisite, UID 4, MTU 23", 23, true, { 4, 4, 1 } },
+		{ "Requisite, UID 7, MTU 23", 23, true, { 7, 4, 1 } },
+		{ "Requisite, UID 7, MTU 247", 247, true, { 7, 4, 1 } },
+		{ "Requisite, Client ohne 0x23", 247, false, { 7, 4, 1 } },
+		{ "8 Sensorwerte, MTU 65", 65, true, std::vector<uint16_t>(8, 6) },
+		{ "Gemischt mit langem Wert, MTU 185", 185, true, { 2, 200, 2, 2, 150, 20, 20 } },
+	};
+
+	std::mt19937 rng(11);
+	NimBLENotifyPlan plan;
+	printf("%-36s %8s %8s\n", "Szenario", "einzeln", "Tx-PDUs");
+	for (const auto& scenario : scenarios)
+	{
+		const size_t pdus = check(scenario.lengths, scenario.mtu, scenario.multiple, plan, rng);
+		if (pdus == 0)
+		{
+			fprintf(stderr, "Fehler: ungültige PDUs für '%s'\n", scenario.name);
+			return 1;
+		}
+		printf("%-36s %8zu %8zu\n", scenario.name, scenario.lengths.size(), pdus);
+	}
+
+	const uint16_t mtus[] = { 23, 65, 185, 247, 517 };
+	size_t single = 0;
+	size_t sent = 0;
+	for (size_t n = 0; n < kRandomSets; ++n)
+	{
+		const uint16_t mtu = mtus[rng() % 5];
+		const bool multiple = rng() % 4 != 0;
+		std::vector<uint16_t> lengths(1 + rng() % 12);
+		for (uint16_t& length : lengths)
+		{
+			length = rng() % 16 == 0 ? static_cast<uint16_t>(rng() % 513) : static_cast<uint16_t>(rng() % 21);
+		}
+		const size_t pdus = check(lengths, mtu, multiple, plan, rng);
+		if (pdus == 0)
+		{
+			fprintf(stderr, "Fehler: ungültige PDUs für Satz %zu\n", n);
+			return 1;
+		}
+		single += lengths.size();
+		sent += pdus;
+	}
+	printf("%zu Zufallssätze: %zu PDUs einzeln, %zu mit Transaktion (%.3f)\n", kRandomSets, single, sent,
+		static_cast<double>(sent) / single);
+	return 0;
+}
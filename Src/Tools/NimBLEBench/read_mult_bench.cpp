@@ -0,0 +1,152 @@
+/*
+	read_mult_bench: Host-Prüfung der Anfrageplanung von NimBLEClient::readValues.
+
+	Prüft für feste Szenarien und zufällige Charakteristik-Sätze, dass NimBLEReadMultiplePlan
+	gültige Read-Multiple-Variable-Length-Anfragen bildet (jeder Wert genau einmal, Antwort passt in
+	MTU - 1, höchstens BLE_GATT_READ_MAX_ATTRS Handles) und zählt die Round-Trips gegenüber einem
+	readValue() je Charakteristik und der unteren Schranke.
+
+	Bauen und starten (Linux):
+		g++ -std=c++17 -O2 -Wall -I$NIMBLE_SRC -o read_mult_bench read_mult_bench.cpp $NIMBLE_SRC/NimBLEReadMultiplePlan.cpp
+		./read_mult_bench
+
+	mit NIMBLE_SRC=../../../Anarcho/SimpleTestEspAsKeyboard/Libraries/NimBLE-Arduino/2.3.6/NimBLE-Arduino/src
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "NimBLEReadMultiplePlan.h"
+
+namespace
+{
+	// Standardwert von MYNEWT_VAL(BLE_GATT_READ_MAX_ATTRS) in syscfg.h.
+	constexpr uint8_t kMaxHandles = 8;
+	constexpr size_t kRandomSets = 20000;
+	constexpr uint16_t kUnknown = NimBLEReadMultiplePlan::UNKNOWN_LENGTH;
+
+	struct Scenario
+	{
+		const char* name;
+		uint16_t mtu;
+		std::vector<uint16_t> lengths;
+	};
+
+	// Untere Schranke: Antwortbytes und Handle-Anzahl der teilbaren Werte, jeder andere Wert einzeln.
+	size_t lowerBound(const std::vector<uint16_t>& lengths, uint16_t mtu)
+	{
+		const size_t budget = mtu - 1;
+		const size_t handles = std::min<size_t>(kMaxHandles, budget / 2);
+		size_t bytes = 0;
+		size_t shared = 0;
+		size_t alone = 0;
+		for (uint16_t length : lengths)
+		{
+			if (length == kUnknown || length + 2U > budget)
+			{
+				alone++;
+				continue;
+			}
+			bytes += length + 2U;
+			shared++;
+		}
+		const size_t byBytes = (bytes + budget - 1) / budget;
+		const size_t byHandles = (shared + handles - 1) / handles;
+		return alone + std::max(byBytes, byHandles);
+	}
+
+	// Gibt die Anzahl der Anfragen zurück, 0 bei einem ungültigen Plan.
+	size_t check(const std::vector<uint16_t>& lengths, uint16_t mtu, NimBLEReadMultiplePlan& plan)
+	{
+		plan.build(lengths.data(), lengths.size(), mtu, kMaxHandles);
+
+		std::vector<int> seen(lengths.size(), 0);
+		for (const auto& batch : plan.getBatches())
+		{
+			if (batch.count == 0)
+			{
+				return 0;
+			}
+			size_t bytes = 0;
+			for (uint8_t i = 0; i < batch.count; ++i)
+			{
+				const uint16_t index = plan.getOrder()[batch.first + i];
+				seen[index]++;
+				if (batch.count > 1 && lengths[index] == kUnknown)
+				{
+					return 0;
+				}
+				bytes += lengths[index] + 2U;
+			}
+			if (batch.count > 1 && (batch.count > kMaxHandles || bytes > mtu - 1U || batch.count * 2U > mtu - 1U))
+			{
+				return 0;
+			}
+		}
+		for (int count : seen)
+		{
+			if (count != 1)
+			{
+				return 0;
+			}
+		}
+		return plan.getBatches().size();
+	}
+}  // namespace
+
+int main()
+{
+	const std::vector<Scenario> scenarios = {
+		{ "Begleit-App: 10 Einstellungen, MTU 23", 23, { 1, 1, 2, 4, 1, 2, 8, 1, 4, 2 } },
+		{ "Begleit-App: 10 Einstellungen, MTU 247", 247, { 1, 1, 2, 4, 1, 2, 8, 1, 4, 2 } },
+		{ "Geräteinfo (DIS), MTU 185", 185, { 12, 8, 16, 6, 10, 20, 7 } },
+		{ "Gemischt mit unbekannt und lang, MTU 247", 247, { kUnknown, 300, 20, 20, 20, 100, 100, 4, kUnknown, 1 } },
+		{ "24 Sensorwerte, MTU 100", 100, std::vector<uint16_t>(24, 6) },
+	};
+
+	NimBLEReadMultiplePlan plan;
+	printf("%-42s %6s %8s %8s\n", "Szenario", "einzeln", "gebündelt", "Schranke");
+	for (const auto& scenario : scenarios)
+	{
+		const size_t requests = check(scenario.lengths, scenario.mtu, plan);
+		if (requests == 0)
+		{
+			fprintf(stderr, "Fehler: ungültiger Plan für '%s'\n", scenario.name);
+			return 1;
+		}
+		printf("%-42s %6zu %8zu %8zu\n", scenario.name, scenario.lengths.size(), requests,
+			lowerBound(scenario.lengths, scenario.mtu));
+	}
+
+	std::mt19937 rng(7);
+	const uint16_t mtus[] = { 23, 65, 185, 247, 517 };
+	size_t single = 0;
+	size_t batched = 0;
+	size_t bound = 0;
+	for (size_t n = 0; n < kRandomSets; ++n)
+	{
+		const uint16_t mtu = mtus[rng() % 5];
+		std::vector<uint16_t> lengths(1 + rng() % 32);
+		for (uint16_t& length : lengths)
+		{
+			const uint32_t kind = rng() % 20;
+			length = kind == 0 ? kUnknown : (kind == 1 ? static_cast<uint16_t>(1 + rng() % 512) : static_cast<uint16_t>(1 + rng() % 24));
+		}
+		const size_t requests = check(lengths, mtu, plan);
+		if (requests == 0)
+		{
+			fprintf(stderr, "Fehler: ungültiger Plan für Satz %zu\n", n);
+			return 1;
+		}
+		single += lengths.size();
+		batched += requests;
+		bound += lowerBound(lengths, mtu);
+	}
+	printf("%zu Zufallssätze: %zu Round-Trips einzeln, %zu gebündelt, untere Schranke %zu (%.3f)\n",
+		kRandomSets, single, batched, bound, static_cast<double>(batched) / bound);
+	return 0;
+}
@@ -0,0 +1,221 @@
+/*
+	scan_index_bench: Host-Mikrobenchmark für die Duplikatsuche in NimBLEScan::handleGapEvent.
+
+	Spielt einen synthetischen Advertising-Sturm von 1000 Geräten ab und vergleicht die bisherige
+	lineare Suche im Ergebnisvektor (plus Vektor-erase) mit NimBLEScanIndex.
+
+	Bauen und starten (Linux):
+		g++ -std=c++17 -O2 -Wall -I$NIMBLE_SRC -o scan_index_bench scan_index_bench.cpp $NIMBLE_SRC/NimBLEScanIndex.cpp
+		./scan_index_bench
+
+	mit NIMBLE_SRC=../../../Anarcho/SimpleTestEspAsKeyboard/Libraries/NimBLE-Arduino/2.3.6/NimBLE-Arduino/src
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "NimBLEScanIndex.h"
+
+namespace
+{
+	constexpr size_t kDevices = 1000;
+	constexpr size_t kReports = 200000;
+
+	struct Device
+	{
+		uint8_t addr[6];
+		uint8_t type;
+		uint8_t sid;
+	};
+
+	struct Report
+	{
+		uint16_t device;
+	};
+
+	bool sameKey(const Device& a, const Device& b)
+	{
+		return a.type == b.type && a.sid == b.sid && memcmp(a.addr, b.addr, 6) == 0;
+	}
+
+	// Bisheriges Verhalten: lineare Suche, push_back, erase mit Verschieben.
+	struct LinearResults
+	{
+		std::vector<const Device*> devices;
+
+		const Device* find(const Device& key) const
+		{
+			for (const Device* dev : devices)
+			{
+				if (sameKey(*dev, key))
+				{
+					return dev;
+				}
+			}
+			return nullptr;
+		}
+
+		void add(const Device* dev) { devices.push_back(dev); }
+
+		void erase(const Device* dev)
+		{
+			for (auto it = devices.begin(); it != devices.end(); ++it)
+			{
+				if (*it == dev)
+				{
+					devices.erase(it);
+					break;
+				}
+			}
+		}
+	};
+
+	// Neues Verhalten: NimBLEScanIndex neben dem Vektor, erase durch Tausch mit dem letzten Element.
+	struct IndexedResults
+	{
+		std::vector<const Device*> devices;
+		NimBLEScanIndex index;
+
+		const Device* find(const Device& key) const
+		{
+			uint16_t pos = index.find(key.addr, key.type, key.sid);
+			return pos == NimBLEScanIndex::NOT_FOUND ? nullptr : devices[pos];
+		}
+
+		void add(const Device* dev)
+		{
+			devices.push_back(dev);
+			index.insert(dev->addr, dev->type, dev->sid, static_cast<uint16_t>(devices.size() - 1));
+		}
+
+		void erase(const Device* dev)
+		{
+			uint16_t pos = index.find(dev->addr, dev->type, dev->sid);
+			if (pos == NimBLEScanIndex::NOT_FOUND)
+			{
+				return;
+			}
+			const Device* last = devices.back();
+			index.erase(dev->addr, dev->type, dev->sid);
+			if (last != dev)
+			{
+				devices[pos] = last;
+				index.update(last->addr, last->type, last->sid, pos);
+			}
+			devices.pop_back();
+		}
+	};
+
+	// Gespeicherte Ergebnisse (setMaxResults(0xFF)): jedes Gerät bleibt im Vektor.
+	template <class Results>
+	double runStored(const std::vector<Device>& devices, const std::vector<Report>& reports, size_t& found)
+	{
+		Results results;
+		found = 0;
+		auto t0 = std::chrono::steady_clock::now();
+		for (const Report& report : reports)
+		{
+			const Device& dev = devices[report.device];
+			if (results.find(dev))
+			{
+				++found;
+			}
+			else
+			{
+				results.add(&dev);
+			}
+		}
+		auto t1 = std::chrono::steady_clock::now();
+		return std::chrono::duration<double, std::nano>(t1 - t0).count() / reports.size();
+	}
+
+	// Nur Callbacks (setMaxResults(0)): Gerät wird nach Advertisement + Scan Response gelöscht,
+	// d.h. jedes zweite Auftreten eines Geräts löscht es wieder. Im Mittel liegen ~kDevices/2 Geräte vor.
+	template <class Results>
+	double runCallbackOnly(const std::vector<Device>& devices, const std::vector<Report>& reports, size_t& found)
+	{
+		Results results;
+		found = 0;
+		auto t0 = std::chrono::steady_clock::now();
+		for (const Report& report : reports)
+		{
+			const Device& dev = devices[report.device];
+			if (results.find(dev))
+			{
+				++found;
+				results.erase(&dev);
+			}
+			else
+			{
+				results.add(&dev);
+			}
+		}
+		auto t1 = std::chrono::steady_clock::now();
+		return std::chrono::duration<double, std::nano>(t1 - t0).count() / reports.size();
+	}
+}  // namespace
+
+int main()
+{
+	std::mt19937 rng(42);
+	std::vector<Device> devices(kDevices);
+	for (size_t i = 0; i < kDevices; ++i)
+	{
+		Device& dev = devices[i];
+		for (uint8_t& b : dev.addr)
+		{
+			b = static_cast<uint8_t>(rng());
+		}
+		// Zufällige private Adressen, ein Teil öffentlich mit gleichem OUI wie im Foyer üblich.
+		if (i % 4 == 0)
+		{
+			dev.addr[5] = 0x24;
+			dev.addr[4] = 0x0A;
+			dev.addr[3] = 0xC4;
+			dev.type = 0;
+		}
+		else
+		{
+			dev.type = 1;
+		}
+		dev.sid = 0;
+	}
+
+	std::vector<Report> reports(kReports);
+	std::uniform_int_distribution<uint16_t> pick(0, kDevices - 1);
+	for (Report& report : reports)
+	{
+		report.device = pick(rng);
+	}
+
+	size_t foundLinear = 0;
+	size_t foundIndexed = 0;
+	double linear = runStored<LinearResults>(devices, reports, foundLinear);
+	double indexed = runStored<IndexedResults>(devices, reports, foundIndexed);
+	printf("Gespeicherte Ergebnisse, %zu Geräte, %zu Reports:\n", kDevices, kReports);
+	printf("  linear:  %8.1f ns/Report\n", linear);
+	printf("  Index:   %8.1f ns/Report  (Faktor %.1f)\n", indexed, linear / indexed);
+	if (foundLinear != foundIndexed)
+	{
+		fprintf(stderr, "Fehler: Treffer unterschiedlich (%zu != %zu)\n", foundLinear, foundIndexed);
+		return 1;
+	}
+
+	linear = runCallbackOnly<LinearResults>(devices, reports, foundLinear);
+	indexed = runCallbackOnly<IndexedResults>(devices, reports, foundIndexed);
+	printf("Nur Callbacks (Einfügen + Löschen), %zu Geräte, %zu Reports:\n", kDevices, kReports);
+	printf("  linear:  %8.1f ns/Report\n", linear);
+	printf("  Index:   %8.1f ns/Report  (Faktor %.1f)\n", indexed, linear / indexed);
+	if (foundLinear != foundIndexed)
+	{
+		fprintf(stderr, "Fehler: Treffer unterschiedlich (%zu != %zu)\n", foundLinear, foundIndexed);
+		return 1;
+	}
+	return 0;
+}
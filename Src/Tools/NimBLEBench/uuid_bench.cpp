@@ -0,0 +1,281 @@
+/*
+	uuid_bench: Host-Mikrobenchmark für UUID-Vergleiche in Suchschleifen.
+
+	Verglichen wird der Vergleich von NimBLEUUID (Kopie der Logik von operator==: Größenprüfung, bei
+	unterschiedlicher Größe Aufbau der 128-Bit-Form mit der Basis-UUID und memcmp) mit NimBLEConstUUID,
+	das UUIDs kanonisch speichert und 16-Bit-UUIDs mit einem Ganzzahlvergleich vergleicht.
+	Szenarien: Suche einer Charakteristik in der Tabelle eines Dienstes (wie getCharacteristic(uuid))
+	und Suche eines Dienstes in der UUID-Liste eines Advertisements (wie isAdvertisingService).
+	Die UUID-Literale werden zur Übersetzungszeit geprüft (static_assert).
+
+	Bauen und starten (Linux):
+		g++ -std=c++17 -O2 -Wall -I$NIMBLE_SRC -o uuid_bench uuid_bench.cpp
+		./uuid_bench
+
+	mit NIMBLE_SRC=../../../Anarcho/SimpleTestEspAsKeyboard/Libraries/NimBLE-Arduino/2.3.6/NimBLE-Arduino/src
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "NimBLEConstUUID.h"
+
+namespace
+{
+	constexpr size_t kLookups = 2000000;
+
+	// Übersetzungszeit: Literale in 16-, 32- und 128-Bit-Form ergeben dieselbe kanonische UUID.
+	constexpr NimBLEConstUUID kHidService("1812");
+	static_assert(kHidService == NimBLEConstUUID("0x00001812"), "32-Bit-Form");
+	static_assert(kHidService == NimBLEConstUUID("00001812-0000-1000-8000-00805f9b34fb"), "Basis-UUID");
+	static_assert(NimBLEConstUUID("dcbc7255-1e9e-49a0-a360-b0430b6c6905").bitSize() == 128, "128 Bit");
+
+	const uint8_t kBaseUuid[16] = { 0xfb, 0x34, 0x9b, 0x5f, 0x80, 0x00, 0x00, 0x80, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+	// Stellvertreter für ble_uuid_any_t.
+	struct AnyUuid
+	{
+		uint8_t type;
+		union
+		{
+			uint16_t u16;
+			uint32_t u32;
+			uint8_t u128[16];
+		};
+	};
+
+	// Bisheriges Verhalten: Kopie der Logik von NimBLEUUID.
+	struct OldUuid
+	{
+		AnyUuid uuid{};
+
+		OldUuid() = default;
+
+		// Wie ble_uuid_init_from_buf.
+		OldUuid(const uint8_t* data, size_t size)
+		{
+			if (size == 2)
+			{
+				uuid.type = 16;
+				uuid.u16 = static_cast<uint16_t>(data[0] | data[1] << 8);
+			}
+			else if (size == 4)
+			{
+				uuid.type = 32;
+				memcpy(&uuid.u32, data, 4);
+			}
+			else if (size == 16)
+			{
+				uuid.type = 128;
+				memcpy(uuid.u128, data, 16);
+			}
+		}
+
+		const uint8_t* getValue() const
+		{
+			switch (uuid.type)
+			{
+			case 16:
+				return reinterpret_cast<const uint8_t*>(&uuid.u16);
+			case 32:
+				return reinterpret_cast<const uint8_t*>(&uuid.u32);
+			case 128:
+				return uuid.u128;
+			default:
+				return nullptr;
+			}
+		}
+
+		bool operator==(const OldUuid& rhs) const
+		{
+			if (!uuid.type || !rhs.uuid.type)
+			{
+				return false;
+			}
+			if (uuid.type != rhs.uuid.type)
+			{
+				uint8_t uuid128[16];
+				memcpy(uuid128, kBaseUuid, 16);
+				if (uuid.type == 128)
+				{
+					memcpy(uuid128 + 12, rhs.getValue(), rhs.uuid.type == 16 ? 2 : 4);
+					return memcmp(getValue(), uuid128, 16) == 0;
+				}
+				if (rhs.uuid.type == 128)
+				{
+					memcpy(uuid128 + 12, getValue(), uuid.type == 16 ? 2 : 4);
+					return memcmp(rhs.getValue(), uuid128, 16) == 0;
+				}
+				return false;
+			}
+			if (uuid.type == 16)
+			{
+				return *reinterpret_cast<const uint16_t*>(getValue()) == *reinterpret_cast<const uint16_t*>(rhs.getValue());
+			}
+			if (uuid.type == 32)
+			{
+				return *reinterpret_cast<const uint32_t*>(getValue()) == *reinterpret_cast<const uint32_t*>(rhs.getValue());
+			}
+			return memcmp(getValue(), rhs.getValue(), 16) == 0;
+		}
+	};
+
+	// Eine UUID in der Form, wie sie über die Luft kommt (2 oder 16 Byte, Little Endian).
+	struct WireUuid
+	{
+		uint8_t bytes[16];
+		uint8_t size;
+	};
+
+	WireUuid makeWire(std::mt19937& rng)
+	{
+		WireUuid wire{};
+		const uint32_t kind = rng() % 4;
+		if (kind < 2)
+		{
+			// Standard-UUID, 16 Bit.
+			wire.size = 2;
+			wire.bytes[0] = static_cast<uint8_t>(rng());
+			wire.bytes[1] = 0x2A;
+		}
+		else if (kind == 2)
+		{
+			// Standard-UUID in 128-Bit-Form.
+			wire.size = 16;
+			memcpy(wire.bytes, kBaseUuid, 16);
+			wire.bytes[12] = static_cast<uint8_t>(rng());
+			wire.bytes[13] = 0x2A;
+		}
+		else
+		{
+			// Hersteller-UUID, unterscheidet sich nur in den ersten Bytes.
+			wire.size = 16;
+			const NimBLEConstUUID vendor("dcbc7255-1e9e-49a0-a360-b0430b6c6905");
+			vendor.getBytes(wire.bytes);
+			wire.bytes[12] = static_cast<uint8_t>(rng() % 8);
+		}
+		return wire;
+	}
+
+	template <typename Uuid, typename Make>
+	size_t lookup(const std::vector<WireUuid>& table, const std::vector<WireUuid>& wanted, Make make, double& ns)
+	{
+		std::vector<Uuid> entries;
+		for (const auto& wire : table)
+		{
+			entries.push_back(make(wire));
+		}
+
+		size_t found = 0;
+		const auto t0 = std::chrono::steady_clock::now();
+		for (size_t n = 0; n < kLookups; ++n)
+		{
+			// Die gesuchte UUID wird einmal je Suche umgewandelt, wie in isAdvertisingService.
+			const Uuid uuid = make(wanted[n % wanted.size()]);
+			for (size_t i = 0; i < entries.size(); ++i)
+			{
+				if (entries[i] == uuid)
+				{
+					found += i + 1;
+					break;
+				}
+			}
+		}
+		const auto t1 = std::chrono::steady_clock::now();
+		ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / kLookups;
+		return found;
+	}
+
+	template <typename Uuid, typename Make>
+	size_t advertised(const std::vector<std::vector<WireUuid>>& reports, const WireUuid& wanted, Make make, double& ns)
+	{
+		size_t hits = 0;
+		const auto t0 = std::chrono::steady_clock::now();
+		for (size_t n = 0; n < kLookups; ++n)
+		{
+			const Uuid uuid = make(wanted);
+			for (const auto& wire : reports[n % reports.size()])
+			{
+				if (make(wire) == uuid)
+				{
+					hits++;
+					break;
+				}
+			}
+		}
+		const auto t1 = std::chrono::steady_clock::now();
+		ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / kLookups;
+		return hits;
+	}
+}  // namespace
+
+int main()
+{
+	std::mt19937 rng(5);
+	const auto makeOld = [](const WireUuid& wire) { return OldUuid(wire.bytes, wire.size); };
+	const auto makeConst = [](const WireUuid& wire) { return NimBLEConstUUID::fromBytes(wire.bytes, wire.size); };
+
+	// Beide Verfahren müssen für alle Paare dasselbe Ergebnis liefern.
+	std::vector<WireUuid> samples;
+	for (size_t i = 0; i < 400; ++i)
+	{
+		samples.push_back(makeWire(rng));
+	}
+	for (const auto& a : samples)
+	{
+		for (const auto& b : samples)
+		{
+			if ((makeOld(a) == makeOld(b)) != (makeConst(a) == makeConst(b)))
+			{
+				fprintf(stderr, "Fehler: Vergleich unterschiedlich\n");
+				return 1;
+			}
+		}
+	}
+
+	// Dienst mit 24 Charakteristiken, gesucht werden vorhandene und fehlende UUIDs.
+	std::vector<WireUuid> table(samples.begin(), samples.begin() + 24);
+	std::vector<WireUuid> wanted(samples.begin(), samples.begin() + 48);
+	double oldNs = 0;
+	double constNs = 0;
+	const size_t foundOld = lookup<OldUuid>(table, wanted, makeOld, oldNs);
+	const size_t foundConst = lookup<NimBLEConstUUID>(table, wanted, makeConst, constNs);
+	printf("Charakteristik-Suche in 24 Einträgen, %zu Suchen:\n", kLookups);
+	printf("  NimBLEUUID:      %8.1f ns/Suche\n", oldNs);
+	printf("  NimBLEConstUUID: %8.1f ns/Suche  (Faktor %.1f)\n", constNs, oldNs / constNs);
+	if (foundOld != foundConst)
+	{
+		fprintf(stderr, "Fehler: Treffer unterschiedlich (%zu != %zu)\n", foundOld, foundConst);
+		return 1;
+	}
+
+	// Advertisements mit 1 bis 6 UUIDs, gesucht wird der HID-Dienst.
+	WireUuid hid{};
+	hid.size = 2;
+	kHidService.getBytes(hid.bytes);
+	std::vector<std::vector<WireUuid>> reports(256);
+	for (auto& report : reports)
+	{
+		const size_t count = 1 + rng() % 6;
+		for (size_t i = 0; i < count; ++i)
+		{
+			report.push_back(rng() % 10 == 0 ? hid : makeWire(rng));
+		}
+	}
+	const size_t hitsOld = advertised<OldUuid>(reports, hid, makeOld, oldNs);
+	const size_t hitsConst = advertised<NimBLEConstUUID>(reports, hid, makeConst, constNs);
+	printf("Dienst-Suche im Advertisement, %zu Reports, %zu Treffer:\n", kLookups, hitsOld);
+	printf("  NimBLEUUID:      %8.1f ns/Report\n", oldNs);
+	printf("  NimBLEConstUUID: %8.1f ns/Report  (Faktor %.1f)\n", constNs, oldNs / constNs);
+	if (hitsOld != hitsConst)
+	{
+		fprintf(stderr, "Fehler: Treffer unterschiedlich (%zu != %zu)\n", hitsOld, hitsConst);
+		return 1;
+	}
+	return 0;
+}
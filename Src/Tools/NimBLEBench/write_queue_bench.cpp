@@ -0,0 +1,318 @@
+/*
+	write_queue_bench: Host-Loopback für Schreiben ohne Antwort mit NimBLEWriteQueue.
+
+	Ein Stellvertreter für Host und Controller: jeder Write ohne Antwort belegt einen msys-Puffer, bis der
+	Controller das Paket in einem Verbindungsereignis gesendet hat (Number of Completed Packets). Sind alle
+	Puffer belegt, scheitert ble_gattc_write_no_rsp_flat mit BLE_HS_ENOMEM.
+	Ein Kartenleser erzeugt Zustandsänderungen in Schüben, die größer als der Pufferpool sind.
+	Verglichen wird:
+	  - direkt:        writeValue(..., false), ein gescheiterter Write geht verloren.
+	  - Warteschlange: writeValueQueued, der Host-Task reicht die Werte weiter und versucht es nach einem
+	                   Tick erneut, wenn keine Puffer frei sind (wie NimBLERemoteCharacteristic::pumpWriteQueue).
+	Vorab wird die Warteschlange mit zufälligen Längen gegen std::deque geprüft (Umlauf am Pufferende).
+	Die Gegenstelle prüft Reihenfolge und Inhalt. Gemessen werden zugestellte Werte/s, Verluste, die
+	maximale Tiefe der Warteschlange und die Verzögerung, zusätzlich der Aufwand von push/front/pop.
+
+	Bauen und starten (Linux):
+		g++ -std=c++17 -O2 -Wall -I$NIMBLE_SRC -o write_queue_bench write_queue_bench.cpp $NIMBLE_SRC/NimBLEWriteQueue.cpp
+		./write_queue_bench
+
+	mit NIMBLE_SRC=../../../Anarcho/SimpleTestEspAsKeyboard/Libraries/NimBLE-Arduino/2.3.6/NimBLE-Arduino/src
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <chrono>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include "NimBLEWriteQueue.h"
+
+namespace
+{
+	constexpr uint32_t kStepUs = 250;
+	constexpr uint32_t kDurationUs = 10000000;
+	constexpr uint32_t kConnIntervalUs = 7500;
+	constexpr uint32_t kPacketsPerEvent = 4;
+	constexpr uint32_t kMsysBlocks = 12;
+	constexpr uint32_t kMsysReserve = 4;   // WRITE_QUEUE_MSYS_RESERVE
+	constexpr uint32_t kRetryUs = 1000;    // Ein FreeRTOS-Tick
+	constexpr uint32_t kBurstPeriodUs = 100000;
+	constexpr uint32_t kBurstSize = 30;
+	constexpr size_t kValueSize = 20;
+	constexpr size_t kQueueSize = 1024;    // CONFIG_NIMBLE_CPP_WRITE_QUEUE_SIZE
+	constexpr size_t kRingOps = 20000000;
+
+	struct Packet
+	{
+		uint8_t value[kValueSize];
+	};
+
+	// Stellvertreter für Host, Controller und Gegenstelle.
+	struct Link
+	{
+		uint32_t msysFree = kMsysBlocks;
+		std::deque<Packet> inFlight;
+		uint32_t nextSeq = 0;
+		uint32_t delivered = 0;
+		uint32_t errors = 0;
+		uint64_t latencyUs = 0;
+		uint32_t maxLatencyUs = 0;
+
+		// Wie ble_gattc_write_no_rsp_flat: 0 oder BLE_HS_ENOMEM (hier -1).
+		int write(const uint8_t* data, size_t length)
+		{
+			if (msysFree == 0 || length != kValueSize)
+			{
+				return -1;
+			}
+			msysFree--;
+			Packet packet;
+			memcpy(packet.value, data, kValueSize);
+			inFlight.push_back(packet);
+			return 0;
+		}
+
+		// Verbindungsereignis: der Controller sendet, die Puffer werden frei.
+		void connectionEvent(uint32_t now)
+		{
+			for (uint32_t i = 0; i < kPacketsPerEvent && !inFlight.empty(); ++i)
+			{
+				const Packet& packet = inFlight.front();
+				uint32_t seq;
+				uint32_t created;
+				memcpy(&seq, packet.value, 4);
+				memcpy(&created, packet.value + 4, 4);
+				bool ok = seq >= nextSeq;
+				for (size_t b = 8; b < kValueSize; ++b)
+				{
+					ok = ok && packet.value[b] == static_cast<uint8_t>(seq + b);
+				}
+				if (!ok)
+				{
+					errors++;
+				}
+				nextSeq = seq + 1;
+				delivered++;
+				latencyUs += now - created;
+				if (now - created > maxLatencyUs)
+				{
+					maxLatencyUs = now - created;
+				}
+				inFlight.pop_front();
+				msysFree++;
+			}
+		}
+	};
+
+	struct Result
+	{
+		uint32_t produced = 0;
+		uint32_t lost = 0;
+		size_t maxDepth = 0;
+		Link link;
+	};
+
+	void makeValue(uint8_t* value, uint32_t seq, uint32_t now)
+	{
+		memcpy(value, &seq, 4);
+		memcpy(value + 4, &now, 4);
+		for (size_t b = 8; b < kValueSize; ++b)
+		{
+			value[b] = static_cast<uint8_t>(seq + b);
+		}
+	}
+
+	Result runDirect()
+	{
+		Result res;
+		for (uint32_t now = 0; now < kDurationUs; now += kStepUs)
+		{
+			if (now % kBurstPeriodUs == 0)
+			{
+				for (uint32_t i = 0; i < kBurstSize; ++i)
+				{
+					uint8_t value[kValueSize];
+					makeValue(value, res.produced++, now);
+					if (res.link.write(value, kValueSize) != 0)
+					{
+						res.lost++;
+					}
+				}
+			}
+			if (now % kConnIntervalUs == 0)
+			{
+				res.link.connectionEvent(now);
+			}
+		}
+		return res;
+	}
+
+	// Wie NimBLERemoteCharacteristic::pumpWriteQueue, liefert false, wenn ein erneuter Versuch nötig ist.
+	bool pump(NimBLEWriteQueue& queue, Link& link)
+	{
+		size_t length = 0;
+		while (const uint8_t* data = queue.front(&length))
+		{
+			if (link.msysFree <= kMsysReserve || link.write(data, length) != 0)
+			{
+				return false;
+			}
+			queue.pop();
+		}
+		return true;
+	}
+
+	Result runQueued()
+	{
+		Result res;
+		NimBLEWriteQueue queue(kQueueSize);
+		bool retry = false;
+		uint32_t retryAt = 0;
+		for (uint32_t now = 0; now < kDurationUs; now += kStepUs)
+		{
+			bool run = retry && now >= retryAt;
+			if (now % kBurstPeriodUs == 0)
+			{
+				for (uint32_t i = 0; i < kBurstSize; ++i)
+				{
+					uint8_t value[kValueSize];
+					makeValue(value, res.produced++, now);
+					if (!queue.push(value, kValueSize))
+					{
+						res.lost++;
+					}
+				}
+				run = true;
+			}
+			if (queue.getCount() > res.maxDepth)
+			{
+				res.maxDepth = queue.getCount();
+			}
+			if (run)
+			{
+				retry = !pump(queue, res.link);
+				retryAt = now + kRetryUs;
+			}
+			if (now % kConnIntervalUs == 0)
+			{
+				res.link.connectionEvent(now);
+			}
+		}
+		return res;
+	}
+
+	// Zufällige Längen und Füllstände, damit Werte oft am Pufferende umlaufen.
+	bool checkRing()
+	{
+		std::mt19937 rng(3);
+		NimBLEWriteQueue queue(257);
+		std::deque<std::vector<uint8_t>> expected;
+		size_t used = 0;
+		for (size_t n = 0; n < 200000; ++n)
+		{
+			if (rng() % 2 == 0)
+			{
+				std::vector<uint8_t> value(rng() % 60);
+				for (uint8_t& b : value)
+				{
+					b = static_cast<uint8_t>(rng());
+				}
+				// Passt ein Wert insgesamt, muss er zumindest in eine leere Warteschlange passen.
+				const bool pushed = queue.push(value.data(), value.size());
+				if (pushed)
+				{
+					expected.push_back(value);
+					used += value.size() + 2;
+				}
+				else if (expected.empty())
+				{
+					return false;
+				}
+			}
+			else
+			{
+				size_t length = 0;
+				const uint8_t* data = queue.front(&length);
+				if ((data == nullptr) != expected.empty())
+				{
+					return false;
+				}
+				if (data)
+				{
+					if (length != expected.front().size() || (length && memcmp(data, expected.front().data(), length) != 0))
+					{
+						return false;
+					}
+					used -= length + 2;
+					expected.pop_front();
+					queue.pop();
+				}
+			}
+			if (queue.getCount() != expected.size() || queue.getUsed() < used || queue.getUsed() > queue.getCapacity())
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void print(const char* name, const Result& res)
+	{
+		const uint32_t seconds = kDurationUs / 1000000;
+		printf("  %-14s %6u Werte/s  %5u verloren  Tiefe %3zu  Verzögerung %5.1f ms (max %5.1f ms)\n", name,
+			res.link.delivered / seconds, res.lost, res.maxDepth,
+			res.link.delivered ? res.link.latencyUs / 1000.0 / res.link.delivered : 0.0, res.link.maxLatencyUs / 1000.0);
+	}
+}  // namespace
+
+int main()
+{
+	if (!checkRing())
+	{
+		fprintf(stderr, "Fehler: Warteschlange liefert andere Werte als std::deque\n");
+		return 1;
+	}
+
+	const Result direct = runDirect();
+	const Result queued = runQueued();
+	if (direct.link.errors != 0 || queued.link.errors != 0)
+	{
+		fprintf(stderr, "Fehler: Reihenfolge oder Inhalt falsch (%u, %u)\n", direct.link.errors, queued.link.errors);
+		return 1;
+	}
+	if (queued.link.delivered + queued.lost + queued.link.inFlight.size() != queued.produced)
+	{
+		fprintf(stderr, "Fehler: Werte der Warteschlange verloren gegangen\n");
+		return 1;
+	}
+
+	printf("Schübe von %u Werten je %u ms, %u msys-Puffer, %u Pakete je %.1f ms Verbindungsereignis:\n", kBurstSize,
+		kBurstPeriodUs / 1000, kMsysBlocks, kPacketsPerEvent, kConnIntervalUs / 1000.0);
+	print("direkt", direct);
+	print("Warteschlange", queued);
+
+	// Aufwand der Warteschlange selbst: ein Wert hinein und wieder heraus.
+	NimBLEWriteQueue queue(kQueueSize);
+	uint8_t value[kValueSize] = {};
+	size_t sink = 0;
+	const auto t0 = std::chrono::steady_clock::now();
+	for (size_t n = 0; n < kRingOps; ++n)
+	{
+		value[0] = static_cast<uint8_t>(n);
+		queue.push(value, kValueSize);
+		if (queue.getCount() > 8)
+		{
+			size_t length = 0;
+			sink += queue.front(&length)[0] + length;
+			queue.pop();
+		}
+	}
+	const auto t1 = std::chrono::steady_clock::now();
+	printf("push/front/pop: %.1f ns je Wert (Prüfsumme %zu)\n",
+		std::chrono::duration<double, std::nano>(t1 - t0).count() / kRingOps, sink);
+	return 0;
+}